@@ -0,0 +1,731 @@
+#include "CommandStackCPP.h"
+
+#include <QDebug>
+#include <QJSEngine>
+#include <QMetaMethod>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+//! Initial capacity of an unlimited stack, it doubles when it is full
+constexpr int UnlimitedCapacity = 16;
+
+QString uuidOf(const QObject *object)
+{
+    return object ? object->property("_qsUuid").toString() : QString();
+}
+
+void appendObjects(QVector<QPointer<QObject>> &objects, const QVariantList &list)
+{
+    for (const QVariant &item : list) {
+        if (QObject *object = item.value<QObject *>())
+            objects.append(object);
+    }
+}
+
+QVariantList toVariantList(const QVector<QPointer<QObject>> &objects)
+{
+    QVariantList list;
+    for (const QPointer<QObject> &object : objects) {
+        if (object)
+            list.append(QVariant::fromValue(object.data()));
+    }
+
+    return list;
+}
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+CommandStackCPP::CommandStackCPP(QObject *parent)
+    : QObject(parent)
+{
+    relayout(mMaxStackSize);
+
+    mBatchTimer.setSingleShot(true);
+    mBatchTimer.setInterval(200);
+    connect(&mBatchTimer, &QTimer::timeout, this, &CommandStackCPP::finalizePending);
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+void CommandStackCPP::push(const QJSValue &command, bool appliedAlready)
+{
+    if (!command.property("undo").isCallable() || !command.property("redo").isCallable()) {
+        qWarning() << "CommandStackCPP: A command needs undo() and redo() functions";
+        return;
+    }
+
+    if (!appliedAlready) {
+        const bool wasReplaying = mIsReplaying;
+        setIsReplaying(true);
+        setObserversBlocked(true);
+        call(command, "redo");
+        setObserversBlocked(false);
+        setIsReplaying(wasReplaying);
+    }
+
+    nextCommand(CommandType::Custom, nullptr).custom = command;
+    schedule();
+}
+
+void CommandStackCPP::pushAddNode(QObject *scene, QObject *node)
+{
+    if (!scene || !node)
+        return;
+
+    nextCommand(CommandType::AddNode, scene).objects.append(node);
+    schedule();
+}
+
+void CommandStackCPP::pushAddNodes(QObject *scene, const QVariantList &nodes)
+{
+    if (!scene || nodes.isEmpty())
+        return;
+
+    appendObjects(nextCommand(CommandType::AddNodes, scene).objects, nodes);
+    schedule();
+}
+
+void CommandStackCPP::pushRemoveNode(QObject *scene, QObject *node, const QVariantList &links)
+{
+    if (!scene || !node)
+        return;
+
+    Command &command = nextCommand(CommandType::RemoveNode, scene);
+    command.objects.append(node);
+    appendObjects(command.links, links);
+    schedule();
+}
+
+void CommandStackCPP::pushRemoveNodes(QObject *scene, const QVariantList &nodes,
+                                      const QVariantList &links)
+{
+    if (!scene || nodes.isEmpty())
+        return;
+
+    Command &command = nextCommand(CommandType::RemoveNodes, scene);
+    appendObjects(command.objects, nodes);
+    appendObjects(command.links, links);
+    schedule();
+}
+
+void CommandStackCPP::pushAddContainer(QObject *scene, QObject *container)
+{
+    if (!scene || !container)
+        return;
+
+    nextCommand(CommandType::AddContainer, scene).objects.append(container);
+    schedule();
+}
+
+void CommandStackCPP::pushRemoveContainer(QObject *scene, QObject *container)
+{
+    if (!scene || !container)
+        return;
+
+    nextCommand(CommandType::RemoveContainer, scene).objects.append(container);
+    schedule();
+}
+
+void CommandStackCPP::pushCreateLink(QObject *scene, const QString &inputPortUuid,
+                                     const QString &outputPortUuid, QObject *link)
+{
+    if (!scene || inputPortUuid.isEmpty() || outputPortUuid.isEmpty())
+        return;
+
+    Command &command = nextCommand(CommandType::CreateLink, scene);
+    command.inputPortUuid  = inputPortUuid;
+    command.outputPortUuid = outputPortUuid;
+    if (link)
+        command.objects.append(link);
+    schedule();
+}
+
+void CommandStackCPP::pushUnlink(QObject *scene, const QString &inputPortUuid,
+                                 const QString &outputPortUuid, QObject *link)
+{
+    if (!scene || inputPortUuid.isEmpty() || outputPortUuid.isEmpty())
+        return;
+
+    Command &command = nextCommand(CommandType::Unlink, scene);
+    command.inputPortUuid  = inputPortUuid;
+    command.outputPortUuid = outputPortUuid;
+    if (link)
+        command.objects.append(link);
+    schedule();
+}
+
+void CommandStackCPP::pushProperty(QObject *target, const QString &key,
+                                   const QJSValue &oldValue, const QJSValue &newValue)
+{
+    if (!target || key.isEmpty())
+        return;
+
+    Command &command = nextCommand(CommandType::Property, nullptr);
+    command.objects.append(target);
+    command.key      = key;
+    command.oldValue = oldValue;
+    command.newValue = newValue;
+    schedule();
+}
+
+/*!
+ * The pending batch is finalized first, so it is the macro that is undone.
+ */
+void CommandStackCPP::undo()
+{
+    finalizePending();
+    if (mUndoCount == 0)
+        return;
+
+    mHead = slot(mHead - 1);
+    --mUndoCount;
+    ++mRedoCount;
+
+    Macro &macro = mRing[mHead];
+    replay(macro, true);
+
+    emit undoRedoDone();
+    emit stacksUpdated();
+    emitMacroApplied(macro);
+}
+
+/*!
+ * A pending batch clears the redo entries when it is finalized, so there is nothing to redo.
+ */
+void CommandStackCPP::redo()
+{
+    finalizePending();
+    if (mRedoCount == 0)
+        return;
+
+    Macro &macro = mRing[mHead];
+    mHead = slot(mHead + 1);
+    ++mUndoCount;
+    --mRedoCount;
+
+    replay(macro, false);
+
+    emit undoRedoDone();
+    emit stacksUpdated();
+    emitMacroApplied(macro);
+}
+
+void CommandStackCPP::clearRedo()
+{
+    if (mRedoCount == 0)
+        return;
+
+    for (int index = 0; index < mRedoCount; ++index)
+        discard(mRing[slot(mHead + index)]);
+    mRedoCount = 0;
+
+    emit stacksUpdated();
+}
+
+void CommandStackCPP::resetStacks()
+{
+    mBatchTimer.stop();
+    discard(mPending);
+
+    for (int index = -mUndoCount; index < mRedoCount; ++index)
+        discard(mRing[slot(mHead + index)]);
+    mUndoCount = 0;
+    mRedoCount = 0;
+    mHead      = 0;
+
+    emit stacksUpdated();
+}
+
+bool CommandStackCPP::isValidUndo() const
+{
+    return mUndoCount > 0 || mPending.size > 0;
+}
+
+bool CommandStackCPP::isValidRedo() const
+{
+    return mRedoCount > 0 && mPending.size == 0;
+}
+
+int CommandStackCPP::undoCount() const
+{
+    return mUndoCount;
+}
+
+int CommandStackCPP::redoCount() const
+{
+    return mRedoCount;
+}
+
+bool CommandStackCPP::isReplaying() const
+{
+    return mIsReplaying;
+}
+
+void CommandStackCPP::setIsReplaying(bool isReplaying)
+{
+    if (mIsReplaying == isReplaying)
+        return;
+
+    mIsReplaying = isReplaying;
+    emit isReplayingChanged();
+}
+
+int CommandStackCPP::maxStackSize() const
+{
+    return mMaxStackSize;
+}
+
+void CommandStackCPP::setMaxStackSize(int maxStackSize)
+{
+    if (mMaxStackSize == maxStackSize)
+        return;
+
+    mMaxStackSize = maxStackSize;
+    relayout(mMaxStackSize > 0 ? mMaxStackSize
+                               : std::max(UnlimitedCapacity, mUndoCount + mRedoCount));
+
+    emit maxStackSizeChanged();
+    emit stacksUpdated();
+}
+
+int CommandStackCPP::batchInterval() const
+{
+    return mBatchTimer.interval();
+}
+
+void CommandStackCPP::setBatchInterval(int batchInterval)
+{
+    if (mBatchTimer.interval() == batchInterval)
+        return;
+
+    mBatchTimer.setInterval(batchInterval);
+    emit batchIntervalChanged();
+}
+
+QObject *CommandStackCPP::undoSpec() const
+{
+    return mUndoSpec;
+}
+
+void CommandStackCPP::setUndoSpec(QObject *undoSpec)
+{
+    if (mUndoSpec == undoSpec)
+        return;
+
+    mUndoSpec = undoSpec;
+    emit undoSpecChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+/*!
+ * The oldest macro is discarded when the ring is full, an unlimited ring grows instead.
+ */
+void CommandStackCPP::finalizePending()
+{
+    mBatchTimer.stop();
+    if (mPending.size == 0)
+        return;
+
+    clearRedo();
+
+    if (mUndoCount == mRing.size()) {
+        if (mMaxStackSize > 0) {
+            discard(mRing[slot(mHead - mUndoCount)]);
+            --mUndoCount;
+        } else {
+            relayout(mRing.size() * 2);
+        }
+    }
+
+    // The slot is free, its reset records become the next pending batch
+    Macro &macro = mRing[mHead];
+    std::swap(macro, mPending);
+    mHead = slot(mHead + 1);
+    ++mUndoCount;
+
+    emit stacksUpdated();
+    emitMacroApplied(macro);
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+CommandStackCPP::Command &CommandStackCPP::nextCommand(CommandType type, QObject *scene)
+{
+    if (mPending.size == mPending.commands.size())
+        mPending.commands.append(Command());
+
+    Command &command = mPending.commands[mPending.size++];
+    command.type  = type;
+    command.scene = scene;
+
+    return command;
+}
+
+void CommandStackCPP::schedule()
+{
+    mBatchTimer.start();
+
+    if (mPending.size == 1)
+        emit stacksUpdated();
+}
+
+/*!
+ * The built-in records call the scene functions, the detaching ones (_detachNodes, ...) keep the
+ * objects alive for redo.
+ */
+void CommandStackCPP::apply(Command &command, bool isUndo)
+{
+    QJSEngine *engine = qjsEngine(this);
+    if (!engine) {
+        qWarning() << "CommandStackCPP: No QML engine to replay the commands";
+        return;
+    }
+
+    if (command.type == CommandType::Custom) {
+        call(command.custom, isUndo ? "undo" : "redo");
+        return;
+    }
+
+    QObject *object = command.objects.isEmpty() ? nullptr : command.objects.first().data();
+
+    if (command.type == CommandType::Property) {
+        if (object)
+            engine->toScriptValue(object).setProperty(command.key, isUndo ? command.oldValue
+                                                                          : command.newValue);
+        return;
+    }
+
+    if (!command.scene)
+        return;
+
+    const QJSValue scene = engine->toScriptValue(command.scene.data());
+
+    switch (command.type) {
+    case CommandType::AddNode:
+    case CommandType::AddNodes: {
+        if (isUndo)
+            call(scene, "_detachNodes", { toArray(command.objects) });
+        else if (command.type == CommandType::AddNodes)
+            call(scene, "addNodes", { toArray(command.objects), false });
+        else if (object)
+            call(scene, "addNode", { engine->toScriptValue(object) });
+    } break;
+
+    case CommandType::RemoveNode:
+    case CommandType::RemoveNodes: {
+        if (isUndo) {
+            if (command.type == CommandType::RemoveNodes)
+                call(scene, "addNodes", { toArray(command.objects), false });
+            else if (object)
+                call(scene, "addNode", { engine->toScriptValue(object) });
+
+            // Restore the link objects, they keep all their properties
+            if (!command.links.isEmpty())
+                call(scene, "restoreLinks", { toArray(command.links) });
+        } else if (command.type == CommandType::RemoveNode) {
+            if (object)
+                call(scene, "deleteNode", { uuidOf(object) });
+        } else {
+            QStringList uuids;
+            for (const QPointer<QObject> &node : command.objects) {
+                if (node)
+                    uuids.append(uuidOf(node));
+            }
+            if (!uuids.isEmpty())
+                call(scene, "deleteNodes", { engine->toScriptValue(uuids) });
+        }
+    } break;
+
+    case CommandType::AddContainer:
+    case CommandType::RemoveContainer: {
+        if (!object)
+            break;
+
+        const bool isAdd = (command.type == CommandType::AddContainer) != isUndo;
+        if (isAdd)
+            call(scene, "addContainer", { engine->toScriptValue(object) });
+        else if (command.type == CommandType::AddContainer)
+            call(scene, "_detachContainer", { engine->toScriptValue(object) });
+        else
+            call(scene, "deleteContainer", { uuidOf(object) });
+    } break;
+
+    case CommandType::CreateLink: {
+        if (isUndo) {
+            if (object)
+                call(scene, "_detachLink", { engine->toScriptValue(object) });
+        } else if (object) {
+            // Restore the link object, it keeps all its properties
+            call(scene, "restoreLinks", { toArray(command.objects) });
+        } else {
+            const QJSValue link = call(scene, "createLink",
+                                       { command.inputPortUuid, command.outputPortUuid });
+            if (link.isQObject())
+                command.objects.append(link.toQObject());
+        }
+    } break;
+
+    case CommandType::Unlink: {
+        if (!isUndo)
+            call(scene, "unlinkNodes", { command.inputPortUuid, command.outputPortUuid });
+        else if (object)
+            call(scene, "restoreLinks", { toArray(command.objects) });
+    } break;
+
+    default:
+        break;
+    }
+}
+
+/*!
+ * A macro is undone in reverse order to respect the dependencies of its commands.
+ */
+void CommandStackCPP::replay(Macro &macro, bool isUndo)
+{
+    const bool wasReplaying = mIsReplaying;
+    setIsReplaying(true);
+    setObserversBlocked(true);
+
+    if (isUndo) {
+        for (int index = macro.size - 1; index >= 0; --index)
+            apply(macro.commands[index], true);
+    } else {
+        for (int index = 0; index < macro.size; ++index)
+            apply(macro.commands[index], false);
+    }
+
+    setObserversBlocked(false);
+    setIsReplaying(wasReplaying);
+}
+
+/*!
+ * The records keep their storage (capacity of the lists), only the references are dropped.
+ */
+void CommandStackCPP::discard(Macro &macro)
+{
+    for (int index = 0; index < macro.size; ++index) {
+        Command &command = macro.commands[index];
+        release(command);
+
+        command.type = CommandType::Custom;
+        command.scene.clear();
+        command.objects.clear();
+        command.links.clear();
+        command.inputPortUuid.clear();
+        command.outputPortUuid.clear();
+        command.key.clear();
+        command.oldValue = QJSValue();
+        command.newValue = QJSValue();
+        command.custom   = QJSValue();
+    }
+
+    macro.size = 0;
+}
+
+void CommandStackCPP::release(const Command &command)
+{
+    if (command.type == CommandType::Custom) {
+        releaseCustom(command.custom);
+        return;
+    }
+
+    QJSEngine *engine = qjsEngine(this);
+    if (command.type == CommandType::Property || !command.scene || !engine)
+        return;
+
+    QString collection = "nodes";
+    if (command.type == CommandType::AddContainer || command.type == CommandType::RemoveContainer)
+        collection = "containers";
+    else if (command.type == CommandType::CreateLink || command.type == CommandType::Unlink)
+        collection = "links";
+
+    const QJSValue scene = engine->toScriptValue(command.scene.data());
+    for (const QPointer<QObject> &object : command.objects)
+        releaseObject(scene, collection, object);
+    for (const QPointer<QObject> &link : command.links)
+        releaseObject(scene, "links", link);
+}
+
+/*!
+ * QML commands are released like the built-in ones (node, nodes, container, links, createdLink,
+ * removedLink of their scene) and destroyed. Plain JS commands are garbage collected.
+ */
+void CommandStackCPP::releaseCustom(const QJSValue &command)
+{
+    if (!command.isQObject())
+        return;
+
+    const QJSValue scene = command.property("scene");
+    if (scene.isQObject()) {
+        auto releaseValue = [&](const QString &property, const QString &collection) {
+            const QJSValue value = command.property(property);
+            if (value.isArray()) {
+                const int length = value.property("length").toInt();
+                for (int index = 0; index < length; ++index)
+                    releaseObject(scene, collection, value.property(index).toQObject());
+            } else if (value.isQObject()) {
+                releaseObject(scene, collection, value.toQObject());
+            }
+        };
+
+        releaseValue("node",        "nodes");
+        releaseValue("nodes",       "nodes");
+        releaseValue("container",   "containers");
+        releaseValue("links",       "links");
+        releaseValue("createdLink", "links");
+        releaseValue("removedLink", "links");
+    }
+
+    // destroy() fails for objects that are not created dynamically, they are not ours to delete
+    const QJSValue destroy = command.property("destroy");
+    if (destroy.isCallable())
+        destroy.callWithInstance(command);
+}
+
+void CommandStackCPP::releaseObject(const QJSValue &scene, const QString &collection,
+                                    QObject *object)
+{
+    if (!object)
+        return;
+
+    if (scene.property(collection).property(uuidOf(object)).isUndefined())
+        object->deleteLater();
+}
+
+/*!
+ * The entries are moved to the front of the new ring, the free slots of the old ring and their
+ * storage are dropped.
+ */
+void CommandStackCPP::relayout(int newCapacity)
+{
+    newCapacity = std::max(1, newCapacity);
+
+    while (mUndoCount + mRedoCount > newCapacity && mUndoCount > 0) {
+        discard(mRing[slot(mHead - mUndoCount)]);
+        --mUndoCount;
+    }
+    while (mRedoCount > newCapacity) {
+        discard(mRing[slot(mHead + mRedoCount - 1)]);
+        --mRedoCount;
+    }
+
+    QVector<Macro> ring(newCapacity);
+    const int first = mHead - mUndoCount;
+    for (int index = 0; index < mUndoCount + mRedoCount; ++index)
+        std::swap(ring[index], mRing[slot(first + index)]);
+
+    mRing.swap(ring);
+    mHead = mUndoCount % newCapacity;
+}
+
+int CommandStackCPP::slot(int index) const
+{
+    const int capacity = mRing.size();
+    return ((index % capacity) + capacity) % capacity;
+}
+
+void CommandStackCPP::setObserversBlocked(bool blocked)
+{
+    if (mUndoSpec)
+        mUndoSpec->setProperty("blockObservers", blocked);
+}
+
+QJSValue CommandStackCPP::call(const QJSValue &object, const QString &function,
+                               const QJSValueList &args) const
+{
+    const QJSValue method = object.property(function);
+    if (!method.isCallable()) {
+        qWarning() << "CommandStackCPP: No function" << function;
+        return QJSValue();
+    }
+
+    const QJSValue result = method.callWithInstance(object, args);
+    if (result.isError())
+        qWarning() << "CommandStackCPP:" << function << "failed:" << result.toString();
+
+    return result;
+}
+
+QJSValue CommandStackCPP::toArray(const QVector<QPointer<QObject>> &objects) const
+{
+    QJSEngine *engine = qjsEngine(this);
+    QJSValue array = engine->newArray();
+
+    quint32 index = 0;
+    for (const QPointer<QObject> &object : objects) {
+        if (object)
+            array.setProperty(index++, engine->toScriptValue(object.data()));
+    }
+
+    return array;
+}
+
+/*!
+ * The records are only converted when somebody listens (the autosave journal).
+ */
+void CommandStackCPP::emitMacroApplied(const Macro &macro)
+{
+    if (!isSignalConnected(QMetaMethod::fromSignal(&CommandStackCPP::macroApplied)))
+        return;
+
+    QVariantList subCommands;
+    subCommands.reserve(macro.size);
+
+    for (int index = 0; index < macro.size; ++index) {
+        const Command &command = macro.commands[index];
+        if (command.type == CommandType::Custom) {
+            subCommands.append(QVariant::fromValue(command.custom));
+            continue;
+        }
+
+        const QVariant object = QVariant::fromValue(command.objects.isEmpty()
+                                                    ? nullptr : command.objects.first().data());
+        QVariantMap record;
+        switch (command.type) {
+        case CommandType::AddNode:
+        case CommandType::RemoveNode:
+            record["node"] = object;
+            break;
+        case CommandType::AddNodes:
+        case CommandType::RemoveNodes:
+            record["nodes"] = toVariantList(command.objects);
+            break;
+        case CommandType::AddContainer:
+        case CommandType::RemoveContainer:
+            record["container"] = object;
+            break;
+        case CommandType::CreateLink:
+            record["createdLink"] = object;
+            break;
+        case CommandType::Unlink:
+            record["removedLink"] = object;
+            break;
+        case CommandType::Property:
+            record["target"] = object;
+            break;
+        default:
+            break;
+        }
+
+        if (!command.links.isEmpty())
+            record["links"] = toVariantList(command.links);
+
+        subCommands.append(record);
+    }
+
+    emit macroApplied(QVariantMap{ { "subCommands", subCommands } });
+}
@@ -0,0 +1,200 @@
+#include "GeometryStoreCPP.h"
+#include "LinkGuiConfigCPP.h"
+#include "NodeGuiConfigCPP.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*!
+ * Stores are shared by the gui configs, a store lives until its repository is destroyed and
+ * its last row is released.
+ */
+std::shared_ptr<GeometryStoreCPP> GeometryStoreCPP::forRepo(QObject *repo)
+{
+    if (!repo) {
+        static thread_local std::shared_ptr<GeometryStoreCPP> detachedStore =
+            std::make_shared<GeometryStoreCPP>();
+        return detachedStore;
+    }
+
+    static QMutex mutex;
+    static QHash<QObject *, std::weak_ptr<GeometryStoreCPP>> stores;
+
+    QMutexLocker locker(&mutex);
+    std::shared_ptr<GeometryStoreCPP> store = stores.value(repo).lock();
+    if (!store) {
+        // A new repository at the address of a destroyed one gets a new store
+        if (!stores.contains(repo)) {
+            QObject::connect(repo, &QObject::destroyed, [repo]() {
+                QMutexLocker locker(&mutex);
+                stores.remove(repo);
+            });
+        }
+
+        store = std::make_shared<GeometryStoreCPP>();
+        stores.insert(repo, store);
+    }
+
+    return store;
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Free rows are reused first, otherwise every column grows by one row.
+ */
+int GeometryStoreCPP::allocateNode(NodeGuiConfigCPP *config)
+{
+    int row;
+    if (!mFreeNodeRows.isEmpty()) {
+        row = mFreeNodeRows.takeLast();
+    } else {
+        row = int(mNodeFlags.size());
+        mNodeX.append(0.0f);
+        mNodeY.append(0.0f);
+        mNodeWidth.append(0);
+        mNodeHeight.append(0);
+        mNodeColor.append(QStringLiteral("white"));
+        mNodeOpacity.append(1.0);
+        mNodeFlags.append(0);
+        mNodeConfigs.append(nullptr);
+    }
+
+    mNodeX[row]         = 0.0f;
+    mNodeY[row]         = 0.0f;
+    mNodeWidth[row]     = 0;
+    mNodeHeight[row]    = 0;
+    mNodeColor[row]     = QStringLiteral("white");
+    mNodeOpacity[row]   = 1.0;
+    mNodeFlags[row]     = Alive;
+    mNodeConfigs[row]   = config;
+
+    return row;
+}
+
+void GeometryStoreCPP::releaseNode(int row)
+{
+    if (row < 0 || row >= mNodeFlags.size() || !(mNodeFlags.at(row) & Alive))
+        return;
+
+    mNodeFlags[row]     = 0;
+    mNodeColor[row].clear();
+    mNodeConfigs[row]   = nullptr;
+    mFreeNodeRows.append(row);
+
+    notifyNodeObservers(row);
+}
+
+int GeometryStoreCPP::allocateLink(LinkGuiConfigCPP *config)
+{
+    int row;
+    if (!mFreeLinkRows.isEmpty()) {
+        row = mFreeLinkRows.takeLast();
+    } else {
+        row = int(mLinkFlags.size());
+        mLinkColor.append(QStringLiteral("white"));
+        mLinkStyle.append(0);
+        mLinkType.append(0);
+        mLinkFlags.append(0);
+        mLinkConfigs.append(nullptr);
+    }
+
+    mLinkColor[row]     = QStringLiteral("white");
+    mLinkStyle[row]     = 0;
+    mLinkType[row]      = 0;
+    mLinkFlags[row]     = Alive;
+    mLinkConfigs[row]   = config;
+
+    return row;
+}
+
+void GeometryStoreCPP::releaseLink(int row)
+{
+    if (row < 0 || row >= mLinkFlags.size() || !(mLinkFlags.at(row) & Alive))
+        return;
+
+    mLinkFlags[row]     = 0;
+    mLinkColor[row].clear();
+    mLinkConfigs[row]   = nullptr;
+    mFreeLinkRows.append(row);
+}
+
+QRectF GeometryStoreCPP::nodeRect(int row) const
+{
+    return QRectF(mNodeX.at(row), mNodeY.at(row), mNodeWidth.at(row), mNodeHeight.at(row));
+}
+
+QObject *GeometryStoreCPP::nodeOwner(int row) const
+{
+    const NodeGuiConfigCPP *config = mNodeConfigs.at(row);
+    return config ? config->owner() : nullptr;
+}
+
+QObject *GeometryStoreCPP::linkOwner(int row) const
+{
+    const LinkGuiConfigCPP *config = mLinkConfigs.at(row);
+    return config ? config->owner() : nullptr;
+}
+
+void GeometryStoreCPP::setNodePosition(int row, float x, float y)
+{
+    if (mNodeX.at(row) == x && mNodeY.at(row) == y)
+        return;
+
+    mNodeX[row] = x;
+    mNodeY[row] = y;
+    notifyNodeObservers(row);
+
+    if (NodeGuiConfigCPP *config = mNodeConfigs.at(row))
+        emit config->positionChanged();
+}
+
+void GeometryStoreCPP::setNodeSize(int row, int width, int height)
+{
+    NodeGuiConfigCPP *config = mNodeConfigs.at(row);
+    const bool resized = mNodeWidth.at(row) != width || mNodeHeight.at(row) != height;
+
+    if (mNodeWidth.at(row) != width) {
+        mNodeWidth[row] = width;
+        if (config)
+            emit config->widthChanged();
+    }
+
+    if (mNodeHeight.at(row) != height) {
+        mNodeHeight[row] = height;
+        if (config)
+            emit config->heightChanged();
+    }
+
+    if (resized)
+        notifyNodeObservers(row);
+}
+
+int GeometryStoreCPP::addNodeObserver(NodeObserver observer)
+{
+    const int id = mNextObserverId++;
+    mNodeObservers.insert(id, std::move(observer));
+    return id;
+}
+
+void GeometryStoreCPP::removeNodeObserver(int id)
+{
+    mNodeObservers.remove(id);
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+void GeometryStoreCPP::notifyNodeObservers(int row) const
+{
+    for (const NodeObserver &observer : mNodeObservers)
+        observer(row);
+}
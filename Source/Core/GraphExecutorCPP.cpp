@@ -0,0 +1,404 @@
+#include "GraphExecutorCPP.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+GraphExecutorCPP::GraphExecutorCPP(QObject *parent)
+    : QObject{parent}
+{
+    mPool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+/*! Destructor, workers must not outlive the executor
+ * ************************************************************************************************/
+GraphExecutorCPP::~GraphExecutorCPP()
+{
+    if (mState)
+        mState->cancelled = true;
+
+    mPool.waitForDone();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Register a kernel, e.g. in main() before the QML engine is loaded. The kernel is called
+ * concurrently from pool threads and must not touch QObjects of the GUI thread.
+ */
+void GraphExecutorCPP::registerKernel(const QString &name, const Kernel &kernel)
+{
+    QMutexLocker locker(&kernelsMutex());
+    kernels().insert(name, kernel);
+}
+
+bool GraphExecutorCPP::hasKernel(const QString &name) const
+{
+    QMutexLocker locker(&kernelsMutex());
+    return kernels().contains(name);
+}
+
+/*!
+ * Start evaluating a graph. Nodes inside a cycle (and everything downstream of them) are
+ * skipped with a warning.
+ *
+ * \param nodes is a list of {id, kernel: string, params: map, guiAffine: bool, value: var}
+ * \param links is a list of {from: upstream node id, to: downstream node id}, the inputs of a
+ *        node are ordered like its links
+ * \param guiEvaluator is function(id, inputs, params) returning the output of a GUI-affine node
+ * \return false if there is nothing to evaluate
+ */
+bool GraphExecutorCPP::run(const QVariantList &nodes, const QVariantList &links,
+                           const QJSValue &guiEvaluator)
+{
+    cancel();
+
+    auto state = std::make_shared<RunState>();
+    mGuiEvaluator = guiEvaluator;
+
+    const int nodeCount = nodes.size();
+    QVector<Task> tasks;
+    QHash<QString, int> indexById;
+    tasks.reserve(nodeCount);
+    indexById.reserve(nodeCount);
+
+    {
+        QMutexLocker locker(&kernelsMutex());
+        for (const QVariant &nodeVariant : nodes) {
+            const QVariantMap node = nodeVariant.toMap();
+
+            Task task;
+            task.id     = node.value("id").toString();
+            task.params = node.value("params").toMap();
+
+            const QString kernelName = node.value("kernel").toString();
+            if (!kernelName.isEmpty()) {
+                task.kind   = TaskKind::Kernel;
+                task.kernel = kernels().value(kernelName);
+                if (!task.kernel) {
+                    qWarning() << "GraphExecutor: Unknown kernel" << kernelName << "for node" << task.id;
+                    task.kernel = [](const QVariantList &, const QVariantMap &) { return QVariant(); };
+                }
+            } else if (node.value("guiAffine").toBool()) {
+                task.kind = TaskKind::GuiAffine;
+            } else if (node.contains("value")) {
+                task.kind  = TaskKind::Source;
+                task.value = node.value("value");
+            }
+
+            indexById.insert(task.id, tasks.size());
+            tasks.append(task);
+        }
+    }
+
+    QVector<int> degree(tasks.size(), 0);
+    for (const QVariant &linkVariant : links) {
+        const QVariantMap link = linkVariant.toMap();
+        const int from = indexById.value(link.value("from").toString(), -1);
+        const int to   = indexById.value(link.value("to").toString(), -1);
+        if (from < 0 || to < 0)
+            continue;
+
+        tasks[from].downstream.append(to);
+        tasks[to].upstream.append(from);
+        ++degree[to];
+    }
+
+    // Drop nodes that can never become ready (Kahn's algorithm)
+    QVector<int> order;
+    order.reserve(tasks.size());
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (degree[i] == 0)
+            order.append(i);
+    }
+    for (int head = 0; head < order.size(); ++head) {
+        for (int next : tasks[order[head]].downstream) {
+            if (--degree[next] == 0)
+                order.append(next);
+        }
+    }
+
+    if (order.size() != tasks.size()) {
+        state->skippedNodes = tasks.size() - order.size();
+        qWarning() << "GraphExecutor:" << state->skippedNodes << "nodes in or behind a cycle are skipped";
+
+        QVector<int> newIndex(tasks.size(), -1);
+        for (int i = 0; i < order.size(); ++i)
+            newIndex[order[i]] = i;
+
+        QVector<Task> acyclicTasks;
+        acyclicTasks.reserve(order.size());
+        for (int oldIndex : order) {
+            Task task = tasks[oldIndex];
+            QVector<int> upstream;
+            for (int up : task.upstream)
+                upstream.append(newIndex[up]);
+            QVector<int> downstream;
+            for (int down : task.downstream) {
+                if (newIndex[down] >= 0)
+                    downstream.append(newIndex[down]);
+            }
+            task.upstream   = upstream;
+            task.downstream = downstream;
+            acyclicTasks.append(task);
+        }
+        tasks = acyclicTasks;
+    }
+
+    if (tasks.isEmpty())
+        return false;
+
+    state->tasks   = tasks;
+    state->outputs.resize(tasks.size());
+    state->pending.reset(new std::atomic<int>[tasks.size()]);
+    for (int i = 0; i < tasks.size(); ++i)
+        state->pending[i] = tasks[i].upstream.size();
+    state->remaining = tasks.size();
+
+    mState = state;
+    state->timer.start();
+    emit busyChanged();
+
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].upstream.isEmpty())
+            dispatch(state, i);
+    }
+
+    return true;
+}
+
+void GraphExecutorCPP::cancel()
+{
+    if (!mState)
+        return;
+
+    const bool wasBusy = busy();
+    mState->cancelled = true;
+    mState.reset();
+
+    if (wasBusy)
+        emit busyChanged();
+}
+
+bool GraphExecutorCPP::busy() const
+{
+    return mState && mState->remaining > 0 && !mState->cancelled;
+}
+
+int GraphExecutorCPP::maxThreadCount() const
+{
+    return mPool.maxThreadCount();
+}
+
+void GraphExecutorCPP::setMaxThreadCount(int maxThreadCount)
+{
+    if (mPool.maxThreadCount() == maxThreadCount)
+        return;
+
+    mPool.setMaxThreadCount(maxThreadCount);
+    emit maxThreadCountChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+QHash<QString, GraphExecutorCPP::Kernel> &GraphExecutorCPP::kernels()
+{
+    static QHash<QString, Kernel> registeredKernels;
+    return registeredKernels;
+}
+
+QMutex &GraphExecutorCPP::kernelsMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/*!
+ * Start a ready task: kernels go to the pool, GUI-affine tasks to the GUI thread, cheap tasks
+ * run right away.
+ */
+void GraphExecutorCPP::dispatch(const std::shared_ptr<RunState> &state, int index)
+{
+    switch (state->tasks.at(index).kind) {
+    case TaskKind::Kernel:
+        mPool.start([this, state, index]() { execute(state, index); });
+        break;
+
+    case TaskKind::GuiAffine:
+        QMetaObject::invokeMethod(this, [this, state, index]() { execute(state, index); },
+                                  Qt::QueuedConnection);
+        break;
+
+    default:
+        execute(state, index);
+        break;
+    }
+}
+
+/*!
+ * Evaluate a task and release its downstream tasks. The first released task that may run on
+ * this thread is evaluated in the same loop (keeps a chain on one core and its data in cache),
+ * the others are dispatched.
+ */
+void GraphExecutorCPP::execute(const std::shared_ptr<RunState> &state, int index)
+{
+    const bool isGuiThread = QThread::currentThread() == thread();
+
+    while (index >= 0) {
+        if (state->cancelled)
+            return;
+
+        const Task &task = state->tasks.at(index);
+
+        QVariantList inputs;
+        inputs.reserve(task.upstream.size());
+        for (int up : task.upstream)
+            inputs.append(state->outputs[up]);
+
+        QVariant output;
+        switch (task.kind) {
+        case TaskKind::Kernel: {
+            const int running = ++state->running;
+            int peak = state->peakRunning;
+            while (running > peak && !state->peakRunning.compare_exchange_weak(peak, running)) {}
+
+            QElapsedTimer timer;
+            timer.start();
+            output = task.kernel(inputs, task.params);
+            state->kernelNsecs += timer.nsecsElapsed();
+
+            --state->running;
+        } break;
+
+        case TaskKind::GuiAffine:
+            output = evaluateOnGui(task, inputs);
+            break;
+
+        case TaskKind::Source:
+            output = task.value;
+            break;
+
+        case TaskKind::PassThrough:
+            output = inputs.value(0);
+            break;
+        }
+
+        state->outputs[index] = output;
+
+        {
+            QMutexLocker locker(&state->mutex);
+            state->completed.append(QVariantMap{ { "id",     task.id },
+                                                 { "value",  output },
+                                                 { "inputs", inputs } });
+            if (!state->flushPosted) {
+                state->flushPosted = true;
+                QMetaObject::invokeMethod(this, [this, state]() { flush(state); },
+                                          Qt::QueuedConnection);
+            }
+        }
+
+        int next = -1;
+        for (int down : task.downstream) {
+            if (--state->pending[down] != 0)
+                continue;
+
+            if (next < 0 && canRunInline(state->tasks.at(down).kind, isGuiThread))
+                next = down;
+            else
+                dispatch(state, down);
+        }
+
+        if (--state->remaining == 0)
+            QMetaObject::invokeMethod(this, [this, state]() { finish(state); }, Qt::QueuedConnection);
+
+        index = next;
+    }
+}
+
+/*!
+ * Runs on the GUI thread.
+ */
+QVariant GraphExecutorCPP::evaluateOnGui(const Task &task, const QVariantList &inputs)
+{
+    QJSEngine *engine = qjsEngine(this);
+    if (!mGuiEvaluator.isCallable() || !engine) {
+        qWarning() << "GraphExecutor: No GUI evaluator for node" << task.id;
+        return QVariant();
+    }
+
+    const QJSValue result = mGuiEvaluator.call({ QJSValue(task.id),
+                                                 engine->toScriptValue(inputs),
+                                                 engine->toScriptValue(task.params) });
+    if (result.isError()) {
+        qWarning() << "GraphExecutor: GUI evaluator failed for node" << task.id << result.toString();
+        return QVariant();
+    }
+
+    return result.toVariant();
+}
+
+/*!
+ * Kernels never run on the GUI thread and GUI-affine tasks only run there.
+ */
+bool GraphExecutorCPP::canRunInline(TaskKind kind, bool isGuiThread) const
+{
+    switch (kind) {
+    case TaskKind::Kernel:
+        return !isGuiThread;
+    case TaskKind::GuiAffine:
+        return isGuiThread;
+    default:
+        return true;
+    }
+}
+
+/*!
+ * Deliver all results completed since the last flush. Results of a cancelled run are dropped.
+ */
+void GraphExecutorCPP::flush(const std::shared_ptr<RunState> &state)
+{
+    QVariantList results;
+    {
+        QMutexLocker locker(&state->mutex);
+        results.swap(state->completed);
+        state->flushPosted = false;
+    }
+
+    if (state != mState || results.isEmpty())
+        return;
+
+    emit nodesEvaluated(results);
+}
+
+void GraphExecutorCPP::finish(const std::shared_ptr<RunState> &state)
+{
+    if (state != mState)
+        return;
+
+    flush(state);
+
+    const qreal elapsedMs = state->timer.nsecsElapsed() / 1.0e6;
+    const qreal kernelMs  = state->kernelNsecs / 1.0e6;
+
+    QVariantMap stats;
+    stats["nodeCount"]       = state->tasks.size();
+    stats["elapsedMs"]       = elapsedMs;
+    stats["kernelMs"]        = kernelMs;
+    stats["parallelism"]     = elapsedMs > 0 ? kernelMs / elapsedMs : 0.0;
+    stats["peakConcurrency"] = int(state->peakRunning);
+    stats["threadCount"]     = mPool.maxThreadCount();
+    stats["skippedNodes"]    = state->skippedNodes;
+
+    emit busyChanged();
+    emit finished(stats);
+}
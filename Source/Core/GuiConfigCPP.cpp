@@ -0,0 +1,61 @@
+#include "GuiConfigCPP.h"
+
+#include <QJSValue>
+#include <QMetaProperty>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+GuiConfigCPP::GuiConfigCPP(QObject *parent)
+    : QSObjectCpp{parent}
+{}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+void GuiConfigCPP::setProperties(const QVariant &properties)
+{
+    QVariant value = properties;
+    if (value.metaType() == QMetaType::fromType<QJSValue>())
+        value = value.value<QJSValue>().toVariant();
+
+    if (const QObject *source = value.value<QObject *>()) {
+        const QMetaObject *sourceMeta = source->metaObject();
+        for (int index = 0; index < sourceMeta->propertyCount(); ++index) {
+            const QMetaProperty property = sourceMeta->property(index);
+            setCopiedProperty(QString::fromLatin1(property.name()), property.read(source));
+        }
+        return;
+    }
+
+    const QVariantMap map = value.toMap();
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        setCopiedProperty(it.key(), it.value());
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+void GuiConfigCPP::setCopiedProperty(const QString &key, const QVariant &value)
+{
+    if (key.startsWith(QLatin1Char('_')) || key.startsWith(QLatin1String("qs")) ||
+        key == QLatin1String("objectName"))
+        return;
+
+    if (value.metaType() == QMetaType::fromType<QJSValue>() &&
+        value.value<QJSValue>().isCallable())
+        return;
+
+    const int index = metaObject()->indexOfProperty(key.toLatin1().constData());
+    if (index < 0)
+        return;
+
+    const QMetaProperty property = metaObject()->property(index);
+    if (property.isWritable())
+        property.write(this, value);
+}
@@ -0,0 +1,428 @@
+#include "HandleRegistryCPP.h"
+
+#include <QJSValue>
+#include <QMetaProperty>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+HandleRegistryCPP::HandleRegistryCPP(QObject *parent)
+    : QObject{parent}
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Interned UUIDs are never released, a handle stays valid for the lifetime of the process.
+ */
+HandleRegistryCPP::Handle HandleRegistryCPP::intern(const QString &uuid)
+{
+    if (uuid.isEmpty())
+        return 0;
+
+    {
+        QReadLocker locker(&handlesLock());
+        const auto it = handles().constFind(uuid);
+        if (it != handles().constEnd())
+            return it.value();
+    }
+
+    QWriteLocker locker(&handlesLock());
+    auto it = handles().find(uuid);
+    if (it == handles().end()) {
+        uuids().append(uuid);
+        it = handles().insert(uuid, uuids().size());
+    }
+
+    return it.value();
+}
+
+/*!
+ * Lookups only take the read lock, unknown UUIDs (e.g. queries of removed objects) do not
+ * grow the table.
+ */
+HandleRegistryCPP::Handle HandleRegistryCPP::lookup(const QString &uuid)
+{
+    if (uuid.isEmpty())
+        return 0;
+
+    QReadLocker locker(&handlesLock());
+    return handles().value(uuid, 0);
+}
+
+QString HandleRegistryCPP::uuidOf(Handle handle)
+{
+    QReadLocker locker(&handlesLock());
+    return uuids().value(handle - 1);
+}
+
+int HandleRegistryCPP::handle(const QString &uuid)
+{
+    return lookup(uuid);
+}
+
+QString HandleRegistryCPP::uuid(int handle) const
+{
+    return uuidOf(handle);
+}
+
+QObject *HandleRegistryCPP::node(int handle)
+{
+    return mNodes.value(handle);
+}
+
+QObject *HandleRegistryCPP::port(int handle)
+{
+    return mPorts.value(handle);
+}
+
+QObject *HandleRegistryCPP::link(int handle)
+{
+    return mLinks.value(handle).link;
+}
+
+int HandleRegistryCPP::nodeOfPort(int portHandle)
+{
+    return mNodeOfPort.value(portHandle, 0);
+}
+
+QObject *HandleRegistryCPP::linkBetween(int inputPortHandle, int outputPortHandle)
+{
+    return link(mLinkByPorts.value(pairKey(inputPortHandle, outputPortHandle), 0));
+}
+
+bool HandleRegistryCPP::hasLink(int inputPortHandle, int outputPortHandle)
+{
+    return mLinkByPorts.contains(pairKey(inputPortHandle, outputPortHandle));
+}
+
+int HandleRegistryCPP::linkCountTo(int portHandle)
+{
+    return mLinksTo.value(portHandle, 0);
+}
+
+int HandleRegistryCPP::linkCountFrom(int portHandle)
+{
+    return mLinksFrom.value(portHandle, 0);
+}
+
+bool HandleRegistryCPP::hasNodeLink(int fromNodeHandle, int toNodeHandle)
+{
+    return mNodeLinks.contains(pairKey(fromNodeHandle, toNodeHandle));
+}
+
+/*!
+ * The node is watched for port changes. Adding an indexed node again re-indexes its ports.
+ */
+void HandleRegistryCPP::addNode(QObject *node)
+{
+    const Handle nodeHandle = uuidHandle(node);
+    if (nodeHandle == 0)
+        return;
+
+    mNodes.insert(nodeHandle, node);
+    watchProperty(node, "ports", "onPortsChanged()");
+    indexPorts(nodeHandle, node);
+}
+
+void HandleRegistryCPP::addNodes(const QVariantList &nodes)
+{
+    for (const QVariant &node : nodes)
+        addNode(node.value<QObject *>());
+}
+
+/*!
+ * The links of the node keep their entries until they are removed themselves.
+ */
+void HandleRegistryCPP::removeNode(QObject *node)
+{
+    const Handle nodeHandle = node ? lookup(node->property("_qsUuid").toString()) : 0;
+    if (nodeHandle == 0 || !mNodes.contains(nodeHandle))
+        return;
+
+    disconnect(node, nullptr, this, nullptr);
+    unindexPorts(nodeHandle);
+    mNodes.remove(nodeHandle);
+}
+
+void HandleRegistryCPP::removeNodes(const QVariantList &nodes)
+{
+    for (const QVariant &node : nodes)
+        removeNode(node.value<QObject *>());
+}
+
+/*!
+ * The link is watched for port reassignments. Its ports are resolved now, so the nodes of the
+ * ports are added before their links.
+ */
+void HandleRegistryCPP::addLink(QObject *link)
+{
+    const Handle linkHandle = uuidHandle(link);
+    if (linkHandle == 0)
+        return;
+
+    unindexLink(linkHandle);
+    watchProperty(link, "inputPort",  "onLinkPortsChanged()");
+    watchProperty(link, "outputPort", "onLinkPortsChanged()");
+    indexLink(linkHandle, link);
+}
+
+void HandleRegistryCPP::addLinks(const QVariantList &links)
+{
+    for (const QVariant &link : links)
+        addLink(link.value<QObject *>());
+}
+
+void HandleRegistryCPP::removeLink(QObject *link)
+{
+    const Handle linkHandle = link ? lookup(link->property("_qsUuid").toString()) : 0;
+    if (linkHandle == 0 || !mLinks.contains(linkHandle))
+        return;
+
+    disconnect(link, nullptr, this, nullptr);
+    unindexLink(linkHandle);
+}
+
+void HandleRegistryCPP::removeLinks(const QVariantList &links)
+{
+    for (const QVariant &link : links)
+        removeLink(link.value<QObject *>());
+}
+
+/*!
+ * Only needed when scene.nodes / scene.links were replaced as a whole, e.g. by loading a
+ * repository. Nodes are indexed before links.
+ */
+void HandleRegistryCPP::rebuild()
+{
+    for (const QPointer<QObject> &node : std::as_const(mNodes))
+        if (node)
+            disconnect(node, nullptr, this, nullptr);
+    for (const LinkEntry &entry : std::as_const(mLinks))
+        if (entry.link)
+            disconnect(entry.link, nullptr, this, nullptr);
+
+    mNodes.clear();
+    mPorts.clear();
+    mLinks.clear();
+    mNodeOfPort.clear();
+    mPortsOfNode.clear();
+    mPortHandles.clear();
+    mLinkByPorts.clear();
+    mLinksTo.clear();
+    mLinksFrom.clear();
+    mNodeLinks.clear();
+
+    for (const auto &entry : mapEntries(mTarget, "nodes"))
+        addNode(entry.second);
+
+    for (const auto &entry : mapEntries(mTarget, "links"))
+        addLink(entry.second);
+}
+
+QObject *HandleRegistryCPP::target() const
+{
+    return mTarget;
+}
+
+void HandleRegistryCPP::setTarget(QObject *target)
+{
+    if (mTarget == target)
+        return;
+
+    mTarget = target;
+    rebuild();
+    emit targetChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void HandleRegistryCPP::onPortsChanged()
+{
+    QObject *node = sender();
+    const Handle nodeHandle = uuidHandle(node);
+    if (nodeHandle == 0 || !mNodes.contains(nodeHandle))
+        return;
+
+    unindexPorts(nodeHandle);
+    indexPorts(nodeHandle, node);
+}
+
+void HandleRegistryCPP::onLinkPortsChanged()
+{
+    QObject *link = sender();
+    const Handle linkHandle = uuidHandle(link);
+    if (linkHandle == 0 || !mLinks.contains(linkHandle))
+        return;
+
+    unindexLink(linkHandle);
+    indexLink(linkHandle, link);
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+QHash<QString, HandleRegistryCPP::Handle> &HandleRegistryCPP::handles()
+{
+    static QHash<QString, Handle> internedHandles;
+    return internedHandles;
+}
+
+QVector<QString> &HandleRegistryCPP::uuids()
+{
+    static QVector<QString> internedUuids;
+    return internedUuids;
+}
+
+QReadWriteLock &HandleRegistryCPP::handlesLock()
+{
+    static QReadWriteLock lock;
+    return lock;
+}
+
+quint64 HandleRegistryCPP::pairKey(Handle first, Handle second)
+{
+    return (quint64(quint32(first)) << 32) | quint32(second);
+}
+
+QList<QPair<QString, QObject *>> HandleRegistryCPP::mapEntries(QObject *object, const char *property)
+{
+    QList<QPair<QString, QObject *>> entries;
+    if (!object)
+        return entries;
+
+    QVariant value = object->property(property);
+    if (value.metaType() == QMetaType::fromType<QJSValue>())
+        value = value.value<QJSValue>().toVariant();
+
+    const QVariantMap map = value.toMap();
+    entries.reserve(map.size());
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        QObject *entry = it.value().value<QObject *>();
+        if (entry)
+            entries.append({ it.key(), entry });
+    }
+
+    return entries;
+}
+
+void HandleRegistryCPP::watchProperty(QObject *sender, const char *property, const char *slot)
+{
+    const QMetaObject *senderMeta = sender->metaObject();
+    const int propertyIndex = senderMeta->indexOfProperty(property);
+    if (propertyIndex < 0)
+        return;
+
+    const QMetaMethod notifySignal = senderMeta->property(propertyIndex).notifySignal();
+    const int slotIndex = metaObject()->indexOfSlot(slot);
+    if (!notifySignal.isValid() || slotIndex < 0)
+        return;
+
+    connect(sender, notifySignal, this, metaObject()->method(slotIndex), Qt::UniqueConnection);
+}
+
+HandleRegistryCPP::Handle HandleRegistryCPP::uuidHandle(QObject *object)
+{
+    return object ? intern(object->property("_qsUuid").toString()) : 0;
+}
+
+/*!
+ * Only the ports of one node are read, O(ports of the node).
+ */
+void HandleRegistryCPP::indexPorts(Handle nodeHandle, QObject *node)
+{
+    unindexPorts(nodeHandle);
+
+    QVector<Handle> &ports = mPortsOfNode[nodeHandle];
+    for (const auto &[portUuid, port] : mapEntries(node, "ports")) {
+        const Handle portHandle = intern(portUuid);
+        mPorts.insert(portHandle, port);
+        mNodeOfPort.insert(portHandle, nodeHandle);
+        mPortHandles.insert(port, portHandle);
+        ports.append(portHandle);
+    }
+}
+
+void HandleRegistryCPP::unindexPorts(Handle nodeHandle)
+{
+    const QVector<Handle> ports = mPortsOfNode.take(nodeHandle);
+    for (const Handle portHandle : ports) {
+        // The port may have moved to another node meanwhile
+        if (mNodeOfPort.value(portHandle, 0) != nodeHandle)
+            continue;
+
+        mPortHandles.remove(mPorts.value(portHandle));
+        mPorts.remove(portHandle);
+        mNodeOfPort.remove(portHandle);
+    }
+}
+
+void HandleRegistryCPP::indexLink(Handle linkHandle, QObject *link)
+{
+    LinkEntry entry;
+    entry.link       = link;
+    entry.inputPort  = portHandle(link->property("inputPort").value<QObject *>());
+    entry.outputPort = portHandle(link->property("outputPort").value<QObject *>());
+
+    if (entry.inputPort != 0 && entry.outputPort != 0) {
+        mLinkByPorts.insert(pairKey(entry.inputPort, entry.outputPort), linkHandle);
+        ++mLinksFrom[entry.inputPort];
+        ++mLinksTo[entry.outputPort];
+
+        entry.fromNode = mNodeOfPort.value(entry.inputPort, 0);
+        entry.toNode   = mNodeOfPort.value(entry.outputPort, 0);
+        if (entry.fromNode != 0 && entry.toNode != 0)
+            ++mNodeLinks[pairKey(entry.fromNode, entry.toNode)];
+    }
+
+    mLinks.insert(linkHandle, entry);
+}
+
+void HandleRegistryCPP::unindexLink(Handle linkHandle)
+{
+    const auto it = mLinks.constFind(linkHandle);
+    if (it == mLinks.constEnd())
+        return;
+
+    const LinkEntry entry = it.value();
+    mLinks.erase(it);
+
+    if (entry.inputPort == 0 || entry.outputPort == 0)
+        return;
+
+    const auto decrement = [](auto &counts, auto key) {
+        const auto count = counts.find(key);
+        if (count != counts.end() && --count.value() <= 0)
+            counts.erase(count);
+    };
+
+    const quint64 portsKey = pairKey(entry.inputPort, entry.outputPort);
+    if (mLinkByPorts.value(portsKey, 0) == linkHandle)
+        mLinkByPorts.remove(portsKey);
+
+    decrement(mLinksFrom, entry.inputPort);
+    decrement(mLinksTo, entry.outputPort);
+
+    if (entry.fromNode != 0 && entry.toNode != 0)
+        decrement(mNodeLinks, pairKey(entry.fromNode, entry.toNode));
+}
+
+HandleRegistryCPP::Handle HandleRegistryCPP::portHandle(QObject *port)
+{
+    if (!port)
+        return 0;
+
+    const auto it = mPortHandles.constFind(port);
+    return it != mPortHandles.constEnd() ? it.value() : uuidHandle(port);
+}
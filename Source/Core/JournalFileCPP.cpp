@@ -0,0 +1,529 @@
+#include "JournalFileCPP.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int  kCheckpointVersion = 1;
+const char kReferencePrefix[] = "qqs:/";
+
+//! Flush the OS buffers of an open file to the disk
+bool syncFile(QFile &file)
+{
+#if defined(Q_OS_WIN)
+    return ::_commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+JournalFileCPP::JournalFileCPP(QObject *parent)
+    : QObject{parent}
+    , mPendingRecords(0)
+    , mSequence(0)
+    , mJournalBytes(0)
+{
+    mCommitTimer.setSingleShot(true);
+    mCommitTimer.setInterval(1000);
+    connect(&mCommitTimer, &QTimer::timeout, this, &JournalFileCPP::commit);
+
+    connect(&mCheckpointWatcher, &QFutureWatcher<CheckpointResult>::finished,
+            this, &JournalFileCPP::onCheckpointFinished);
+    connect(&mRecoveryWatcher, &QFutureWatcher<RecoveryResult>::finished,
+            this, &JournalFileCPP::onRecoveryFinished);
+}
+
+/*! Destructor, commits the buffered records and waits for the workers
+ * ************************************************************************************************/
+JournalFileCPP::~JournalFileCPP()
+{
+    commit();
+    closeJournal();
+
+    mCheckpointWatcher.waitForFinished();
+    mRecoveryWatcher.waitForFinished();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+bool JournalFileCPP::hasRecoveryData() const
+{
+    return !mFilePath.isEmpty() && QFile::exists(checkpointPath());
+}
+
+/*!
+ * Buffer a record, the first buffered record arms the group commit timer so the latency of a
+ * record is bounded by commitInterval, independent of the edit rate.
+ *
+ * \param record is {ops: [...]}, the sequence number is added here.
+ * \return the sequence number of the record or -1 if no filePath is set.
+ */
+qint64 JournalFileCPP::append(const QVariantMap &record)
+{
+    if (mFilePath.isEmpty()) {
+        qWarning() << "JournalFile: No file path set, record is dropped";
+        return -1;
+    }
+
+    QJsonObject jsonRecord = QJsonObject::fromVariantMap(record);
+    jsonRecord.insert("seq", ++mSequence);
+
+    mPending += QJsonDocument(jsonRecord).toJson(QJsonDocument::Compact);
+    mPending += '\n';
+    ++mPendingRecords;
+
+    if (!mCommitTimer.isActive())
+        mCommitTimer.start();
+
+    emit journalChanged();
+
+    return mSequence;
+}
+
+/*!
+ * Group commit: write all buffered records with a single write and sync.
+ */
+bool JournalFileCPP::commit()
+{
+    mCommitTimer.stop();
+
+    if (mPending.isEmpty())
+        return true;
+
+    if (!openJournal())
+        return false;
+
+    const qint64 written = mJournal.write(mPending);
+    if (written != mPending.size() || !mJournal.flush() || !syncFile(mJournal)) {
+        const QString error = QStringLiteral("Failed to write journal %1: %2")
+                                  .arg(journalPath(), mJournal.errorString());
+        qWarning() << "JournalFile:" << error;
+        closeJournal();
+        emit failed(error);
+        return false;
+    }
+
+    const int recordCount = mPendingRecords;
+    mJournalBytes += written;
+    mPending.clear();
+    mPendingRecords = 0;
+
+    emit journalChanged();
+    emit committed(recordCount, written);
+
+    return true;
+}
+
+/*!
+ * Start a new checkpoint. The records up to now are committed and the journal is moved aside,
+ * new records go to a fresh journal while the checkpoint is serialized on a worker thread. The
+ * old journal is removed once the checkpoint is on disk.
+ *
+ * \param objects is the repository dump (QSRepository.dumpRepo()).
+ * \return false if a checkpoint or recovery is running.
+ */
+bool JournalFileCPP::writeCheckpoint(const QVariantMap &objects)
+{
+    if (mFilePath.isEmpty()) {
+        qWarning() << "JournalFile: No file path set, checkpoint is skipped";
+        return false;
+    }
+
+    if (busy()) {
+        qWarning() << "JournalFile: Checkpoint skipped, journal is busy";
+        return false;
+    }
+
+    if (!commit() || !rotateJournal())
+        return false;
+
+    mJournalBytes = 0;
+    emit journalChanged();
+
+    mCheckpointWatcher.setFuture(QtConcurrent::run(&JournalFileCPP::writeCheckpointFile,
+                                                   checkpointPath(), objects, mSequence));
+    emit busyChanged();
+
+    return true;
+}
+
+/*!
+ * Start the recovery on a worker thread.
+ *
+ * \return false if there is no checkpoint or the journal is busy.
+ */
+bool JournalFileCPP::recover()
+{
+    if (!hasRecoveryData() || busy())
+        return false;
+
+    commit();
+    closeJournal();
+
+    mRecoveryWatcher.setFuture(QtConcurrent::run(&JournalFileCPP::recoverFiles, checkpointPath(),
+                                                 QStringList{ previousJournalPath(), journalPath() }));
+    emit busyChanged();
+
+    return true;
+}
+
+/*!
+ * A running checkpoint is waited for, its file is removed too.
+ */
+void JournalFileCPP::discard()
+{
+    if (mRecoveryWatcher.isRunning()) {
+        qWarning() << "JournalFile: Can not discard while the journal is recovered";
+        return;
+    }
+
+    mCheckpointWatcher.waitForFinished();
+
+    mCommitTimer.stop();
+    mPending.clear();
+    mPendingRecords = 0;
+    closeJournal();
+
+    if (!mFilePath.isEmpty()) {
+        QFile::remove(checkpointPath());
+        QFile::remove(journalPath());
+        QFile::remove(previousJournalPath());
+    }
+
+    mJournalBytes = 0;
+    emit journalChanged();
+}
+
+QString JournalFileCPP::filePath() const
+{
+    return mFilePath;
+}
+
+void JournalFileCPP::setFilePath(const QString &filePath)
+{
+    if (mFilePath == filePath)
+        return;
+
+    // Records belong to the old files
+    commit();
+    closeJournal();
+
+    mFilePath = filePath;
+    emit filePathChanged();
+}
+
+QString JournalFileCPP::defaultFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/autosave/scene");
+}
+
+int JournalFileCPP::commitInterval() const
+{
+    return mCommitTimer.interval();
+}
+
+void JournalFileCPP::setCommitInterval(int commitInterval)
+{
+    if (mCommitTimer.interval() == commitInterval)
+        return;
+
+    mCommitTimer.setInterval(commitInterval);
+    emit commitIntervalChanged();
+}
+
+int JournalFileCPP::pendingRecords() const
+{
+    return mPendingRecords;
+}
+
+qint64 JournalFileCPP::sequence() const
+{
+    return mSequence;
+}
+
+qint64 JournalFileCPP::journalBytes() const
+{
+    return mJournalBytes;
+}
+
+bool JournalFileCPP::busy() const
+{
+    return mCheckpointWatcher.isRunning() || mRecoveryWatcher.isRunning();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+QString JournalFileCPP::checkpointPath() const
+{
+    return mFilePath + QStringLiteral(".checkpoint");
+}
+
+QString JournalFileCPP::journalPath() const
+{
+    return mFilePath + QStringLiteral(".journal");
+}
+
+QString JournalFileCPP::previousJournalPath() const
+{
+    return mFilePath + QStringLiteral(".journal.prev");
+}
+
+bool JournalFileCPP::openJournal()
+{
+    if (mJournal.isOpen())
+        return true;
+
+    QDir().mkpath(QFileInfo(journalPath()).absolutePath());
+    mJournal.setFileName(journalPath());
+    if (!mJournal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        const QString error = QStringLiteral("Failed to open journal %1: %2")
+                                  .arg(journalPath(), mJournal.errorString());
+        qWarning() << "JournalFile:" << error;
+        emit failed(error);
+        return false;
+    }
+
+    return true;
+}
+
+void JournalFileCPP::closeJournal()
+{
+    if (mJournal.isOpen())
+        mJournal.close();
+}
+
+/*!
+ * Move the journal aside. If the previous checkpoint failed the old journal is still needed,
+ * the current journal is then appended to it.
+ */
+bool JournalFileCPP::rotateJournal()
+{
+    closeJournal();
+
+    if (!QFile::exists(journalPath()))
+        return true;
+
+    if (!QFile::exists(previousJournalPath()))
+        return QFile::rename(journalPath(), previousJournalPath());
+
+    QFile current(journalPath());
+    QFile previous(previousJournalPath());
+    if (!current.open(QIODevice::ReadOnly) ||
+        !previous.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "JournalFile: Failed to rotate journal" << journalPath();
+        return false;
+    }
+
+    const QByteArray records = current.readAll();
+    if (previous.write(records) != records.size() || !previous.flush() || !syncFile(previous)) {
+        qWarning() << "JournalFile: Failed to rotate journal" << journalPath();
+        return false;
+    }
+
+    current.close();
+    return QFile::remove(journalPath());
+}
+
+/*!
+ * Runs on the worker thread: serialize the dump and replace the checkpoint atomically.
+ */
+JournalFileCPP::CheckpointResult JournalFileCPP::writeCheckpointFile(const QString &path,
+                                                                     const QVariantMap &objects,
+                                                                     qint64 sequence)
+{
+    CheckpointResult result;
+    result.sequence = sequence;
+
+    QJsonObject checkpoint;
+    checkpoint.insert("version",  kCheckpointVersion);
+    checkpoint.insert("sequence", sequence);
+    checkpoint.insert("objects",  QJsonObject::fromVariantMap(objects));
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        result.error = QStringLiteral("Failed to open checkpoint %1: %2").arg(path, file.errorString());
+        return result;
+    }
+
+    file.write(QJsonDocument(checkpoint).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+        result.error = QStringLiteral("Failed to write checkpoint %1: %2").arg(path, file.errorString());
+
+    return result;
+}
+
+/*!
+ * Runs on the worker thread: load the checkpoint and apply the newer journal records. A record
+ * that does not parse is the torn tail of a crashed write, the rest of that journal is ignored.
+ */
+JournalFileCPP::RecoveryResult JournalFileCPP::recoverFiles(const QString &checkpointPath,
+                                                           const QStringList &journalPaths)
+{
+    RecoveryResult result;
+
+    QFile checkpointFile(checkpointPath);
+    if (!checkpointFile.open(QIODevice::ReadOnly)) {
+        result.error = QStringLiteral("Failed to open checkpoint %1: %2")
+                           .arg(checkpointPath, checkpointFile.errorString());
+        return result;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(checkpointFile.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        result.error = QStringLiteral("Failed to parse checkpoint %1: %2")
+                           .arg(checkpointPath, parseError.errorString());
+        return result;
+    }
+
+    const QJsonObject checkpoint = document.object();
+    if (checkpoint.value("version").toInt() != kCheckpointVersion) {
+        result.error = QStringLiteral("Unsupported checkpoint version in %1").arg(checkpointPath);
+        return result;
+    }
+
+    const qint64 checkpointSequence = checkpoint.value("sequence").toInteger();
+    QVariantMap objects = checkpoint.value("objects").toObject().toVariantMap();
+
+    QString rootUuid = objects.value("root").toString();
+    rootUuid.remove(0, rootUuid.startsWith(kReferencePrefix) ? int(qstrlen(kReferencePrefix)) : 0);
+
+    // Root collections are edited here and written back once
+    QHash<QString, QVariantMap> collections;
+    auto collection = [&](const QString &name) -> QVariantMap & {
+        auto it = collections.find(name);
+        if (it == collections.end())
+            it = collections.insert(name, objects.value(rootUuid).toMap().value(name).toMap());
+        return it.value();
+    };
+
+    qint64 sequence = checkpointSequence;
+    for (const QString &journalPath : journalPaths) {
+        QFile journal(journalPath);
+        if (!journal.exists())
+            continue;
+
+        if (!journal.open(QIODevice::ReadOnly)) {
+            result.error = QStringLiteral("Failed to open journal %1: %2")
+                               .arg(journalPath, journal.errorString());
+            return result;
+        }
+
+        while (!journal.atEnd()) {
+            const QByteArray line = journal.readLine().trimmed();
+            if (line.isEmpty())
+                continue;
+
+            const QJsonDocument recordDocument = QJsonDocument::fromJson(line, &parseError);
+            if (parseError.error != QJsonParseError::NoError || !recordDocument.isObject()) {
+                qWarning() << "JournalFile: Ignoring torn journal tail in" << journalPath;
+                break;
+            }
+
+            const QJsonObject record = recordDocument.object();
+            const qint64 recordSequence = record.value("seq").toInteger();
+            if (recordSequence <= checkpointSequence)
+                continue;
+
+            const QJsonArray ops = record.value("ops").toArray();
+            for (const QJsonValue &opValue : ops) {
+                const QJsonObject op = opValue.toObject();
+                const QString type = op.value("op").toString();
+                const QString uuid = op.value("uuid").toString();
+
+                if (type == "put") {
+                    objects.insert(uuid, op.value("props").toObject().toVariantMap());
+                    // A new root image carries its own collections
+                    if (uuid == rootUuid)
+                        collections.clear();
+                } else if (type == "drop") {
+                    objects.remove(uuid);
+                } else if (type == "insert") {
+                    collection(op.value("collection").toString()).insert(uuid, kReferencePrefix + uuid);
+                } else if (type == "erase") {
+                    collection(op.value("collection").toString()).remove(uuid);
+                }
+            }
+
+            sequence = qMax(sequence, recordSequence);
+            ++result.replayedRecords;
+        }
+    }
+
+    if (!collections.isEmpty()) {
+        QVariantMap root = objects.value(rootUuid).toMap();
+        for (auto it = collections.cbegin(); it != collections.cend(); ++it)
+            root.insert(it.key(), it.value());
+        objects.insert(rootUuid, root);
+    }
+
+    result.objects  = objects;
+    result.sequence = sequence;
+
+    return result;
+}
+
+/*!
+ * Back on the GUI thread, the old journal is obsolete once the checkpoint is written.
+ */
+void JournalFileCPP::onCheckpointFinished()
+{
+    emit busyChanged();
+
+    const CheckpointResult result = mCheckpointWatcher.result();
+    if (!result.error.isEmpty()) {
+        // The old journal is kept, recovery still finds all records
+        qWarning() << "JournalFile:" << result.error;
+        emit failed(result.error);
+        return;
+    }
+
+    QFile::remove(previousJournalPath());
+    emit checkpointWritten(result.sequence);
+}
+
+void JournalFileCPP::onRecoveryFinished()
+{
+    emit busyChanged();
+
+    const RecoveryResult result = mRecoveryWatcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << "JournalFile:" << result.error;
+        emit failed(result.error);
+        return;
+    }
+
+    mSequence = result.sequence;
+    emit journalChanged();
+    emit recovered(result.objects, result.replayedRecords);
+}
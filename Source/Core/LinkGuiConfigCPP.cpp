@@ -0,0 +1,113 @@
+#include "LinkGuiConfigCPP.h"
+#include "QSRepositoryCpp.h"
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor, the row is allocated in the detached store until _qsRepo is set
+ * ************************************************************************************************/
+LinkGuiConfigCPP::LinkGuiConfigCPP(QObject *parent)
+    : GuiConfigCPP{parent}
+    , mStore(GeometryStoreCPP::forRepo(nullptr))
+{
+    mRow = mStore->allocateLink(this);
+
+    connect(this, &QSObjectCpp::repoChanged, this, &LinkGuiConfigCPP::onRepoChanged);
+}
+
+LinkGuiConfigCPP::~LinkGuiConfigCPP()
+{
+    mStore->releaseLink(mRow);
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+GeometryStoreCPP *LinkGuiConfigCPP::store() const
+{
+    return mStore.get();
+}
+
+int LinkGuiConfigCPP::row() const
+{
+    return mRow;
+}
+
+QObject *LinkGuiConfigCPP::owner() const
+{
+    return mOwner;
+}
+
+void LinkGuiConfigCPP::setOwner(QObject *owner)
+{
+    if (mOwner == owner)
+        return;
+
+    mOwner = owner;
+    emit ownerChanged();
+}
+
+QString LinkGuiConfigCPP::color() const
+{
+    return mStore->mLinkColor.at(mRow);
+}
+
+void LinkGuiConfigCPP::setColor(const QString &color)
+{
+    if (mStore->mLinkColor.at(mRow) == color)
+        return;
+
+    mStore->mLinkColor[mRow] = color;
+    emit colorChanged();
+}
+
+int LinkGuiConfigCPP::style() const
+{
+    return mStore->mLinkStyle.at(mRow);
+}
+
+void LinkGuiConfigCPP::setStyle(int style)
+{
+    if (mStore->mLinkStyle.at(mRow) == style)
+        return;
+
+    mStore->mLinkStyle[mRow] = qint8(style);
+    emit styleChanged();
+}
+
+int LinkGuiConfigCPP::type() const
+{
+    return mStore->mLinkType.at(mRow);
+}
+
+void LinkGuiConfigCPP::setType(int type)
+{
+    if (mStore->mLinkType.at(mRow) == type)
+        return;
+
+    mStore->mLinkType[mRow] = qint8(type);
+    emit typeChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void LinkGuiConfigCPP::onRepoChanged()
+{
+    std::shared_ptr<GeometryStoreCPP> store = GeometryStoreCPP::forRepo(getRepo());
+    if (store == mStore)
+        return;
+
+    const int row = store->allocateLink(this);
+    store->mLinkColor[row] = mStore->mLinkColor.at(mRow);
+    store->mLinkStyle[row] = mStore->mLinkStyle.at(mRow);
+    store->mLinkType[row]  = mStore->mLinkType.at(mRow);
+    store->mLinkFlags[row] = mStore->mLinkFlags.at(mRow);
+
+    mStore->releaseLink(mRow);
+    mStore = store;
+    mRow   = row;
+}
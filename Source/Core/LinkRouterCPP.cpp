@@ -0,0 +1,935 @@
+#include "LinkRouterCPP.h"
+#include "NodeGuiConfigCPP.h"
+
+#include <QJSValue>
+#include <QMetaMethod>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+//! Side of the spatial index cells
+constexpr qreal  CellSize         = 256;
+
+//! Links whose bounds cover more cells are kept out of the grid and always checked
+constexpr int    MaxLinkCells     = 256;
+
+//! Length of the straight start of a route out of its port, and of the bezier handles
+constexpr qreal  StubLength       = 20;
+constexpr qreal  BezierHandle     = 100;
+
+//! Radius of the rounded corners of bezier routes
+constexpr qreal  CornerRadius     = 40;
+
+//! Cost of a bend, in scene units
+constexpr qreal  BendPenalty      = 40;
+
+//! Margin around the end points in which obstacles are considered
+constexpr qreal  SearchPadding    = 200;
+
+//! Obstacles (closest first) and grid points of one search
+constexpr int    MaxObstacles     = 48;
+constexpr int    MaxGridPoints    = 40000;
+
+constexpr int    FrameInterval    = 16;
+
+//! NLSpec.LinkType
+enum LinkType {
+    Bezier   = 0,
+    LLine    = 1,
+    Straight = 2
+};
+
+//! Search directions: +x, -x, +y, -y and none (start without port side)
+enum Direction {
+    PosX = 0,
+    NegX,
+    PosY,
+    NegY,
+    NoDirection
+};
+
+//! NLSpec.PortPositionSide: Top, Bottom, Left, Right
+QPointF sideVector(int side)
+{
+    switch (side) {
+    case 0:  return {  0, -1 };
+    case 1:  return {  0,  1 };
+    case 2:  return { -1,  0 };
+    case 3:  return {  1,  0 };
+    default: return {  0,  0 };
+    }
+}
+
+int sideDirection(int side)
+{
+    switch (side) {
+    case 0:  return NegY;
+    case 1:  return PosY;
+    case 2:  return NegX;
+    case 3:  return PosX;
+    default: return NoDirection;
+    }
+}
+
+int oppositeDirection(int direction)
+{
+    switch (direction) {
+    case PosX: return NegX;
+    case NegX: return PosX;
+    case PosY: return NegY;
+    case NegY: return PosY;
+    default:   return NoDirection;
+    }
+}
+
+bool samePoint(const QPointF &a, const QPointF &b)
+{
+    return std::abs(a.x() - b.x()) < 0.01 && std::abs(a.y() - b.y()) < 0.01;
+}
+
+QPointF cubicPoint(const QVector<QPointF> &curve, qreal t)
+{
+    const qreal u = 1 - t;
+    return u * u * u * curve.at(0) + 3 * u * u * t * curve.at(1) +
+           3 * u * t * t * curve.at(2) + t * t * t * curve.at(3);
+}
+
+//! Unlike QRectF::intersects, true for rectangles without area (the bounds of straight routes)
+bool overlaps(const QRectF &a, const QRectF &b)
+{
+    return a.left() <= b.right() && b.left() <= a.right() &&
+           a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+QRectF boundsOf(const QVector<QPointF> &points)
+{
+    if (points.isEmpty())
+        return {};
+
+    qreal left = points.first().x(), right = left;
+    qreal top  = points.first().y(), bottom = top;
+    for (const QPointF &point : points) {
+        left   = std::min(left,   point.x());
+        right  = std::max(right,  point.x());
+        top    = std::min(top,    point.y());
+        bottom = std::max(bottom, point.y());
+    }
+
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+//! Sorted coordinates without near duplicates
+void uniqueSorted(QVector<qreal> &values)
+{
+    std::sort(values.begin(), values.end());
+    auto last = std::unique(values.begin(), values.end(),
+                            [](qreal a, qreal b) { return std::abs(a - b) < 0.01; });
+    values.erase(last, values.end());
+}
+
+int indexOf(const QVector<qreal> &values, qreal value)
+{
+    auto it = std::lower_bound(values.cbegin(), values.cend(), value - 0.01);
+    return int(it - values.cbegin());
+}
+
+//! Nodes of a scene (map <UUID, node>)
+QVariantList sceneNodes(QObject *scene)
+{
+    QVariant value = scene->property("nodes");
+    if (value.metaType() == QMetaType::fromType<QJSValue>())
+        value = value.value<QJSValue>().toVariant();
+
+    return value.toMap().values();
+}
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+LinkRouterCPP::LinkRouterCPP(QObject *parent)
+    : QObject{parent}
+{
+    mSliceTimer.setSingleShot(true);
+    mSliceTimer.setInterval(FrameInterval);
+    connect(&mSliceTimer, &QTimer::timeout, this, &LinkRouterCPP::processPending);
+
+    attachStore();
+}
+
+LinkRouterCPP::~LinkRouterCPP()
+{
+    detachStore();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * A changed route is computed at once while the frame has budget left. Otherwise the link gets
+ * a route without obstacle avoidance for this frame and its final route later (routeChanged()).
+ */
+QVariantList LinkRouterCPP::route(QObject *link, const QVector2D &start, const QVector2D &end,
+                                  int type, int startSide, int endSide, int direction)
+{
+    if (!link)
+        return {};
+
+    beginFrame();
+
+    if (!mRoutes.contains(link))
+        connect(link, &QObject::destroyed, this, &LinkRouterCPP::onLinkDestroyed);
+
+    Route &route = mRoutes[link];
+    const bool changed = route.points.isEmpty() ||
+                         !samePoint(route.start, start.toPointF()) ||
+                         !samePoint(route.end, end.toPointF()) ||
+                         route.type != type || route.startSide != startSide ||
+                         route.endSide != endSide || route.direction != direction;
+
+    if (changed) {
+        route.start     = start.toPointF();
+        route.end       = end.toPointF();
+        route.type      = type;
+        route.startSide = startSide;
+        route.endSide   = endSide;
+        route.direction = direction;
+    }
+
+    if (changed || route.pending) {
+        if (hasBudget()) {
+            QElapsedTimer timer;
+            timer.start();
+            computeRoute(route, true);
+            mFrameSpentNs += timer.nsecsElapsed();
+            route.pending = false;
+        } else {
+            if (changed)
+                computeRoute(route, false);
+            enqueue(link, route);
+        }
+
+        storeRoute(link, route);
+    }
+
+    QVariantList points;
+    points.reserve(route.points.size());
+    for (const QPointF &point : std::as_const(route.points))
+        points.append(QVariant::fromValue(QVector2D(point)));
+
+    return points;
+}
+
+void LinkRouterCPP::invalidate(QObject *link)
+{
+    if (!link || !mRoutes.contains(link))
+        return;
+
+    disconnect(link, &QObject::destroyed, this, &LinkRouterCPP::onLinkDestroyed);
+    onLinkDestroyed(link);
+}
+
+void LinkRouterCPP::invalidateAll()
+{
+    for (auto it = mRoutes.begin(); it != mRoutes.end(); ++it)
+        enqueue(it.key(), it.value());
+}
+
+void LinkRouterCPP::addNodes(const QVariantList &nodes)
+{
+    if (!mScene)
+        return;
+
+    for (const QVariant &value : nodes) {
+        if (const QObject *node = value.value<QObject *>())
+            mSceneNodes.insert(node);
+    }
+
+    updateRows(nodes);
+}
+
+void LinkRouterCPP::removeNodes(const QVariantList &nodes)
+{
+    if (!mScene)
+        return;
+
+    for (const QVariant &value : nodes)
+        mSceneNodes.remove(value.value<QObject *>());
+
+    updateRows(nodes);
+}
+
+QObject *LinkRouterCPP::repo() const
+{
+    return mRepo;
+}
+
+void LinkRouterCPP::setRepo(QObject *repo)
+{
+    if (mRepo == repo)
+        return;
+
+    detachStore();
+    mRepo = repo;
+    attachStore();
+
+    invalidateAll();
+    emit repoChanged();
+}
+
+QObject *LinkRouterCPP::scene() const
+{
+    return mScene;
+}
+
+/*!
+ * The grid is rebuilt from the nodes of the new scene.
+ */
+void LinkRouterCPP::setScene(QObject *scene)
+{
+    if (mScene == scene)
+        return;
+
+    mScene = scene;
+    mSceneNodes.clear();
+    if (mScene) {
+        for (const QVariant &value : sceneNodes(mScene)) {
+            if (const QObject *node = value.value<QObject *>())
+                mSceneNodes.insert(node);
+        }
+    }
+
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (mStore->isNodeAlive(row) && isNodeHidden(row) == mIndexedNodes.contains(row))
+            onNodeChanged(row);
+    }
+
+    emit sceneChanged();
+}
+
+bool LinkRouterCPP::enabled() const
+{
+    return mEnabled;
+}
+
+void LinkRouterCPP::setEnabled(bool enabled)
+{
+    if (mEnabled == enabled)
+        return;
+
+    mEnabled = enabled;
+    emit enabledChanged();
+}
+
+qreal LinkRouterCPP::clearance() const
+{
+    return mClearance;
+}
+
+void LinkRouterCPP::setClearance(qreal clearance)
+{
+    if (qFuzzyCompare(mClearance, clearance))
+        return;
+
+    mClearance = clearance;
+    invalidateAll();
+    emit clearanceChanged();
+}
+
+int LinkRouterCPP::frameBudget() const
+{
+    return mFrameBudget;
+}
+
+void LinkRouterCPP::setFrameBudget(int frameBudget)
+{
+    if (mFrameBudget == frameBudget)
+        return;
+
+    mFrameBudget = frameBudget;
+    emit frameBudgetChanged();
+}
+
+int LinkRouterCPP::pendingCount() const
+{
+    return mPending.size();
+}
+
+QVariantMap LinkRouterCPP::hiddenNodes() const
+{
+    return mHiddenNodes;
+}
+
+/*!
+ * Only the rows whose state changed are moved into or out of the grid.
+ */
+void LinkRouterCPP::setHiddenNodes(const QVariantMap &hiddenNodes)
+{
+    if (mHiddenNodes == hiddenNodes)
+        return;
+
+    mHiddenNodes = hiddenNodes;
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (!mStore->isNodeAlive(row))
+            continue;
+
+        if (isNodeHidden(row) == mIndexedNodes.contains(row))
+            onNodeChanged(row);
+    }
+
+    emit hiddenNodesChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void LinkRouterCPP::onLinkDestroyed(QObject *link)
+{
+    const auto it = mRoutes.constFind(link);
+    if (it == mRoutes.constEnd())
+        return;
+
+    const QRect cells = it->cells;
+    if (cells.isNull()) {
+        mLargeLinks.remove(link);
+    } else {
+        for (int column = cells.left(); column <= cells.right(); ++column)
+            for (int row = cells.top(); row <= cells.bottom(); ++row)
+                mLinkCells[cellKey(column, row)].removeOne(link);
+    }
+
+    mRoutes.erase(it);
+    mPending.removeAll(link);
+}
+
+/*!
+ * The links are notified after their route is stored, a view reads it back with route().
+ */
+void LinkRouterCPP::processPending()
+{
+    beginFrame();
+
+    int processed = 0;
+    while (processed < mPending.size() && hasBudget()) {
+        QObject *link = mPending.at(processed++);
+        auto it = mRoutes.find(link);
+        if (it == mRoutes.end() || !it->pending)
+            continue;
+
+        QElapsedTimer timer;
+        timer.start();
+        computeRoute(*it, true);
+        mFrameSpentNs += timer.nsecsElapsed();
+
+        it->pending = false;
+        storeRoute(link, *it);
+
+        const int signalIndex = link->metaObject()->indexOfSignal("routeChanged()");
+        if (signalIndex >= 0)
+            link->metaObject()->method(signalIndex).invoke(link, Qt::DirectConnection);
+    }
+
+    mPending.remove(0, std::min(processed, int(mPending.size())));
+    if (!mPending.isEmpty())
+        mSliceTimer.start();
+
+    emit pendingCountChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+/*!
+ * The node grid is built from the alive rows, then follows the store through its observer.
+ */
+void LinkRouterCPP::attachStore()
+{
+    mStore = GeometryStoreCPP::forRepo(mRepo);
+    mObserverId = mStore->addNodeObserver([this](int row) { onNodeChanged(row); });
+
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (mStore->isNodeAlive(row))
+            onNodeChanged(row);
+    }
+}
+
+void LinkRouterCPP::detachStore()
+{
+    if (mStore && mObserverId >= 0)
+        mStore->removeNodeObserver(mObserverId);
+
+    mObserverId = -1;
+    mNodeCells.clear();
+    mIndexedNodes.clear();
+}
+
+void LinkRouterCPP::onNodeChanged(int row)
+{
+    const QRectF oldRect = mIndexedNodes.take(row);
+    if (!oldRect.isNull()) {
+        const QRect cells = cellsOf(oldRect);
+        for (int column = cells.left(); column <= cells.right(); ++column)
+            for (int cellRow = cells.top(); cellRow <= cells.bottom(); ++cellRow)
+                mNodeCells[cellKey(column, cellRow)].removeOne(row);
+    }
+
+    QRectF newRect;
+    if (row < mStore->nodeRowCount() && mStore->isNodeAlive(row) && !isNodeHidden(row))
+        newRect = mStore->nodeRect(row);
+
+    if (newRect.width() > 0 && newRect.height() > 0) {
+        const QRect cells = cellsOf(newRect);
+        for (int column = cells.left(); column <= cells.right(); ++column)
+            for (int cellRow = cells.top(); cellRow <= cells.bottom(); ++cellRow)
+                mNodeCells[cellKey(column, cellRow)].append(row);
+        mIndexedNodes.insert(row, newRect);
+    }
+
+    invalidateRegion(oldRect);
+    invalidateRegion(newRect);
+}
+
+bool LinkRouterCPP::isNodeHidden(int row) const
+{
+    const QObject *owner = mStore->nodeOwner(row);
+    if (mScene && !mSceneNodes.contains(owner))
+        return true;
+
+    if (mHiddenNodes.isEmpty())
+        return false;
+
+    return owner && mHiddenNodes.contains(owner->property("_qsUuid").toString());
+}
+
+int LinkRouterCPP::rowOf(QObject *node) const
+{
+    if (!node)
+        return -1;
+
+    const auto *guiConfig = qobject_cast<NodeGuiConfigCPP *>(
+            node->property("guiConfig").value<QObject *>());
+    if (!guiConfig || guiConfig->store() != mStore.get())
+        return -1;
+
+    const int row = guiConfig->row();
+    return row >= 0 && row < mStore->nodeRowCount() && mStore->nodeOwner(row) == node ? row : -1;
+}
+
+void LinkRouterCPP::updateRows(const QVariantList &nodes)
+{
+    for (const QVariant &value : nodes) {
+        const int row = rowOf(value.value<QObject *>());
+        if (row >= 0 && mStore->isNodeAlive(row) && isNodeHidden(row) == mIndexedNodes.contains(row))
+            onNodeChanged(row);
+    }
+}
+
+void LinkRouterCPP::beginFrame()
+{
+    if (!mFrameClock.isValid() || mFrameClock.elapsed() >= FrameInterval) {
+        mFrameClock.start();
+        mFrameSpentNs = 0;
+    }
+}
+
+bool LinkRouterCPP::hasBudget() const
+{
+    return mFrameSpentNs < qint64(mFrameBudget) * 1000000;
+}
+
+void LinkRouterCPP::computeRoute(Route &route, bool avoidObstacles) const
+{
+    const QPointF start = route.start;
+    const QPointF end   = route.end;
+    const QPointF startVector = sideVector(route.startSide);
+    const QPointF endVector   = sideVector(route.endSide);
+
+    if (route.type == Straight) {
+        // Same points as BasicLinkCalculator.straightLineControlPoints
+        const QPointF correctedStart = start + startVector * BezierHandle * (route.direction == 2 ? 0.1 : 0);
+        const QPointF correctedEnd   = end + endVector * BezierHandle * (route.direction == 0 ? 0 : 0.1);
+        route.points = { start, correctedStart, correctedEnd, end };
+        return;
+    }
+
+    const QPointF startStub = start + startVector * std::max(StubLength, 2 * mClearance);
+    const QPointF endStub   = end + endVector * std::max(StubLength, 2 * mClearance);
+    const QRectF  region    = QRectF(startStub, endStub).normalized()
+                                 .adjusted(-SearchPadding, -SearchPadding, SearchPadding, SearchPadding);
+
+    QVector<QRectF> obstacles;
+    if (avoidObstacles) {
+        obstacles = obstaclesIn(region);
+
+        // Overlapping nodes must not block the ports
+        obstacles.erase(std::remove_if(obstacles.begin(), obstacles.end(), [&](const QRectF &rect) {
+            return rect.adjusted(0.01, 0.01, -0.01, -0.01).contains(startStub) ||
+                   rect.adjusted(0.01, 0.01, -0.01, -0.01).contains(endStub);
+        }), obstacles.end());
+    }
+
+    if (route.type != LLine) {
+        const QVector<QPointF> curve = { start, start + startVector * BezierHandle,
+                                         end + endVector * BezierHandle, end };
+        if (obstacles.isEmpty() || !curveIntersects(curve, obstacles)) {
+            route.points = curve;
+            return;
+        }
+    }
+
+    QVector<QPointF> path = orthogonalPath(startStub, sideDirection(route.startSide),
+                                           endStub, oppositeDirection(sideDirection(route.endSide)),
+                                           obstacles, region);
+    if (path.isEmpty())
+        path = { startStub, QPointF(endStub.x(), startStub.y()), endStub };
+
+    path.prepend(start);
+    path.append(end);
+    path = simplified(path);
+
+    route.points = route.type == LLine ? path : roundedBezier(path);
+}
+
+void LinkRouterCPP::storeRoute(QObject *link, Route &route)
+{
+    QRectF bounds = boundsOf(route.points);
+    bounds |= QRectF(route.start, route.end).normalized();
+
+    const QRect cells = cellsOf(bounds);
+    const bool  large = qint64(cells.width()) * cells.height() > MaxLinkCells;
+    const QRect newCells = large ? QRect() : cells;
+
+    route.bounds = bounds;
+    if (newCells == route.cells && (large == mLargeLinks.contains(link)))
+        return;
+
+    if (route.cells.isNull()) {
+        mLargeLinks.remove(link);
+    } else {
+        for (int column = route.cells.left(); column <= route.cells.right(); ++column)
+            for (int row = route.cells.top(); row <= route.cells.bottom(); ++row)
+                mLinkCells[cellKey(column, row)].removeOne(link);
+    }
+
+    route.cells = newCells;
+    if (large) {
+        mLargeLinks.insert(link);
+    } else {
+        for (int column = newCells.left(); column <= newCells.right(); ++column)
+            for (int row = newCells.top(); row <= newCells.bottom(); ++row)
+                mLinkCells[cellKey(column, row)].append(link);
+    }
+}
+
+void LinkRouterCPP::enqueue(QObject *link, Route &route)
+{
+    if (route.pending)
+        return;
+
+    route.pending = true;
+    mPending.append(link);
+
+    if (!mSliceTimer.isActive())
+        mSliceTimer.start();
+
+    emit pendingCountChanged();
+}
+
+void LinkRouterCPP::invalidateRegion(const QRectF &region)
+{
+    if (region.isNull())
+        return;
+
+    const QRectF grown = region.adjusted(-mClearance, -mClearance, mClearance, mClearance);
+
+    QSet<QObject *> links = mLargeLinks;
+    const QRect cells = cellsOf(grown);
+    for (int column = cells.left(); column <= cells.right(); ++column) {
+        for (int row = cells.top(); row <= cells.bottom(); ++row) {
+            const auto cell = mLinkCells.constFind(cellKey(column, row));
+            if (cell == mLinkCells.constEnd())
+                continue;
+
+            for (QObject *link : *cell)
+                links.insert(link);
+        }
+    }
+
+    for (QObject *link : std::as_const(links)) {
+        auto it = mRoutes.find(link);
+        if (it != mRoutes.end() && overlaps(it->bounds, grown))
+            enqueue(link, *it);
+    }
+}
+
+QVector<QRectF> LinkRouterCPP::obstaclesIn(const QRectF &region) const
+{
+    QSet<int> rows;
+    const QRect cells = cellsOf(region);
+    for (int column = cells.left(); column <= cells.right(); ++column) {
+        for (int row = cells.top(); row <= cells.bottom(); ++row) {
+            const auto cell = mNodeCells.constFind(cellKey(column, row));
+            if (cell != mNodeCells.constEnd())
+                rows.unite(QSet<int>(cell->cbegin(), cell->cend()));
+        }
+    }
+
+    QVector<QRectF> obstacles;
+    for (int row : std::as_const(rows)) {
+        const QRectF rect = mIndexedNodes.value(row)
+                                .adjusted(-mClearance, -mClearance, mClearance, mClearance);
+        if (rect.intersects(region))
+            obstacles.append(rect);
+    }
+
+    if (obstacles.size() > MaxObstacles) {
+        const QPointF center = region.center();
+        auto distance = [&center](const QRectF &rect) {
+            const QPointF delta = rect.center() - center;
+            return QPointF::dotProduct(delta, delta);
+        };
+        std::nth_element(obstacles.begin(), obstacles.begin() + MaxObstacles, obstacles.end(),
+                         [&](const QRectF &a, const QRectF &b) { return distance(a) < distance(b); });
+        obstacles.resize(MaxObstacles);
+    }
+
+    return obstacles;
+}
+
+/*!
+ * A* over the points where the lines through the obstacle edges, the region edges and the two
+ * stubs cross. Segments between neighbouring points either cross an obstacle completely or not
+ * at all, so blocking is a range fill per obstacle. The state is (point, direction of arrival)
+ * to charge the bends.
+ */
+QVector<QPointF> LinkRouterCPP::orthogonalPath(const QPointF &from, int fromDirection,
+                                               const QPointF &to, int toDirection,
+                                               const QVector<QRectF> &obstacles,
+                                               const QRectF &region) const
+{
+    QVector<qreal> xs = { from.x(), to.x(), region.left(), region.right() };
+    QVector<qreal> ys = { from.y(), to.y(), region.top(),  region.bottom() };
+    for (const QRectF &rect : obstacles) {
+        xs << rect.left() << rect.right();
+        ys << rect.top()  << rect.bottom();
+    }
+    uniqueSorted(xs);
+    uniqueSorted(ys);
+
+    const int columns = xs.size();
+    const int rows    = ys.size();
+    if (columns * rows > MaxGridPoints)
+        return {};
+
+    // Blocked segments: horizontal from (i, j) to (i + 1, j), vertical from (i, j) to (i, j + 1)
+    QVector<bool> horizontalBlocked(columns * rows, false);
+    QVector<bool> verticalBlocked(columns * rows, false);
+    for (const QRectF &rect : obstacles) {
+        const int left   = indexOf(xs, rect.left());
+        const int right  = indexOf(xs, rect.right());
+        const int top    = indexOf(ys, rect.top());
+        const int bottom = indexOf(ys, rect.bottom());
+
+        for (int j = top + 1; j < bottom; ++j)
+            for (int i = left; i < right; ++i)
+                horizontalBlocked[j * columns + i] = true;
+
+        for (int i = left + 1; i < right; ++i)
+            for (int j = top; j < bottom; ++j)
+                verticalBlocked[j * columns + i] = true;
+    }
+
+    const int fromPoint = indexOf(ys, from.y()) * columns + indexOf(xs, from.x());
+    const int toColumn  = indexOf(xs, to.x());
+    const int toRow     = indexOf(ys, to.y());
+    const int toPoint   = toRow * columns + toColumn;
+
+    constexpr int DirectionCount = NoDirection + 1;
+    constexpr qreal Infinity     = std::numeric_limits<qreal>::infinity();
+
+    QVector<qreal> costs(columns * rows * DirectionCount, Infinity);
+    QVector<int>   parents(columns * rows * DirectionCount, -1);
+
+    auto heuristic = [&](int point) {
+        return std::abs(xs.at(point % columns) - to.x()) + std::abs(ys.at(point / columns) - to.y());
+    };
+
+    using Entry = std::pair<qreal, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    const int startState = fromPoint * DirectionCount + fromDirection;
+    costs[startState] = 0;
+    open.push({ heuristic(fromPoint), startState });
+
+    qreal bestCost  = Infinity;
+    int   bestState = -1;
+
+    while (!open.empty() && open.top().first < bestCost) {
+        const auto [estimate, state] = open.top();
+        open.pop();
+
+        const int   point     = state / DirectionCount;
+        const int   direction = state % DirectionCount;
+        const qreal cost      = costs.at(state);
+        if (estimate > cost + heuristic(point) + 1e-6)
+            continue;
+
+        if (point == toPoint) {
+            const qreal total = cost + (toDirection == NoDirection || direction == toDirection
+                                            ? 0 : BendPenalty);
+            if (total < bestCost) {
+                bestCost  = total;
+                bestState = state;
+            }
+            continue;
+        }
+
+        const int i = point % columns;
+        const int j = point / columns;
+        for (int next = PosX; next < NoDirection; ++next) {
+            if (direction != NoDirection && next == oppositeDirection(direction))
+                continue;
+
+            int nextPoint = -1;
+            switch (next) {
+            case PosX:
+                if (i + 1 < columns && !horizontalBlocked.at(point))
+                    nextPoint = point + 1;
+                break;
+            case NegX:
+                if (i > 0 && !horizontalBlocked.at(point - 1))
+                    nextPoint = point - 1;
+                break;
+            case PosY:
+                if (j + 1 < rows && !verticalBlocked.at(point))
+                    nextPoint = point + columns;
+                break;
+            case NegY:
+                if (j > 0 && !verticalBlocked.at(point - columns))
+                    nextPoint = point - columns;
+                break;
+            }
+
+            if (nextPoint < 0)
+                continue;
+
+            const qreal length = std::abs(xs.at(nextPoint % columns) - xs.at(i)) +
+                                 std::abs(ys.at(nextPoint / columns) - ys.at(j));
+            const qreal nextCost = cost + length +
+                                   (direction != NoDirection && next != direction ? BendPenalty : 0);
+
+            const int nextState = nextPoint * DirectionCount + next;
+            if (nextCost < costs.at(nextState)) {
+                costs[nextState]   = nextCost;
+                parents[nextState] = state;
+                open.push({ nextCost + heuristic(nextPoint), nextState });
+            }
+        }
+    }
+
+    if (bestState < 0)
+        return {};
+
+    QVector<QPointF> path;
+    for (int state = bestState; state >= 0; state = parents.at(state)) {
+        const int point = state / DirectionCount;
+        path.prepend(QPointF(xs.at(point % columns), ys.at(point / columns)));
+    }
+
+    return simplified(path);
+}
+
+/*!
+ * Removes repeated points and the middle points of straight runs.
+ */
+QVector<QPointF> LinkRouterCPP::simplified(const QVector<QPointF> &points)
+{
+    QVector<QPointF> result;
+    for (const QPointF &point : points) {
+        if (!result.isEmpty() && samePoint(result.last(), point))
+            continue;
+
+        if (result.size() >= 2) {
+            const QPointF &a = result.at(result.size() - 2);
+            const QPointF &b = result.last();
+            const bool vertical   = std::abs(a.x() - b.x()) < 0.01 && std::abs(b.x() - point.x()) < 0.01;
+            const bool horizontal = std::abs(a.y() - b.y()) < 0.01 && std::abs(b.y() - point.y()) < 0.01;
+            if (vertical || horizontal)
+                result.removeLast();
+        }
+
+        result.append(point);
+    }
+
+    return result;
+}
+
+/*!
+ * Cubic segments (3n + 1 points) along a polyline: straight runs, and a quadratic arc around
+ * every corner.
+ */
+QVector<QPointF> LinkRouterCPP::roundedBezier(const QVector<QPointF> &points)
+{
+    auto appendLine = [](QVector<QPointF> &curve, const QPointF &to) {
+        const QPointF from = curve.last();
+        if (!samePoint(from, to))
+            curve << from + (to - from) / 3 << from + (to - from) * 2 / 3 << to;
+    };
+
+    QVector<QPointF> curve = { points.first() };
+    for (int index = 1; index < points.size() - 1; ++index) {
+        const QPointF &corner = points.at(index);
+        const QPointF  in     = points.at(index - 1) - corner;
+        const QPointF  out    = points.at(index + 1) - corner;
+        const qreal    inLength  = std::hypot(in.x(), in.y());
+        const qreal    outLength = std::hypot(out.x(), out.y());
+        const qreal    radius = std::min({ CornerRadius, inLength / 2, outLength / 2 });
+
+        const QPointF arcStart = corner + in / inLength * radius;
+        const QPointF arcEnd   = corner + out / outLength * radius;
+
+        appendLine(curve, arcStart);
+        curve << arcStart + (corner - arcStart) * 2 / 3 << arcEnd + (corner - arcEnd) * 2 / 3 << arcEnd;
+    }
+    appendLine(curve, points.last());
+
+    return curve;
+}
+
+/*!
+ * The ends of the curve are skipped, they start inside the grown rectangles of their nodes.
+ */
+bool LinkRouterCPP::curveIntersects(const QVector<QPointF> &curve, const QVector<QRectF> &obstacles)
+{
+    constexpr int Samples = 32;
+    for (int sample = 3; sample <= Samples - 3; ++sample) {
+        const QPointF point = cubicPoint(curve, qreal(sample) / Samples);
+        for (const QRectF &rect : obstacles) {
+            if (rect.adjusted(0.01, 0.01, -0.01, -0.01).contains(point))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+QRect LinkRouterCPP::cellsOf(const QRectF &rect) const
+{
+    return QRect(QPoint(int(std::floor(rect.left() / CellSize)), int(std::floor(rect.top() / CellSize))),
+                 QPoint(int(std::floor(rect.right() / CellSize)), int(std::floor(rect.bottom() / CellSize))));
+}
+
+quint64 LinkRouterCPP::cellKey(int column, int row)
+{
+    return (quint64(quint32(column)) << 32) | quint32(row);
+}
@@ -0,0 +1,324 @@
+#include "MemoryStatsCPP.h"
+
+#include <QFile>
+#include <QImage>
+#include <QJSValue>
+#include <QMetaProperty>
+#include <QRegularExpression>
+
+#ifdef NODELINK_QML_PRIVATE
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+//! Rough cost of a QML object (QObject, its private data and the QML data) and of a property
+constexpr qint64 ObjectBaseBytes  = 256;
+constexpr qint64 PropertyBytes    = 16;
+
+//! Nested lists and maps are followed up to this depth
+constexpr int    MaxValueDepth    = 8;
+
+//! Categories of the scene objects, in report order
+enum CategoryIndex {
+    Nodes = 0,
+    Ports,
+    NodeGuiConfigs,
+    ImagesModels,
+    NodeData,
+    Links,
+    LinkGuiConfigs,
+    Containers,
+    ContainerGuiConfigs,
+    CategoryCount
+};
+
+const char *const CategoryNames[CategoryCount] = {
+    "nodes", "ports", "nodeGuiConfigs", "imagesModels", "nodeData",
+    "links", "linkGuiConfigs", "containers", "containerGuiConfigs"
+};
+
+QObject *objectProperty(QObject *object, const char *name)
+{
+    return object ? object->property(name).value<QObject *>() : nullptr;
+}
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+MemoryStatsCPP::MemoryStatsCPP(QObject *parent)
+    : QObject{parent}
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+QVariantMap MemoryStatsCPP::collect() const
+{
+    QVariantMap stats = collectObjects();
+    stats.insert("jsHeap",  collectJsHeap());
+    stats.insert("view",    collectView());
+    stats.insert("process", collectProcess());
+
+    return stats;
+}
+
+qint64 MemoryStatsCPP::estimateObjectBytes(QObject *object) const
+{
+    if (!object)
+        return 0;
+
+    const QMetaObject *meta = object->metaObject();
+    qint64 bytes = ObjectBaseBytes;
+    for (int index = QObject::staticMetaObject.propertyCount(); index < meta->propertyCount(); ++index) {
+        const QMetaProperty property = meta->property(index);
+        bytes += PropertyBytes;
+
+        // Referenced objects are counted in their own category
+        if (property.metaType().flags() & QMetaType::PointerToQObject)
+            continue;
+
+        bytes += estimateValueBytes(property.read(object), 0);
+    }
+
+    return bytes;
+}
+
+QObject *MemoryStatsCPP::target() const
+{
+    return mTarget;
+}
+
+void MemoryStatsCPP::setTarget(QObject *target)
+{
+    if (mTarget == target)
+        return;
+
+    mTarget = target;
+    emit targetChanged();
+}
+
+QQuickItem *MemoryStatsCPP::view() const
+{
+    return mView;
+}
+
+void MemoryStatsCPP::setView(QQuickItem *view)
+{
+    if (mView == view)
+        return;
+
+    mView = view;
+    emit viewChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+void MemoryStatsCPP::addObject(Category &category, QObject *object)
+{
+    if (!object)
+        return;
+
+    if (object->property("isSharedDefault").toBool())
+        ++category.sharedRefs[object];
+
+    category.objects.insert(object);
+}
+
+QObjectList MemoryStatsCPP::objectsOf(const QVariant &value)
+{
+    QVariant container = value;
+    if (container.metaType() == QMetaType::fromType<QJSValue>())
+        container = container.value<QJSValue>().toVariant();
+
+    QObjectList objects;
+    const QVariantList values = container.typeId() == QMetaType::QVariantMap
+                                    ? container.toMap().values()
+                                    : container.toList();
+    for (const QVariant &item : values) {
+        if (QObject *object = item.value<QObject *>())
+            objects.append(object);
+    }
+
+    return objects;
+}
+
+qint64 MemoryStatsCPP::estimateValueBytes(const QVariant &value, int depth) const
+{
+    if (depth > MaxValueDepth)
+        return 0;
+
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return value.toString().size() * qint64(sizeof(QChar));
+    case QMetaType::QByteArray:
+        return value.toByteArray().size();
+    case QMetaType::QImage:
+        return value.value<QImage>().sizeInBytes();
+    case QMetaType::QVariantList: {
+        qint64 bytes = 0;
+        for (const QVariant &item : value.toList())
+            bytes += PropertyBytes + estimateValueBytes(item, depth + 1);
+        return bytes;
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        qint64 bytes = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            bytes += PropertyBytes + it.key().size() * qint64(sizeof(QChar)) +
+                     estimateValueBytes(it.value(), depth + 1);
+        return bytes;
+    }
+    default:
+        break;
+    }
+
+    if (value.metaType() == QMetaType::fromType<QJSValue>()) {
+        const QJSValue jsValue = value.value<QJSValue>();
+        // Maps of objects (nodes, ports ...) hold references only
+        if (jsValue.isQObject())
+            return 0;
+        return estimateValueBytes(jsValue.toVariant(), depth);
+    }
+
+    return 0;
+}
+
+QVariantMap MemoryStatsCPP::collectObjects() const
+{
+    Category categories[CategoryCount];
+
+    if (mTarget) {
+        for (QObject *node : objectsOf(mTarget->property("nodes"))) {
+            addObject(categories[Nodes],          node);
+            addObject(categories[NodeGuiConfigs], objectProperty(node, "guiConfig"));
+            addObject(categories[ImagesModels],   objectProperty(node, "imagesModel"));
+            addObject(categories[NodeData],       objectProperty(node, "nodeData"));
+
+            for (QObject *port : objectsOf(node->property("ports")))
+                addObject(categories[Ports], port);
+        }
+
+        for (QObject *link : objectsOf(mTarget->property("links"))) {
+            addObject(categories[Links],          link);
+            addObject(categories[LinkGuiConfigs], objectProperty(link, "guiConfig"));
+        }
+
+        for (QObject *container : objectsOf(mTarget->property("containers"))) {
+            addObject(categories[Containers],          container);
+            addObject(categories[ContainerGuiConfigs], objectProperty(container, "guiConfig"));
+        }
+    }
+
+    QVariantMap objects;
+    int    objectCount = 0;
+    qint64 objectBytes = 0;
+    qint64 savedBytes  = 0;
+    for (int index = 0; index < CategoryCount; ++index) {
+        const Category &category = categories[index];
+
+        qint64 bytes = 0;
+        for (QObject *object : category.objects)
+            bytes += estimateObjectBytes(object);
+
+        // Without sharing, every reference but the first would own a copy of the instance
+        int    sharedRefs    = 0;
+        qint64 categorySaved = 0;
+        for (auto it = category.sharedRefs.cbegin(); it != category.sharedRefs.cend(); ++it) {
+            sharedRefs    += it.value();
+            categorySaved += (it.value() - 1) * estimateObjectBytes(it.key());
+        }
+
+        objects.insert(CategoryNames[index], QVariantMap{
+                           { "count",      category.objects.size() },
+                           { "bytes",      bytes },
+                           { "sharedRefs", sharedRefs },
+                           { "savedBytes", categorySaved } });
+
+        objectCount += category.objects.size();
+        objectBytes += bytes;
+        savedBytes  += categorySaved;
+    }
+
+    return { { "objects",     objects },
+             { "objectCount", objectCount },
+             { "objectBytes", objectBytes },
+             { "savedBytes",  savedBytes } };
+}
+
+/*!
+ * The JS heap figures need the private API of QtQml (NODELINK_QML_PRIVATE).
+ */
+QVariantMap MemoryStatsCPP::collectJsHeap() const
+{
+    qint64 used      = -1;
+    qint64 allocated = -1;
+
+#ifdef NODELINK_QML_PRIVATE
+    const QQmlEngine *engine = qmlEngine(this);
+    if (engine && engine->handle() && engine->handle()->memoryManager) {
+        const QV4::MemoryManager *memoryManager = engine->handle()->memoryManager;
+        used      = qint64(memoryManager->getUsedMem() + memoryManager->getLargeItemsMem());
+        allocated = qint64(memoryManager->getAllocatedMem() + memoryManager->getLargeItemsMem());
+    }
+#endif
+
+    return { { "used", used }, { "allocated", allocated } };
+}
+
+QVariantMap MemoryStatsCPP::collectView() const
+{
+    if (!mView)
+        return { { "itemCount", -1 }, { "types", QVariantMap() } };
+
+    // QML types are reported without the suffix of the generated class (NodeView_QMLTYPE_12)
+    static const QRegularExpression generatedSuffix(QStringLiteral("_QML(TYPE)?_\\d+$"));
+
+    QHash<QString, int> typeCounts;
+    int itemCount = 0;
+
+    QList<QQuickItem *> pending = mView->childItems();
+    while (!pending.isEmpty()) {
+        QQuickItem *item = pending.takeLast();
+        ++itemCount;
+        ++typeCounts[QString::fromLatin1(item->metaObject()->className()).remove(generatedSuffix)];
+        pending.append(item->childItems());
+    }
+
+    QVariantMap types;
+    for (auto it = typeCounts.cbegin(); it != typeCounts.cend(); ++it)
+        types.insert(it.key(), it.value());
+
+    return { { "itemCount", itemCount }, { "types", types } };
+}
+
+/*!
+ * The resident set size is read from /proc on Linux, it is -1 elsewhere.
+ */
+QVariantMap MemoryStatsCPP::collectProcess()
+{
+    qint64 rss = -1;
+
+#if defined(Q_OS_LINUX)
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1)
+            rss = fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+    }
+#endif
+
+    return { { "rss", rss } };
+}
@@ -0,0 +1,156 @@
+#include "NodeGuiConfigCPP.h"
+#include "QSRepositoryCpp.h"
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor, the row is allocated in the detached store until _qsRepo is set
+ * ************************************************************************************************/
+NodeGuiConfigCPP::NodeGuiConfigCPP(QObject *parent)
+    : GuiConfigCPP{parent}
+    , mStore(GeometryStoreCPP::forRepo(nullptr))
+{
+    mRow = mStore->allocateNode(this);
+
+    connect(this, &QSObjectCpp::repoChanged, this, &NodeGuiConfigCPP::onRepoChanged);
+}
+
+NodeGuiConfigCPP::~NodeGuiConfigCPP()
+{
+    mStore->releaseNode(mRow);
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+GeometryStoreCPP *NodeGuiConfigCPP::store() const
+{
+    return mStore.get();
+}
+
+int NodeGuiConfigCPP::row() const
+{
+    return mRow;
+}
+
+QObject *NodeGuiConfigCPP::owner() const
+{
+    return mOwner;
+}
+
+void NodeGuiConfigCPP::setOwner(QObject *owner)
+{
+    if (mOwner == owner)
+        return;
+
+    mOwner = owner;
+
+    // Observers filter the rows by their owner (e.g. LinkRouterCPP)
+    mStore->notifyNodeObservers(mRow);
+    emit ownerChanged();
+}
+
+QVector2D NodeGuiConfigCPP::position() const
+{
+    return QVector2D(mStore->mNodeX.at(mRow), mStore->mNodeY.at(mRow));
+}
+
+void NodeGuiConfigCPP::setPosition(const QVector2D &position)
+{
+    mStore->setNodePosition(mRow, position.x(), position.y());
+}
+
+int NodeGuiConfigCPP::width() const
+{
+    return mStore->mNodeWidth.at(mRow);
+}
+
+void NodeGuiConfigCPP::setWidth(int width)
+{
+    mStore->setNodeSize(mRow, width, mStore->mNodeHeight.at(mRow));
+}
+
+int NodeGuiConfigCPP::height() const
+{
+    return mStore->mNodeHeight.at(mRow);
+}
+
+void NodeGuiConfigCPP::setHeight(int height)
+{
+    mStore->setNodeSize(mRow, mStore->mNodeWidth.at(mRow), height);
+}
+
+QString NodeGuiConfigCPP::color() const
+{
+    return mStore->mNodeColor.at(mRow);
+}
+
+void NodeGuiConfigCPP::setColor(const QString &color)
+{
+    if (mStore->mNodeColor.at(mRow) == color)
+        return;
+
+    mStore->mNodeColor[mRow] = color;
+    emit colorChanged();
+}
+
+qreal NodeGuiConfigCPP::opacity() const
+{
+    return mStore->mNodeOpacity.at(mRow);
+}
+
+void NodeGuiConfigCPP::setOpacity(qreal opacity)
+{
+    // Kept as qreal, so a saved scene keeps the exact value
+    if (mStore->mNodeOpacity.at(mRow) == opacity)
+        return;
+
+    mStore->mNodeOpacity[mRow] = opacity;
+    emit opacityChanged();
+}
+
+bool NodeGuiConfigCPP::locked() const
+{
+    return mStore->mNodeFlags.at(mRow) & GeometryStoreCPP::Locked;
+}
+
+void NodeGuiConfigCPP::setLocked(bool locked)
+{
+    if (this->locked() == locked)
+        return;
+
+    if (locked)
+        mStore->mNodeFlags[mRow] |= GeometryStoreCPP::Locked;
+    else
+        mStore->mNodeFlags[mRow] &= ~GeometryStoreCPP::Locked;
+
+    emit lockedChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void NodeGuiConfigCPP::onRepoChanged()
+{
+    std::shared_ptr<GeometryStoreCPP> store = GeometryStoreCPP::forRepo(getRepo());
+    if (store == mStore)
+        return;
+
+    const int row = store->allocateNode(this);
+    store->mNodeX[row]       = mStore->mNodeX.at(mRow);
+    store->mNodeY[row]       = mStore->mNodeY.at(mRow);
+    store->mNodeWidth[row]   = mStore->mNodeWidth.at(mRow);
+    store->mNodeHeight[row]  = mStore->mNodeHeight.at(mRow);
+    store->mNodeColor[row]   = mStore->mNodeColor.at(mRow);
+    store->mNodeOpacity[row] = mStore->mNodeOpacity.at(mRow);
+    store->mNodeFlags[row]   = mStore->mNodeFlags.at(mRow);
+
+    mStore->releaseNode(mRow);
+    mStore = store;
+    mRow   = row;
+
+    mStore->notifyNodeObservers(mRow);
+}
@@ -0,0 +1,248 @@
+#include "NodeIndexCPP.h"
+#include "HandleRegistryCPP.h"
+
+#include <QMetaMethod>
+#include <QMetaProperty>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+NodeIndexCPP::NodeIndexCPP(QObject *parent)
+    : QObject{parent}
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+void NodeIndexCPP::insert(QObject *node)
+{
+    if (!node || mEntries.contains(node))
+        return;
+
+    Entry entry;
+    entry.handle      = HandleRegistryCPP::intern(node->property("_qsUuid").toString());
+    entry.type        = node->property("type").toInt();
+    entry.foldedTitle = node->property("title").toString().toCaseFolded();
+    entry.row         = mRowNodes.size();
+
+    mRowTitles.append(entry.foldedTitle);
+    mRowTypes.append(entry.type);
+    mRowHandles.append(entry.handle);
+    mRowNodes.append(node);
+
+    mSortedTitles.insert({ entry.foldedTitle, entry.handle });
+    ++mTypeCounts[entry.type];
+    mEntries.insert(node, entry);
+
+    watchProperty(node, "title", "onTitleChanged()");
+    watchProperty(node, "type",  "onTypeChanged()");
+    connect(node, &QObject::destroyed, this, &NodeIndexCPP::onNodeDestroyed, Qt::UniqueConnection);
+
+    emit countChanged();
+}
+
+void NodeIndexCPP::insertAll(const QVariantList &nodes)
+{
+    for (const QVariant &node : nodes)
+        insert(node.value<QObject *>());
+}
+
+void NodeIndexCPP::remove(QObject *node)
+{
+    if (!node || !mEntries.contains(node))
+        return;
+
+    disconnect(node, nullptr, this, nullptr);
+    removeEntry(node);
+}
+
+void NodeIndexCPP::removeAll(const QVariantList &nodes)
+{
+    for (const QVariant &node : nodes)
+        remove(node.value<QObject *>());
+}
+
+void NodeIndexCPP::clear()
+{
+    for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+        disconnect(it.key(), nullptr, this, nullptr);
+
+    mEntries.clear();
+    mSortedTitles.clear();
+    mRowTitles.clear();
+    mRowTypes.clear();
+    mRowHandles.clear();
+    mRowNodes.clear();
+    mTypeCounts.clear();
+
+    emit countChanged();
+}
+
+int NodeIndexCPP::typeCount(int type) const
+{
+    return mTypeCounts.value(type, 0);
+}
+
+/*!
+ * The results are sorted by title.
+ */
+QVariantMap NodeIndexCPP::findByPrefix(const QString &text, int offset, int limit) const
+{
+    const QString prefix = text.toCaseFolded();
+
+    QVariantList handles;
+    int total = 0;
+    for (auto it = mSortedTitles.lower_bound({ prefix, 0 });
+         it != mSortedTitles.end() && it->first.startsWith(prefix); ++it) {
+        if (total >= offset && (limit < 0 || handles.size() < limit))
+            handles.append(it->second);
+        ++total;
+    }
+
+    return { { "total", total }, { "offset", offset }, { "handles", handles } };
+}
+
+/*!
+ * The results are in insertion order, except for rows moved by removals.
+ */
+QVariantMap NodeIndexCPP::findBySubstring(const QString &text, int offset, int limit) const
+{
+    const QString needle = text.toCaseFolded();
+
+    QVariantList handles;
+    int total = 0;
+    for (int row = 0; row < mRowTitles.size(); ++row) {
+        if (!mRowTitles.at(row).contains(needle))
+            continue;
+
+        if (total >= offset && (limit < 0 || handles.size() < limit))
+            handles.append(mRowHandles.at(row));
+        ++total;
+    }
+
+    return { { "total", total }, { "offset", offset }, { "handles", handles } };
+}
+
+QVariantMap NodeIndexCPP::findByType(int type, int offset, int limit) const
+{
+    QVariantList handles;
+    int total = 0;
+    for (int row = 0; row < mRowTypes.size(); ++row) {
+        if (mRowTypes.at(row) != type)
+            continue;
+
+        if (total >= offset && (limit < 0 || handles.size() < limit))
+            handles.append(mRowHandles.at(row));
+        ++total;
+    }
+
+    return { { "total", total }, { "offset", offset }, { "handles", handles } };
+}
+
+int NodeIndexCPP::count() const
+{
+    return mEntries.size();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void NodeIndexCPP::onTitleChanged()
+{
+    QObject *node = sender();
+    auto it = mEntries.find(node);
+    if (it == mEntries.end())
+        return;
+
+    const QString foldedTitle = node->property("title").toString().toCaseFolded();
+    if (foldedTitle == it->foldedTitle)
+        return;
+
+    mSortedTitles.erase({ it->foldedTitle, it->handle });
+    mSortedTitles.insert({ foldedTitle, it->handle });
+    mRowTitles[it->row] = foldedTitle;
+    it->foldedTitle     = foldedTitle;
+}
+
+void NodeIndexCPP::onTypeChanged()
+{
+    QObject *node = sender();
+    auto it = mEntries.find(node);
+    if (it == mEntries.end())
+        return;
+
+    const int type = node->property("type").toInt();
+    if (type == it->type)
+        return;
+
+    if (--mTypeCounts[it->type] == 0)
+        mTypeCounts.remove(it->type);
+    ++mTypeCounts[type];
+
+    mRowTypes[it->row] = type;
+    it->type           = type;
+}
+
+void NodeIndexCPP::onNodeDestroyed(QObject *node)
+{
+    removeEntry(node);
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+void NodeIndexCPP::watchProperty(QObject *node, const char *property, const char *slot)
+{
+    const QMetaObject *nodeMeta = node->metaObject();
+    const int propertyIndex = nodeMeta->indexOfProperty(property);
+    if (propertyIndex < 0)
+        return;
+
+    const QMetaMethod notifySignal = nodeMeta->property(propertyIndex).notifySignal();
+    const int slotIndex = metaObject()->indexOfSlot(slot);
+    if (!notifySignal.isValid() || slotIndex < 0)
+        return;
+
+    connect(node, notifySignal, this, metaObject()->method(slotIndex), Qt::UniqueConnection);
+}
+
+/*!
+ * The last row takes the place of the removed one, so removal is O(log N).
+ */
+void NodeIndexCPP::removeEntry(QObject *node)
+{
+    const auto it = mEntries.constFind(node);
+    if (it == mEntries.constEnd())
+        return;
+
+    const Entry entry = it.value();
+    mEntries.erase(it);
+
+    mSortedTitles.erase({ entry.foldedTitle, entry.handle });
+    if (--mTypeCounts[entry.type] == 0)
+        mTypeCounts.remove(entry.type);
+
+    const int lastRow = mRowNodes.size() - 1;
+    if (entry.row != lastRow) {
+        QObject *lastNode = mRowNodes.at(lastRow);
+        mRowTitles[entry.row]  = mRowTitles.at(lastRow);
+        mRowTypes[entry.row]   = mRowTypes.at(lastRow);
+        mRowHandles[entry.row] = mRowHandles.at(lastRow);
+        mRowNodes[entry.row]   = lastNode;
+        mEntries[lastNode].row = entry.row;
+    }
+
+    mRowTitles.removeLast();
+    mRowTypes.removeLast();
+    mRowHandles.removeLast();
+    mRowNodes.removeLast();
+
+    emit countChanged();
+}
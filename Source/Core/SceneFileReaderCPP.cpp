@@ -0,0 +1,192 @@
+#include "SceneFileReaderCPP.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QHash>
+#include <QUuid>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+const QString ReferencePrefix = QStringLiteral("qqs:/");
+const QString RootKey         = QStringLiteral("root");
+const QString UuidKey         = QStringLiteral("_qsUuid");
+
+//! value with the UUIDs of references and map keys replaced by their new UUIDs
+QVariant renamed(const QVariant &value, const QHash<QString, QString> &uuids)
+{
+    switch (value.metaType().id()) {
+    case QMetaType::QString: {
+        const QString text = value.toString();
+        if (!text.startsWith(ReferencePrefix))
+            return value;
+
+        const auto it = uuids.constFind(text.mid(ReferencePrefix.size()));
+        return it != uuids.constEnd() ? QVariant(ReferencePrefix + it.value()) : value;
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        QVariantMap result;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            // An own UUID saved with the object
+            const QVariant item = it.key() == UuidKey
+                    ? QVariant(uuids.value(it.value().toString(), it.value().toString()))
+                    : renamed(it.value(), uuids);
+            result.insert(uuids.value(it.key(), it.key()), item);
+        }
+        return result;
+    }
+    case QMetaType::QVariantList: {
+        QVariantList list = value.toList();
+        for (QVariant &item : list)
+            item = renamed(item, uuids);
+        return list;
+    }
+    default:
+        return value;
+    }
+}
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+SceneFileReaderCPP::SceneFileReaderCPP(QObject *parent)
+    : QObject{parent}
+    , mIsCancelled(false)
+    , mRenewUuids(false)
+{
+    connect(&mWatcher, &QFutureWatcher<ReadResult>::finished,
+            this, &SceneFileReaderCPP::onReadFinished);
+}
+
+/*! Destructor, waits for a running read
+ * ************************************************************************************************/
+SceneFileReaderCPP::~SceneFileReaderCPP()
+{
+    mWatcher.waitForFinished();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*!
+ * Start reading a scene file on a worker thread.
+ *
+ * \param filePath is the local file path.
+ * \return false if a read is already running.
+ */
+bool SceneFileReaderCPP::read(const QString &filePath)
+{
+    if (mWatcher.isRunning()) {
+        qWarning() << "SceneFileReader: A file is already being read";
+        return false;
+    }
+
+    mIsCancelled = false;
+    mWatcher.setFuture(QtConcurrent::run(&SceneFileReaderCPP::readFile, filePath, mRenewUuids));
+    emit busyChanged();
+
+    return true;
+}
+
+/*!
+ * The worker can not be interrupted, its result is dropped instead.
+ */
+void SceneFileReaderCPP::cancel()
+{
+    mIsCancelled = true;
+}
+
+bool SceneFileReaderCPP::busy() const
+{
+    return mWatcher.isRunning();
+}
+
+bool SceneFileReaderCPP::renewUuids() const
+{
+    return mRenewUuids;
+}
+
+/*!
+ * Applies to the next read.
+ */
+void SceneFileReaderCPP::setRenewUuids(bool renewUuids)
+{
+    if (mRenewUuids == renewUuids)
+        return;
+
+    mRenewUuids = renewUuids;
+    emit renewUuidsChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*!
+ * Runs on the worker thread: read and parse the file and convert it to a variant map, with new
+ * UUIDs if renewUuids is set.
+ */
+SceneFileReaderCPP::ReadResult SceneFileReaderCPP::readFile(const QString &filePath,
+                                                             bool renewUuids)
+{
+    ReadResult result;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.error = QStringLiteral("Failed to open file %1: %2").arg(filePath, file.errorString());
+        return result;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        result.error = QStringLiteral("Failed to parse file JSON: %1").arg(parseError.errorString());
+        return result;
+    }
+
+    if (!document.isObject()) {
+        result.error = QStringLiteral("Scene file is not a JSON object: %1").arg(filePath);
+        return result;
+    }
+
+    result.objects = document.object().toVariantMap();
+    if (!renewUuids)
+        return result;
+
+    QHash<QString, QString> uuids;
+    uuids.reserve(result.objects.size());
+    for (auto it = result.objects.cbegin(); it != result.objects.cend(); ++it) {
+        if (it.key() != RootKey)
+            uuids.insert(it.key(), QUuid::createUuid().toString(QUuid::WithoutBraces));
+    }
+
+    result.objects = renamed(result.objects, uuids).toMap();
+
+    return result;
+}
+
+/*!
+ * Back on the GUI thread, deliver the result.
+ */
+void SceneFileReaderCPP::onReadFinished()
+{
+    emit busyChanged();
+
+    if (mIsCancelled)
+        return;
+
+    const ReadResult result = mWatcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << "SceneFileReader:" << result.error;
+        emit failed(result.error);
+        return;
+    }
+
+    emit finished(result.objects);
+}
@@ -0,0 +1,134 @@
+#include "SceneGeometryCPP.h"
+
+#include <QJSValue>
+#include <QPolygonF>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+SceneGeometryCPP::SceneGeometryCPP(QObject *parent)
+    : QObject{parent}
+    , mStore(GeometryStoreCPP::forRepo(nullptr))
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+GeometryStoreCPP *SceneGeometryCPP::store() const
+{
+    return mStore.get();
+}
+
+int SceneGeometryCPP::nodeCount() const
+{
+    return mStore->nodeCount();
+}
+
+QRectF SceneGeometryCPP::nodesBoundingRect() const
+{
+    QRectF bounds;
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (mStore->isNodeAlive(row))
+            bounds |= mStore->nodeRect(row);
+    }
+
+    return bounds;
+}
+
+QVariantList SceneGeometryCPP::nodesInRect(const QRectF &rect) const
+{
+    const QVector<float> &xs      = mStore->nodeX();
+    const QVector<float> &ys      = mStore->nodeY();
+    const QVector<int>   &widths  = mStore->nodeWidth();
+    const QVector<int>   &heights = mStore->nodeHeight();
+
+    QVariantList matches;
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (!mStore->isNodeAlive(row))
+            continue;
+
+        if (xs.at(row) + widths.at(row) <= rect.left() || xs.at(row) >= rect.right() ||
+            ys.at(row) + heights.at(row) <= rect.top() || ys.at(row) >= rect.bottom())
+            continue;
+
+        if (QObject *owner = mStore->nodeOwner(row))
+            matches.append(QVariant::fromValue(owner));
+    }
+
+    return matches;
+}
+
+QVariantList SceneGeometryCPP::nodesInPolygon(const QVariantList &points) const
+{
+    QPolygonF polygon;
+    polygon.reserve(points.size());
+    for (QVariant point : points) {
+        if (point.metaType() == QMetaType::fromType<QJSValue>())
+            point = point.value<QJSValue>().toVariant();
+
+        if (point.typeId() == QMetaType::QVariantMap) {
+            const QVariantMap map = point.toMap();
+            polygon.append(QPointF(map.value("x").toReal(), map.value("y").toReal()));
+        } else {
+            polygon.append(point.toPointF());
+        }
+    }
+
+    QVariantList matches;
+    if (polygon.size() < 3)
+        return matches;
+
+    const QRectF polygonBounds = polygon.boundingRect();
+    for (int row = 0; row < mStore->nodeRowCount(); ++row) {
+        if (!mStore->isNodeAlive(row))
+            continue;
+
+        const QRectF rect = mStore->nodeRect(row);
+        if (rect.left() > polygonBounds.right() || rect.right() < polygonBounds.left() ||
+            rect.top() > polygonBounds.bottom() || rect.bottom() < polygonBounds.top())
+            continue;
+
+        if (!polygon.containsPoint(rect.center(), Qt::OddEvenFill) &&
+            !polygon.intersects(QPolygonF(rect)))
+            continue;
+
+        if (QObject *owner = mStore->nodeOwner(row))
+            matches.append(QVariant::fromValue(owner));
+    }
+
+    return matches;
+}
+
+QObject *SceneGeometryCPP::nodeAt(qreal x, qreal y) const
+{
+    const QPointF point(x, y);
+    for (int row = mStore->nodeRowCount() - 1; row >= 0; --row) {
+        if (!mStore->isNodeAlive(row) || !mStore->nodeRect(row).contains(point))
+            continue;
+
+        if (QObject *owner = mStore->nodeOwner(row))
+            return owner;
+    }
+
+    return nullptr;
+}
+
+QObject *SceneGeometryCPP::repo() const
+{
+    return mRepo;
+}
+
+void SceneGeometryCPP::setRepo(QObject *repo)
+{
+    if (mRepo == repo)
+        return;
+
+    mRepo  = repo;
+    mStore = GeometryStoreCPP::forRepo(repo);
+    emit repoChanged();
+}
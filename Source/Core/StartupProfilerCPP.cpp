@@ -0,0 +1,117 @@
+#include "StartupProfilerCPP.h"
+
+#include <QDebug>
+#include <QVariantMap>
+
+#include <memory>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor, starts the clock
+ * ************************************************************************************************/
+StartupProfilerCPP::StartupProfilerCPP(QObject *parent)
+    : QObject(parent)
+{
+    mClock.start();
+}
+
+/* ************************************************************************************************
+ * Singleton Instance Provider
+ * ************************************************************************************************/
+
+StartupProfilerCPP *StartupProfilerCPP::instance()
+{
+    static StartupProfilerCPP profiler;
+    return &profiler;
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+void StartupProfilerCPP::begin(const QString &phase)
+{
+    Phase entry;
+    entry.name    = phase;
+    entry.startMs = elapsedMs();
+    mPhases.append(entry);
+
+    emit phasesChanged();
+}
+
+void StartupProfilerCPP::end(const QString &phase)
+{
+    for (auto it = mPhases.rbegin(); it != mPhases.rend(); ++it) {
+        if (it->name == phase && it->durationMs < 0) {
+            it->durationMs = elapsedMs() - it->startMs;
+            emit phasesChanged();
+            return;
+        }
+    }
+
+    qWarning() << "StartupProfilerCPP: No running phase" << phase;
+}
+
+/*!
+ * frameSwapped is emitted on the render thread with the threaded render loop, the phase is ended
+ * on the thread of the profiler.
+ */
+void StartupProfilerCPP::trackFirstFrame(QQuickWindow *window)
+{
+    if (!window)
+        return;
+
+    begin("firstFrame");
+
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = connect(window, &QQuickWindow::frameSwapped, this, [this, connection]() {
+        disconnect(*connection);
+        end("firstFrame");
+        emit firstFrameShown();
+
+        if (qEnvironmentVariableIsSet("NODELINK_STARTUP_PROFILE"))
+            qInfo().noquote() << report();
+    }, Qt::QueuedConnection);
+}
+
+double StartupProfilerCPP::elapsedMs() const
+{
+    return mClock.nsecsElapsed() / 1e6;
+}
+
+QString StartupProfilerCPP::report() const
+{
+    QString text = QStringLiteral("Startup profile (ms)\n");
+    for (const Phase &phase : mPhases) {
+        text += QString("  %1 %2 at %3\n")
+                    .arg(phase.name, -18)
+                    .arg(phase.durationMs < 0 ? QStringLiteral("running")
+                                              : QString::number(phase.durationMs, 'f', 1), 9)
+                    .arg(phase.startMs, 0, 'f', 1);
+    }
+
+    return text;
+}
+
+void StartupProfilerCPP::reset()
+{
+    mPhases.clear();
+    mClock.restart();
+
+    emit phasesChanged();
+}
+
+QVariantList StartupProfilerCPP::phases() const
+{
+    QVariantList list;
+    for (const Phase &phase : mPhases) {
+        list.append(QVariantMap{
+                        { "name",       phase.name },
+                        { "startMs",    phase.startMs },
+                        { "durationMs", phase.durationMs } });
+    }
+
+    return list;
+}
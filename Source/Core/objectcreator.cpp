@@ -1,10 +1,15 @@
 #include "objectcreator.h"
+#include "StartupProfilerCPP.h"
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QTimer>
+
+#include <memory>
 
 ObjectCreator::ObjectCreator(QObject *parent)
     : QObject(parent)
     , m_engine(nullptr)
+    , m_pendingCount(0)
 {
 }
 
@@ -15,8 +20,9 @@ ObjectCreator::~ObjectCreator()
 
 QQmlComponent* ObjectCreator::getOrCreateComponent(const QString &componentUrl)
 {
-    if (m_components.contains(componentUrl)) {
-        return m_components[componentUrl];
+    QQmlComponent *component = m_components.value(componentUrl);
+    if (component && !component->isLoading()) {
+        return component;
     }
 
     if (!m_engine) {
@@ -24,10 +30,13 @@ QQmlComponent* ObjectCreator::getOrCreateComponent(const QString &componentUrl)
         return nullptr;
     }
     qDebug() << "Will use the component:" << componentUrl;
-    QQmlComponent *component = new QQmlComponent(
+
+    // Not preloaded, or still compiling in the background: the items are needed now, so the
+    // component is loaded synchronously (a preloading component is released when it is done)
+    component = new QQmlComponent(
         m_engine,
         componentUrl,
-        QQmlComponent::Asynchronous,
+        QQmlComponent::PreferSynchronous,
         this
         );
 
@@ -171,3 +180,151 @@ QVariantMap ObjectCreator::createItems(
     qDebug() << "Creating" << count << name << "took" << timer.elapsed() << "ms";
     return result;
 }
+
+void ObjectCreator::preload(
+    QObject *context,
+    const QStringList &componentUrls,
+    const QStringList &typeNames,
+    const QStringList &imports)
+{
+    if (!m_engine) {
+        m_engine = qmlEngine(context);
+    }
+
+    if (!m_engine) {
+        qWarning() << "Could not get QML engine!";
+        return;
+    }
+
+    for (const QString &componentUrl : componentUrls) {
+        if (componentUrl.isEmpty() || m_components.contains(componentUrl)) {
+            continue;
+        }
+
+        QQmlComponent *component = new QQmlComponent(
+            m_engine,
+            componentUrl,
+            QQmlComponent::Asynchronous,
+            this
+            );
+        m_components[componentUrl] = component;
+        beginPending();
+
+        whenLoaded(component, [this, component, componentUrl](bool ready) {
+            if (!ready) {
+                qWarning() << "Cannot preload" << componentUrl << component->errors();
+            }
+
+            // Failed components are created again on use, so the errors are reported there
+            if (!ready && m_components.value(componentUrl) == component) {
+                m_components.remove(componentUrl);
+            }
+            if (m_components.value(componentUrl) != component) {
+                component->deleteLater();
+            }
+
+            endPending(ready ? "components" : "errors");
+        });
+    }
+
+    const QStringList modules = imports.isEmpty() ? QStringList{ "NodeLink" } : imports;
+    for (const QString &typeName : typeNames) {
+        if (typeName.isEmpty() || m_components.contains("type:" + typeName)) {
+            continue;
+        }
+
+        beginPending();
+        preloadType(typeName, modules, 0);
+    }
+}
+
+int ObjectCreator::pendingCount() const
+{
+    return m_pendingCount;
+}
+
+/*!
+ * The compiled type stays in the cache of the engine while its component is alive, objects of
+ * the type created later (QSSerializer.createQSObject, Qt.createQmlObject) find it compiled.
+ */
+void ObjectCreator::preloadType(const QString &typeName, const QStringList &modules, int moduleIndex)
+{
+    const QString key = "type:" + typeName;
+
+    QQmlComponent *component = new QQmlComponent(m_engine, this);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    component->loadFromModule(modules.at(moduleIndex), typeName, QQmlComponent::Asynchronous);
+#else
+    // No asynchronous loading by type name, compiled on the GUI thread
+    component->setData(QString("import %1\n%2 {}").arg(modules.at(moduleIndex), typeName).toUtf8(),
+                       QUrl());
+#endif
+    m_components[key] = component;
+
+    whenLoaded(component, [this, component, key, typeName, modules, moduleIndex](bool ready) {
+        if (ready) {
+            endPending("types");
+            return;
+        }
+
+        m_components.remove(key);
+        component->deleteLater();
+
+        if (moduleIndex + 1 < modules.size()) {
+            preloadType(typeName, modules, moduleIndex + 1);
+            return;
+        }
+
+        qWarning() << "Cannot preload type" << typeName << "from" << modules << component->errors();
+        endPending("errors");
+    });
+}
+
+void ObjectCreator::whenLoaded(QQmlComponent *component, const std::function<void(bool)> &done)
+{
+    if (!component->isLoading()) {
+        QTimer::singleShot(0, this, [component, done]() { done(component->isReady()); });
+        return;
+    }
+
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = connect(component, &QQmlComponent::statusChanged, this,
+                          [component, done, connection](QQmlComponent::Status status) {
+        if (status == QQmlComponent::Loading) {
+            return;
+        }
+
+        disconnect(*connection);
+        done(component->isReady());
+    });
+}
+
+void ObjectCreator::beginPending()
+{
+    if (m_pendingCount == 0) {
+        m_preloadTimer.start();
+        m_preloadStats = { { "components", 0 }, { "types", 0 }, { "errors", 0 } };
+        StartupProfilerCPP::instance()->begin("componentWarmup");
+    }
+
+    ++m_pendingCount;
+    emit pendingCountChanged();
+}
+
+void ObjectCreator::endPending(const QString &counter)
+{
+    m_preloadStats[counter] = m_preloadStats.value(counter).toInt() + 1;
+
+    --m_pendingCount;
+    emit pendingCountChanged();
+
+    if (m_pendingCount > 0) {
+        return;
+    }
+
+    StartupProfilerCPP::instance()->end("componentWarmup");
+
+    m_preloadStats["elapsedMs"] = m_preloadTimer.elapsed();
+    qDebug() << "Preloading components took" << m_preloadTimer.elapsed() << "ms" << m_preloadStats;
+    emit preloadFinished(m_preloadStats);
+}
@@ -74,7 +74,7 @@ ApplicationWindow {
         anchors.topMargin: 50
         anchors.rightMargin: 50
         width: 220
-        height: 460
+        height: 560
         color: "#2d2d2d"
         border.color: "#3e3e3e"
         radius: 8
@@ -127,6 +127,14 @@ ApplicationWindow {
                 highlighted: true
             }
 
+            Button {
+                width: parent.width - 30
+                checkable: true
+                checked: NLSpec.memory.sharedDefaults
+                text: checked ? "Shared Defaults" : "Own Defaults"
+                onToggled: NLSpec.memory.sharedDefaults = checked
+            }
+
             Button {
                 id: startButton
                 text: "Start Test"
@@ -157,6 +165,13 @@ ApplicationWindow {
                 wrapMode: Text.WordWrap
             }
 
+            Button {
+                text: "Measure Memory"
+                width: parent.width - 30
+                onClicked: updateMemoryInfo()
+                onDoubleClicked: clicked()
+            }
+
             Button {
                 text: "Clear Scene"
                 width: parent.width - 30
@@ -282,6 +297,147 @@ ApplicationWindow {
         }
     }
 
+    // Memory Monitor
+    Rectangle {
+        anchors.left: view.left
+        anchors.top: view.top
+        anchors.topMargin: 230
+        anchors.leftMargin: 50
+        width: 220
+        height: 220
+        color: "#2d2d2d"
+        border.color: "#3e3e3e"
+        radius: 8
+        z: 10
+
+        Column {
+            anchors.fill: parent
+            anchors.margins: 15
+            spacing: 12
+
+            Text {
+                text: "Memory Monitor"
+                color: "#ffffff"
+                font.bold: true
+                font.pixelSize: 16
+            }
+
+            Rectangle {
+                width: parent.width - 30
+                height: 1
+                color: "#3e3e3e"
+            }
+
+            Repeater {
+                model: [
+                    { label: "Objects:",    key: "objects" },
+                    { label: "Per node:",   key: "perNode" },
+                    { label: "Shared:",     key: "saved" },
+                    { label: "JS heap:",    key: "jsHeap" },
+                    { label: "View items:", key: "viewItems" }
+                ]
+
+                delegate: Row {
+                    spacing: 10
+                    Text {
+                        text: modelData.label
+                        color: "#cccccc"
+                        font.pixelSize: 13
+                        width: 80
+                    }
+                    Text {
+                        text: memoryInfo[modelData.key] ?? "-"
+                        color: "#03A9F4"
+                        font.pixelSize: 13
+                        font.bold: true
+                    }
+                }
+            }
+        }
+    }
+
+    // Startup Profile
+    Rectangle {
+        anchors.left: view.left
+        anchors.top: view.top
+        anchors.topMargin: 470
+        anchors.leftMargin: 50
+        width: 220
+        height: 60 + StartupProfiler.phases.length * 28
+        color: "#2d2d2d"
+        border.color: "#3e3e3e"
+        radius: 8
+        z: 10
+
+        Column {
+            anchors.fill: parent
+            anchors.margins: 15
+            spacing: 12
+
+            Text {
+                text: "Startup (ms)"
+                color: "#ffffff"
+                font.bold: true
+                font.pixelSize: 16
+            }
+
+            Rectangle {
+                width: parent.width - 30
+                height: 1
+                color: "#3e3e3e"
+            }
+
+            Repeater {
+                model: StartupProfiler.phases
+
+                delegate: Row {
+                    spacing: 10
+                    Text {
+                        text: modelData.name
+                        color: "#cccccc"
+                        font.pixelSize: 13
+                        width: 120
+                    }
+                    Text {
+                        text: modelData.durationMs < 0 ? "..." : modelData.durationMs.toFixed(1)
+                        color: "#03A9F4"
+                        font.pixelSize: 13
+                        font.bold: true
+                    }
+                }
+            }
+        }
+    }
+
+    //! Last memory sample, see updateMemoryInfo()
+    property var memoryInfo: ({})
+
+    function formatBytes(bytes) {
+        if (bytes < 0)
+            return "n/a";
+        if (bytes < 1024 * 1024)
+            return (bytes / 1024).toFixed(1) + " KB";
+        return (bytes / (1024 * 1024)).toFixed(1) + " MB";
+    }
+
+    //! Sample the memory of the scene and log it, to be compared between runs
+    function updateMemoryInfo() {
+        if (!scene)
+            return;
+
+        const stats = scene.memoryStats(view);
+        const nodeCount = stats.objects.nodes.count;
+        memoryInfo = {
+            objects:   stats.objectCount + " (" + formatBytes(stats.objectBytes) + ")",
+            perNode:   nodeCount > 0 ? formatBytes(stats.objectBytes / nodeCount) : "-",
+            saved:     "-" + formatBytes(stats.savedBytes),
+            jsHeap:    formatBytes(stats.jsHeap.used),
+            viewItems: stats.view.itemCount
+        };
+
+        console.log("Memory:", JSON.stringify(stats));
+    }
+
     function randBetween(min, max) {
         return Math.random() * (max - min) + min;
     }
@@ -316,6 +472,7 @@ ApplicationWindow {
             statusText.text = "Completed in " + elapsedTime + "ms"
             statusText.color = "#4CAF50"
             console.log("Elapsed time: " + elapsedTime + "ms")
+            updateMemoryInfo()
             startButton.enabled = true
             busyIndicator.running = false
             running = false
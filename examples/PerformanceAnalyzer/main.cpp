@@ -1,10 +1,19 @@
 #include <QtGui/QGuiApplication>
 #include <QQmlApplicationEngine>
+#include <QQmlComponent>
 #include <QQuickStyle>
+#include <QQuickWindow>
+
+#include "StartupProfilerCPP.h"
 
 int main(int argc, char* argv[])
 {
+  // Startup times are measured from here
+  StartupProfilerCPP *profiler = StartupProfilerCPP::instance();
+
   QGuiApplication app(argc, argv);
+
+  profiler->begin("engineInit");
   QQmlApplicationEngine engine;
 
   // Set style into app.
@@ -12,6 +21,14 @@ int main(int argc, char* argv[])
 
   //Import all items into QML engine.
   engine.addImportPath(":/");
+  profiler->end("engineInit");
+
+  // Resolve the imports before the main component, so their cost is measured apart
+  profiler->begin("moduleImport");
+  QQmlComponent imports(&engine);
+  imports.setData("import QtQuick\nimport QtQuick.Controls\nimport NodeLink\n"
+                  "import PerformanceAnalyzer\nQtObject {}", QUrl());
+  profiler->end("moduleImport");
 
   const QUrl url(u"qrc:/PerformanceAnalyzer/Main.qml"_qs);
   QObject::connect(&engine, &QQmlApplicationEngine::objectCreated,
@@ -19,8 +36,13 @@ int main(int argc, char* argv[])
       if (!obj && url == objUrl)
           QCoreApplication::exit(-1);
   }, Qt::QueuedConnection);
+
+  profiler->begin("mainComponent");
   engine.load(url);
+  profiler->end("mainComponent");
+
+  if (!engine.rootObjects().isEmpty())
+      profiler->trackFirstFrame(qobject_cast<QQuickWindow *>(engine.rootObjects().first()));
 
   return app.exec();
 }
-
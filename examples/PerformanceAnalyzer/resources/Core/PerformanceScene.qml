@@ -137,6 +137,7 @@ Scene {
         var nodeIds = Object.keys(nodes)
         scene.deleteNodes(nodeIds)
         links = []
+        _handles.rebuild()
         console.timeEnd("Scene_clear")
     }
 
@@ -37,7 +37,7 @@ I_Scene {
             return null;
         }
 
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (scene._nodeIndex.typeCount(nodeType) + 1);
         
         // Use 2D position for both 2D and 3D (3D is just for reference)
         return createSpecificNode3D(nodeRegistry.imports, nodeType, qsType,
@@ -54,7 +54,7 @@ I_Scene {
             return null;
         }
 
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (scene._nodeIndex.typeCount(nodeType) + 1);
         
         // Use provided 2D and 3D positions
         return createSpecificNode3D(nodeRegistry.imports, nodeType, qsType,
@@ -315,19 +315,18 @@ I_Scene {
         if (portA.length === 0 || portB.length === 0)
             return false;
 
-        // Find nodes first (cheaper than iterating all links)
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+        var nodeA = _handles.nodeOfPort(handleA);
+        var nodeB = _handles.nodeOfPort(handleB);
 
-        // Early exit: empty node IDs or same node
-        if (nodeA.length === 0 || nodeB.length === 0 ||
-            HashCompareString.compareStringModels(nodeA, nodeB)) {
+        // Early exit: unknown ports or same node
+        if (nodeA === 0 || nodeB === 0 || nodeA === nodeB)
             return false;
-        }
 
-        // Check port types (cheaper than iterating links)
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
 
         if (!portAObj || !portBObj)
             return false;
@@ -345,22 +344,14 @@ I_Scene {
             return false;
         }
 
-        // Check for existing link (most expensive operation - do last)
         // Check if the exact same link already exists
-        var sameLinks = Object.values(links).filter(link =>
-            HashCompareString.compareStringModels(link.inputPort._qsUuid, portA) &&
-            HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-
-        if (sameLinks.length > 0)
+        if (_handles.hasLink(handleA, handleB))
             return false;
 
         // An input port can accept only a single link
         // Check if portB (input port) is already connected to any output port
         // In I_Scene.createLink: link.inputPort = portA (output), link.outputPort = portB (input)
-        var inputPortLinks = Object.values(links).filter(link =>
-            HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-
-        if (inputPortLinks.length > 0) {
+        if (_handles.linkCountTo(handleB) > 0) {
             // Input port already has a connection, reject new connection
             return false;
         }
@@ -503,11 +494,13 @@ I_Scene {
                 }
                 if (value.inputPort._qsUuid === portId ||
                         value.outputPort._qsUuid === portId) {
+                    _handles.removeLink(value);
                     linkRemoved(value);
                     delete links[key];
                 }
             });
         });
+        _handles.removeNode(nodeRef);
         nodeRemoved(nodeRef);
 
         delete nodes[nodeUUId];
@@ -518,12 +511,7 @@ I_Scene {
         // Push undo command BEFORE destroying node (skip during replay)
         // This allows undo to restore the node
         if (!scene._undoCore.undoStack.isReplaying && nodeRef) {
-            // Use qrc path to access NodeLink resources - same as in I_Scene
-            var cmdRemoveNode = Qt.createQmlObject('import QtQuick; import NodeLink; import "qrc:/NodeLink/resources/Core/Undo/Commands"; RemoveNodeCommand { }', scene._undoCore.undoStack)
-            cmdRemoveNode.scene = scene
-            cmdRemoveNode.node = nodeRef
-            cmdRemoveNode.links = connectedLinks.slice() // Create a copy of the array
-            scene._undoCore.undoStack.push(cmdRemoveNode)
+            scene._undoCore.undoStack.pushRemoveNode(scene, nodeRef, connectedLinks)
         }
         // Don't destroy node during replay - it needs to be preserved for undo
         // Node will be destroyed when command is cleaned up from stack
@@ -547,5 +535,12 @@ I_Scene {
             scene.updateData();
         });
     }
+
+    //! Links added at once (paste, undo, loading a file)
+    onLinksAdded: (links) => {
+        Qt.callLater(function() {
+            scene.updateData();
+        });
+    }
 }
 
@@ -404,6 +404,11 @@ Item {
                         shapesContainer.updateShapes();
                     });
                 }
+                function onLinksAdded(links) {
+                    Qt.callLater(function() {
+                        shapesContainer.updateShapes();
+                    });
+                }
                 function onLinkRemoved(link) {
                     Qt.callLater(function() {
                         shapesContainer.updateShapes();
@@ -1280,6 +1285,13 @@ Item {
                     }
                 }, 50);  // After a short delay
             }
+            function onLinksAdded(links) {
+                Qt.callLater(function() {
+                    if (nodesOverlay.portUpdateTimer) {
+                        nodesOverlay.portUpdateTimer.restart();
+                    }
+                });
+            }
             function onLinkRemoved(link) {
                 // Trigger port position update when link is removed
                 Qt.callLater(function() {
@@ -1610,7 +1622,7 @@ Item {
                     defaultNodeType,
                     scene.nodeRegistry.nodeTypes[defaultNodeType],
                     scene.nodeRegistry.nodeColors[defaultNodeType],
-                    scene.nodeRegistry.nodeNames[defaultNodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === defaultNodeType).length + 1),
+                    scene.nodeRegistry.nodeNames[defaultNodeType] + "_" + (scene._nodeIndex.typeCount(defaultNodeType) + 1),
                     initialScreenPos.x,  // Initial 2D X position (will be updated with camera)
                     initialScreenPos.y,  // Initial 2D Y position (will be updated with camera)
                     worldPos.x,  // 3D X position
@@ -72,6 +72,7 @@ I_Scene {
     onLinkRemoved: _upateDataTimer.start();
     onNodeRemoved: _upateDataTimer.start();
     onLinkAdded:   updateData();
+    onLinksAdded:  updateData();
 
     property Timer _upateDataTimer: Timer {
         repeat: false
@@ -86,7 +87,7 @@ I_Scene {
 
     //! Create a node with node type and its position
     function createCustomizeNode(nodeType : int, xPos : real, yPos : real) : string {
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (scene._nodeIndex.typeCount(nodeType) + 1);
         return createSpecificNode(nodeRegistry.imports, nodeType,
                                   nodeRegistry.nodeTypes[nodeType],
                                   nodeRegistry.nodeColors[nodeType],
@@ -121,46 +122,44 @@ I_Scene {
         if (portA.length === 0 || portB.length === 0)
             return false;
 
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+
         // Just a input port can be link to output port
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
         if (portAObj.portType === NLSpec.PortType.Input)
             return false;
         if (portBObj.portType === NLSpec.PortType.Output)
             return false;
 
         // Find exist links with portA as input port and portB as output port.
-        var sameLinks = Object.values(links).filter(link =>
-            HashCompareString.compareStringModels(link.inputPort._qsUuid, portA) &&
-            HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-
-        if (sameLinks.length > 0)
+        if (_handles.hasLink(handleA, handleB))
             return false;
 
         // An input port can accept only a single link.
-        var portBObjLinks = Object.values(links).filter(link => HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-        if (portBObjLinks.length)
+        if (_handles.linkCountTo(handleB) > 0)
             return false;
 
         // A node cannot establish a link with itself
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
-        if (HashCompareString.compareStringModels(nodeA, nodeB)
-                    || nodeA.length === 0 || nodeB.length === 0) {
+        var nodeA = _handles.nodeOfPort(handleA);
+        var nodeB = _handles.nodeOfPort(handleB);
+        if (nodeA === nodeB || nodeA === 0 || nodeB === 0)
             return false;
-        }
 
         // A node can be connect to another at one direction
-        var sameReverseLinks = Object.values(links).filter(link =>
-            findNodeId(link.outputPort._qsUuid) === nodeA &&
-            findNodeId(link.inputPort._qsUuid) === nodeB);
-
-        if (sameReverseLinks.length > 0)
+        if (_handles.hasNodeLink(nodeB, nodeA))
             return false;
 
         return true;
     }
 
+    //! Evaluate the graph (headless runs)
+    function evaluate() {
+        updateData();
+    }
+
     //! Updata node data with connected links
     function updateData() {
 
@@ -0,0 +1,341 @@
+#include "RuleExecutor.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+namespace {
+
+//! Responses of the result nodes, same as ChatbotScene.upadateNodeData()
+const QString kResultTrueResponse  = QStringLiteral("HI ...");
+const QString kResultFalseResponse = QStringLiteral(" :( ");
+
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+RuleExecutor::RuleExecutor(QObject *parent)
+    : QObject(parent)
+    , mIsCompiled(false)
+    , mRegexCompileCount(0)
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Compile the chatbot graph. Every input port accepts a single link, so each rule has at most
+ * one upstream rule. Nodes inside a cycle are left out with a warning.
+ *
+ * \param nodes is a list of {id, type: CSpecs.NodeType, data: node data, isInput: bool}
+ * \param links is a list of {from: upstream node id, to: downstream node id}
+ * \return true on success
+ */
+bool RuleExecutor::compile(const QVariantList &nodes, const QVariantList &links)
+{
+    const int nodeCount = nodes.size();
+
+    QVector<Rule> rules;
+    QHash<QString, int> indexById;
+    rules.reserve(nodeCount);
+    indexById.reserve(nodeCount);
+
+    for (const QVariant &nodeVariant : nodes) {
+        const QVariantMap node = nodeVariant.toMap();
+        const int type = node.value("type", -1).toInt();
+        if (type < Source || type > ResultFalse)
+            continue;
+
+        Rule rule;
+        rule.type    = RuleType(type);
+        rule.id      = node.value("id").toString();
+        rule.isInput = node.value("isInput").toBool();
+        rule.text    = node.value("data").toString();
+        if (rule.type == ResultTrue)
+            rule.text = kResultTrueResponse;
+        else if (rule.type == ResultFalse)
+            rule.text = kResultFalseResponse;
+
+        indexById.insert(rule.id, rules.size());
+        rules.append(rule);
+    }
+
+    QVector<QVector<int>> fanout(rules.size());
+    QVector<int> inDegree(rules.size(), 0);
+    for (const QVariant &linkVariant : links) {
+        const QVariantMap link = linkVariant.toMap();
+        const int from = indexById.value(link.value("from").toString(), -1);
+        const int to   = indexById.value(link.value("to").toString(), -1);
+        if (from < 0 || to < 0 || rules[to].upstream >= 0)
+            continue;
+
+        rules[to].upstream = from;
+        fanout[from].append(to);
+        ++inDegree[to];
+    }
+
+    // Topological order (Kahn's algorithm)
+    QVector<int> order;
+    order.reserve(rules.size());
+    for (int i = 0; i < rules.size(); ++i) {
+        if (inDegree[i] == 0)
+            order.append(i);
+    }
+    for (int head = 0; head < order.size(); ++head) {
+        for (int next : fanout[order[head]]) {
+            if (--inDegree[next] == 0)
+                order.append(next);
+        }
+    }
+
+    if (order.size() != rules.size())
+        qWarning() << "RuleExecutor:" << rules.size() - order.size() << "nodes in a cycle are ignored";
+
+    // Re-index rules in topological order
+    QVector<int> newIndex(rules.size(), -1);
+    for (int i = 0; i < order.size(); ++i)
+        newIndex[order[i]] = i;
+
+    mRules.clear();
+    mRules.reserve(order.size());
+    mIndexById.clear();
+    mIndexById.reserve(order.size());
+    QHash<QString, CachedRegex> regexCache;
+    for (int oldIndex : order) {
+        Rule rule = rules[oldIndex];
+        rule.upstream = rule.upstream >= 0 ? newIndex[rule.upstream] : -1;
+        mIndexById.insert(rule.id, mRules.size());
+        mRules.append(rule);
+
+        // Keep compiled regexes of nodes that still exist
+        if (rule.type == Regex && mRegexCache.contains(rule.id))
+            regexCache.insert(rule.id, mRegexCache.value(rule.id));
+    }
+    mRegexCache = regexCache;
+
+    mMatchStates = QVector<int>(mRules.size(), NoInput);
+    mOutputs     = QVector<QString>(mRules.size());
+
+    mIsCompiled = true;
+    emit compiledChanged();
+
+    return true;
+}
+
+/*!
+ * Update the pattern of a Regex node without recompiling the graph.
+ */
+void RuleExecutor::setPattern(const QString &nodeId, const QString &pattern)
+{
+    const int index = mIndexById.value(nodeId, -1);
+    if (index >= 0 && mRules[index].type == Regex)
+        mRules[index].text = pattern;
+}
+
+/*!
+ * Evaluate a single message.
+ *
+ * \return map with
+ *      responses: responses of the linked result nodes in rule order, "" when the condition of
+ *                 a node is not met (the interactive propagation emits those as well)
+ *      results:   map <result node id, response text or "">
+ *      matches:   map <regex node id, bool or null when the regex had no input>
+ */
+QVariantMap RuleExecutor::evaluate(const QString &message)
+{
+    QVariantMap result;
+    if (!mIsCompiled)
+        return result;
+
+    run(message);
+
+    QStringList responses;
+    QVariantMap results;
+    QVariantMap matches;
+    for (int i = 0; i < mRules.size(); ++i) {
+        const Rule &rule = mRules[i];
+        switch (rule.type) {
+        case Regex:
+            matches.insert(rule.id, mMatchStates[i] == NoInput ? QVariant()
+                                                               : QVariant(mMatchStates[i] == Found));
+            break;
+        case ResultTrue:
+        case ResultFalse:
+            results.insert(rule.id, mOutputs[i]);
+            if (rule.upstream >= 0)
+                responses.append(mOutputs[i]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    result["responses"] = responses;
+    result["results"]   = results;
+    result["matches"]   = matches;
+
+    return result;
+}
+
+/*!
+ * Evaluate a list of messages, e.g. a replayed chat log.
+ *
+ * \return map with
+ *      messageCount:      number of evaluated messages
+ *      elapsedMs:         evaluation time
+ *      messagesPerSecond: throughput
+ *      responses:         list of response lists, one per message
+ *      hits:              map <node id, count>; regex nodes count matches, result nodes count
+ *                         non-empty responses
+ */
+QVariantMap RuleExecutor::evaluateBatch(const QStringList &messages)
+{
+    QVariantMap result;
+    if (!mIsCompiled)
+        return result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<qint64> hits(mRules.size(), 0);
+    QVariantList responses;
+    responses.reserve(messages.size());
+
+    for (const QString &message : messages) {
+        run(message);
+
+        QStringList messageResponses;
+        for (int i = 0; i < mRules.size(); ++i) {
+            switch (mRules[i].type) {
+            case Regex:
+                if (mMatchStates[i] == Found)
+                    ++hits[i];
+                break;
+            case ResultTrue:
+            case ResultFalse:
+                if (!mOutputs[i].isEmpty()) {
+                    ++hits[i];
+                    messageResponses.append(mOutputs[i]);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        responses.append(messageResponses);
+    }
+
+    const qreal elapsedMs = timer.nsecsElapsed() / 1.0e6;
+
+    QVariantMap hitMap;
+    for (int i = 0; i < mRules.size(); ++i) {
+        if (mRules[i].type != Source)
+            hitMap.insert(mRules[i].id, hits[i]);
+    }
+
+    result["messageCount"]      = messages.size();
+    result["elapsedMs"]         = elapsedMs;
+    result["messagesPerSecond"] = elapsedMs > 0 ? messages.size() * 1000.0 / elapsedMs : 0.0;
+    result["responses"]         = responses;
+    result["hits"]              = hitMap;
+
+    return result;
+}
+
+bool RuleExecutor::isCompiled() const
+{
+    return mIsCompiled;
+}
+
+int RuleExecutor::ruleCount() const
+{
+    return mRules.size();
+}
+
+int RuleExecutor::regexCompileCount() const
+{
+    return mRegexCompileCount;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+/*!
+ * Push one message through the rule list. Mirrors the interactive propagation: a Regex node
+ * tests its pattern against the data of its upstream node (the message for the input source,
+ * the stored text for other sources and the pattern for an upstream Regex node), and result
+ * nodes respond depending on the match state of their upstream node.
+ */
+void RuleExecutor::run(const QString &message)
+{
+    for (int i = 0; i < mRules.size(); ++i) {
+        const Rule &rule = mRules[i];
+        const int upstream = rule.upstream;
+
+        mMatchStates[i] = NoInput;
+        mOutputs[i].clear();
+
+        switch (rule.type) {
+        case Source:
+            mOutputs[i] = rule.isInput ? message : rule.text;
+            break;
+
+        case Regex: {
+            mOutputs[i] = rule.text;
+            if (upstream < 0 || mOutputs[upstream].isEmpty())
+                break;
+
+            if (rule.text.isEmpty()) {
+                mMatchStates[i] = NotFound;
+                break;
+            }
+
+            const QRegularExpression &regex = regexFor(rule);
+            mMatchStates[i] = regex.isValid() && regex.match(mOutputs[upstream]).hasMatch()
+                                  ? Found : NotFound;
+        } break;
+
+        case ResultTrue:
+            if (upstream >= 0 && mMatchStates[upstream] == Found)
+                mOutputs[i] = rule.text;
+            break;
+
+        case ResultFalse:
+            if (upstream >= 0 && mMatchStates[upstream] == NotFound)
+                mOutputs[i] = rule.text;
+            break;
+        }
+    }
+}
+
+/*!
+ * Return the cached regex of a Regex rule, rebuilding it only when the pattern changed.
+ */
+const QRegularExpression &RuleExecutor::regexFor(const Rule &rule)
+{
+    auto it = mRegexCache.find(rule.id);
+    if (it == mRegexCache.end())
+        it = mRegexCache.insert(rule.id, CachedRegex());
+
+    CachedRegex &cached = it.value();
+    if (!cached.isBuilt || cached.pattern != rule.text) {
+        cached.isBuilt = true;
+        cached.pattern = rule.text;
+        cached.regex   = QRegularExpression(rule.text, QRegularExpression::CaseInsensitiveOption);
+        // JIT-compile now instead of on the first match
+        cached.regex.optimize();
+        if (!cached.regex.isValid())
+            qWarning() << "RuleExecutor: Invalid regular expression:" << rule.text << cached.regex.errorString();
+
+        ++mRegexCompileCount;
+        emit compiledChanged();
+    }
+
+    return cached.regex;
+}
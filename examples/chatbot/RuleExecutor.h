@@ -0,0 +1,116 @@
+#ifndef RULEEXECUTOR_H
+#define RULEEXECUTOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * RuleExecutor compiles the chatbot graph into a topologically ordered rule list and pushes
+ * messages through it without touching the QML node objects.
+ *
+ * Regular expressions are cached per Regex node and JIT-optimised once; they are only rebuilt
+ * when the pattern of that node changes.
+ * ************************************************************************************************/
+class RuleExecutor : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(RuleExecutorCPP)
+
+    Q_PROPERTY(bool isCompiled        READ isCompiled        NOTIFY compiledChanged)
+    Q_PROPERTY(int  ruleCount         READ ruleCount         NOTIFY compiledChanged)
+    Q_PROPERTY(int  regexCompileCount READ regexCompileCount NOTIFY compiledChanged)
+
+public:
+    //! Node types, values mirror CSpecs.NodeType
+    enum RuleType {
+        Source      = 0,
+        Regex       = 1,
+        ResultTrue  = 2,
+        ResultFalse = 3
+    };
+    Q_ENUM(RuleType)
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit RuleExecutor(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Compile nodes [{id, type, data, isInput}] and links [{from, to}] into the rule list.
+    Q_INVOKABLE bool compile(const QVariantList &nodes, const QVariantList &links);
+
+    //! Update the pattern of a Regex node, the regex is rebuilt only if the pattern changed.
+    Q_INVOKABLE void setPattern(const QString &nodeId, const QString &pattern);
+
+    //! Evaluate a single message.
+    Q_INVOKABLE QVariantMap evaluate(const QString &message);
+
+    //! Evaluate a list of messages and count rule hits.
+    Q_INVOKABLE QVariantMap evaluateBatch(const QStringList &messages);
+
+    bool isCompiled() const;
+    int  ruleCount() const;
+    int  regexCompileCount() const;
+
+signals:
+    void compiledChanged();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    //! Match state of a Regex node for the current message
+    enum MatchState {
+        NoInput  = -1,
+        NotFound = 0,
+        Found    = 1
+    };
+
+    //! One compiled node, upstream indexes into the rule list
+    struct Rule {
+        RuleType type     = Source;
+        QString  id;
+        int      upstream = -1;
+        bool     isInput  = false;
+        //! Static text: source text, regex pattern or result response
+        QString  text;
+    };
+
+    //! Cached regular expression of a Regex node
+    struct CachedRegex {
+        bool               isBuilt = false;
+        QString            pattern;
+        QRegularExpression regex;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Run one message, fills mMatchStates and mOutputs
+    void run(const QString &message);
+    const QRegularExpression &regexFor(const Rule &rule);
+
+    /* Attributes
+     * ****************************************************************************************/
+    bool                         mIsCompiled;
+    int                          mRegexCompileCount;
+
+    //! Rules in topological order
+    QVector<Rule>                mRules;
+
+    //! Index into mRules by node id
+    QHash<QString, int>          mIndexById;
+
+    //! Regex cache keyed by node id, survives recompilation
+    QHash<QString, CachedRegex>  mRegexCache;
+
+    //! Per-message scratch state, indexed like mRules
+    QVector<int>                 mMatchStates;
+    QVector<QString>             mOutputs;
+};
+
+#endif // RULEEXECUTOR_H
@@ -76,11 +76,8 @@ Window {
             Layout.preferredWidth: 400
             Layout.fillHeight: true
             onUserMessageSent: (message) => {
-                let sourceNode = Object.values(window.scene.nodes).find(n => n.type === 0)
-                if (sourceNode) {
-                    sourceNode.nodeData.data = message
-                    window.scene.updateData()
-                }
+                if (window.scene)
+                    window.scene.respondTo(message)
             }
         }
     }
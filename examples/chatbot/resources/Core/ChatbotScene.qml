@@ -48,10 +48,37 @@ I_Scene {
         scene: scene
     }
 
+    //! Compiled rule executor, rebuilt lazily when the graph structure changes
+    property RuleExecutorCPP _ruleExecutor: RuleExecutorCPP {}
+
+    property bool _rulesDirty: true
+
+    //! Texts of the Source nodes (except the input) when the rules were compiled
+    property var  _compiledSourceTexts: ({})
+
     //! update node data when a link removed, node removed and link added.
-    onLinkRemoved: _upateDataTimer.start();
-    onNodeRemoved: _upateDataTimer.start();
-    onLinkAdded:   updateData();
+    onLinkRemoved: {
+        _rulesDirty = true;
+        _upateDataTimer.start();
+    }
+    onNodeRemoved: {
+        _rulesDirty = true;
+        _upateDataTimer.start();
+    }
+    onLinkAdded: {
+        _rulesDirty = true;
+        updateData();
+    }
+    onNodeAdded:    _rulesDirty = true;
+    onNodesAdded:   _rulesDirty = true;
+    onNodesRemoved: {
+        _rulesDirty = true;
+        _upateDataTimer.start();
+    }
+    onLinksAdded: {
+        _rulesDirty = true;
+        updateData();
+    }
 
     property Timer _upateDataTimer: Timer {
         repeat: false
@@ -65,7 +92,7 @@ I_Scene {
 
     //! Create a node with node type and its position
     function createCustomizeNode(nodeType : int, xPos : real, yPos : real) : string {
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (scene._nodeIndex.typeCount(nodeType) + 1);
         return createSpecificNode(nodeRegistry.imports, nodeType,
                                   nodeRegistry.nodeTypes[nodeType],
                                   nodeRegistry.nodeColors[nodeType],
@@ -93,41 +120,34 @@ I_Scene {
         if (portA.length === 0 || portB.length === 0)
             return false;
 
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+
         // Just a input port can be link to output port
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
         if (portAObj.portType === NLSpec.PortType.Input)
             return false;
         if (portBObj.portType === NLSpec.PortType.Output)
             return false;
 
         // Find exist links with portA as input port and portB as output port.
-        var sameLinks = Object.values(links).filter(link =>
-            HashCompareString.compareStringModels(link.inputPort._qsUuid, portA) &&
-            HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-
-        if (sameLinks.length > 0)
+        if (_handles.hasLink(handleA, handleB))
             return false;
 
         // An input port can accept only a single link.
-        var portBObjLinks = Object.values(links).filter(link => HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-        if (portBObjLinks.length)
+        if (_handles.linkCountTo(handleB) > 0)
             return false;
 
         // A node cannot establish a link with itself
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
-        if (HashCompareString.compareStringModels(nodeA, nodeB)
-                    || nodeA.length === 0 || nodeB.length === 0) {
+        var nodeA = _handles.nodeOfPort(handleA);
+        var nodeB = _handles.nodeOfPort(handleB);
+        if (nodeA === nodeB || nodeA === 0 || nodeB === 0)
             return false;
-        }
 
         // A node can be connect to another at one direction
-        var sameReverseLinks = Object.values(links).filter(link =>
-            findNodeId(link.outputPort._qsUuid) === nodeA &&
-            findNodeId(link.inputPort._qsUuid) === nodeB);
-
-        if (sameReverseLinks.length > 0)
+        if (_handles.hasNodeLink(nodeB, nodeA))
             return false;
 
         return true;
@@ -207,6 +227,98 @@ I_Scene {
         }
     }
 
+    //! Plain description of the rule graph for RuleExecutorCPP.compile()
+    //! The first Source node receives the chat messages.
+    function buildRuleGraph() {
+        var ruleNodes = [];
+        var sourceTexts = {};
+        var inputSource = Object.values(nodes).find(node => node.type === CSpecs.NodeType.Source);
+        Object.values(nodes).forEach(node => {
+            if (node.type === CSpecs.NodeType.Source && node !== inputSource)
+                sourceTexts[node._qsUuid] = node.nodeData?.data ?? "";
+
+            ruleNodes.push({
+                id:      node._qsUuid,
+                type:    node.type,
+                data:    node.nodeData?.data ?? "",
+                isInput: node === inputSource
+            });
+        });
+
+        var ruleLinks = [];
+        Object.values(links).forEach(link => {
+            ruleLinks.push({
+                from: findNodeId(link.inputPort._qsUuid),
+                to:   findNodeId(link.outputPort._qsUuid)
+            });
+        });
+
+        _compiledSourceTexts = sourceTexts;
+
+        return { nodes: ruleNodes, links: ruleLinks };
+    }
+
+    //! Compile the rule graph if the structure or the text of a Source node changed, otherwise
+    //! only sync regex patterns (the executor rebuilds a regex only when its pattern changed).
+    function prepareRules() {
+        var inputSource = Object.values(nodes).find(node => node.type === CSpecs.NodeType.Source);
+        Object.values(nodes).forEach(node => {
+            if (node.type === CSpecs.NodeType.Source && node !== inputSource &&
+                (node.nodeData?.data ?? "") !== _compiledSourceTexts[node._qsUuid])
+                _rulesDirty = true;
+        });
+
+        if (_rulesDirty) {
+            var graph = buildRuleGraph();
+            _ruleExecutor.compile(graph.nodes, graph.links);
+            _rulesDirty = false;
+            return;
+        }
+
+        Object.values(nodes).forEach(node => {
+            if (node.type === CSpecs.NodeType.Regex)
+                _ruleExecutor.setPattern(node._qsUuid, node.nodeData?.data ?? "");
+        });
+    }
+
+    //! Push a chat message through the compiled rules, update the node models and
+    //! emit the responses.
+    function respondTo(message : string) {
+        var inputSource = Object.values(nodes).find(node => node.type === CSpecs.NodeType.Source);
+        if (!inputSource)
+            return;
+
+        inputSource.nodeData.data = message;
+        prepareRules();
+
+        var result = _ruleExecutor.evaluate(message);
+
+        Object.entries(result.matches).forEach(([nodeId, found]) => {
+            var node = nodes[nodeId];
+            if (!node || found === null || found === undefined)
+                return;
+
+            node.matchedPattern = found ? "FOUND" : "NOT_FOUND";
+        });
+
+        Object.entries(result.results).forEach(([nodeId, text]) => {
+            var node = nodes[nodeId];
+            if (node)
+                node.nodeData.data = text;
+        });
+
+        // Every linked result node responds, with "" when its condition is not met
+        result.responses.forEach(text => botResponse(text));
+    }
+
+    //! Evaluate a list of messages (e.g. a replayed chat log) without touching the node models.
+    //! Returns {messageCount, elapsedMs, messagesPerSecond, responses, hits}.
+    function evaluateMessages(messages) {
+        prepareRules();
+
+        return _ruleExecutor.evaluateBatch(messages);
+    }
+
     function upadateNodeData(upstreamNode: Node, downStreamNode: Node) {
         switch (downStreamNode.type) {
             case CSpecs.NodeType.Regex:
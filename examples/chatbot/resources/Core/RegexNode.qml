@@ -8,6 +8,10 @@ Node {
     nodeData: I_NodeData {}
     property var inputFirst: null
     property var matchedPattern: null
+
+    //! Compiled RegExp, rebuilt only when nodeData.data changes
+    property var _regex: null
+    property string _regexPattern: ""
     guiConfig.width: 150
     guiConfig.height: 100
 
@@ -48,8 +52,12 @@ Node {
         }
 
         try {
-            var re = new RegExp(nodeData.data, "i")
-            var found = re.test(inputFirst)
+            if (!_regex || _regexPattern !== nodeData.data) {
+                _regex = null
+                _regexPattern = nodeData.data
+                _regex = new RegExp(nodeData.data, "i")
+            }
+            var found = _regex.test(inputFirst)
             matchedPattern = found ? "FOUND" : "NOT_FOUND"
         } catch (e) {
             // Invalid regex pattern
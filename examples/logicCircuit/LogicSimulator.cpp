@@ -0,0 +1,420 @@
+#include "LogicSimulator.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QtEndian>
+
+namespace {
+
+//! Largest sweep kept in memory (8 MiB of packed bits per input/output)
+constexpr qint64 kMaxSweepVectors     = qint64(1) << 26;
+constexpr int    kMaxTruthTableInputs = 26;
+
+//! Truth table bit patterns of the six inputs that change inside a single 64-bit word
+constexpr quint64 kTruthTablePatterns[6] = {
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL
+};
+
+//! Number of inputs a gate type needs before its output is defined
+int requiredInputs(int type)
+{
+    switch (type) {
+    case LogicSimulator::And:
+    case LogicSimulator::Or:
+        return 2;
+    case LogicSimulator::Not:
+    case LogicSimulator::Output:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+LogicSimulator::LogicSimulator(QObject *parent)
+    : QObject(parent)
+    , mIsCompiled(false)
+    , mLastVectorCount(0)
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Compile the circuit into a levelised netlist.
+ * Gates whose inputs are not all connected (or are driven by such gates) are undefined and left
+ * out of the netlist, matching the UNDEFINED state of the interactive propagation.
+ *
+ * \param nodes is a list of {id: string, type: LSpecs.NodeType}
+ * \param links is a list of {from: upstream node id, to: downstream node id}
+ * \return true on success, false if the graph contains unknown types or a cycle
+ */
+bool LogicSimulator::compile(const QVariantList &nodes, const QVariantList &links)
+{
+    mIsCompiled = false;
+    mSlotIds.clear();
+    mGates.clear();
+    mInputIds.clear();
+    mOutputIds.clear();
+    mOutputSlots.clear();
+    mInputBits.clear();
+    mOutputBits.clear();
+    mLastVectorCount = 0;
+
+    const int nodeCount = nodes.size();
+    QStringList ids;
+    QVector<int> types;
+    QHash<QString, int> indexById;
+    ids.reserve(nodeCount);
+    types.reserve(nodeCount);
+    indexById.reserve(nodeCount);
+
+    for (const QVariant &nodeVariant : nodes) {
+        const QVariantMap node = nodeVariant.toMap();
+        const QString id = node.value("id").toString();
+        const int type = node.value("type", -1).toInt();
+        if (type < Input || type > Output) {
+            setError(QString("Unsupported node type %1 (node %2)").arg(type).arg(id));
+            return false;
+        }
+
+        indexById.insert(id, ids.size());
+        ids.append(id);
+        types.append(type);
+    }
+
+    // Drivers of every node, in link order
+    QVector<QVector<int>> drivers(nodeCount);
+    QVector<QVector<int>> fanout(nodeCount);
+    for (const QVariant &linkVariant : links) {
+        const QVariantMap link = linkVariant.toMap();
+        const int from = indexById.value(link.value("from").toString(), -1);
+        const int to   = indexById.value(link.value("to").toString(), -1);
+        if (from < 0 || to < 0)
+            continue;
+
+        drivers[to].append(from);
+        fanout[from].append(to);
+    }
+
+    // Levelise (Kahn's algorithm)
+    QVector<int> inDegree(nodeCount, 0);
+    for (int i = 0; i < nodeCount; ++i)
+        inDegree[i] = drivers[i].size();
+
+    QVector<int> order;
+    order.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        if (inDegree[i] == 0)
+            order.append(i);
+    }
+    for (int head = 0; head < order.size(); ++head) {
+        for (int next : fanout[order[head]]) {
+            if (--inDegree[next] == 0)
+                order.append(next);
+        }
+    }
+
+    if (order.size() != nodeCount) {
+        setError("The circuit contains a feedback loop and cannot be levelised");
+        return false;
+    }
+
+    // Assign value slots: inputs first, then defined gates in topological order
+    QVector<int> slotOf(nodeCount, -1);
+    for (int i = 0; i < nodeCount; ++i) {
+        if (types[i] != Input)
+            continue;
+
+        slotOf[i] = mSlotIds.size();
+        mSlotIds.append(ids[i]);
+        mInputIds.append(ids[i]);
+    }
+
+    for (int nodeIndex : order) {
+        const int type = types[nodeIndex];
+        if (type == Input)
+            continue;
+
+        const QVector<int> &nodeDrivers = drivers[nodeIndex];
+        bool defined = nodeDrivers.size() >= requiredInputs(type);
+        for (int i = 0; defined && i < requiredInputs(type); ++i)
+            defined = slotOf[nodeDrivers[i]] >= 0;
+
+        if (type == Output) {
+            mOutputIds.append(ids[nodeIndex]);
+            mOutputSlots.append(defined ? slotOf[nodeDrivers[0]] : -1);
+            continue;
+        }
+
+        if (!defined)
+            continue;
+
+        Gate gate;
+        gate.type = GateType(type);
+        gate.inA  = slotOf[nodeDrivers[0]];
+        gate.inB  = type == Not ? gate.inA : slotOf[nodeDrivers[1]];
+
+        slotOf[nodeIndex] = mSlotIds.size();
+        mSlotIds.append(ids[nodeIndex]);
+        mGates.append(gate);
+    }
+
+    mErrorString.clear();
+    mIsCompiled = true;
+    emit compiledChanged();
+
+    return true;
+}
+
+/*!
+ * Evaluate the exhaustive truth table. Vector v assigns bit i of v to input i.
+ *
+ * \return sweep result, see runSweep()
+ */
+QVariantMap LogicSimulator::runTruthTable()
+{
+    if (!mIsCompiled)
+        return errorResult("Circuit is not compiled");
+
+    if (mInputIds.size() > kMaxTruthTableInputs)
+        return errorResult(QString("Truth table is limited to %1 inputs").arg(kMaxTruthTableInputs));
+
+    return runSweep(SweepMode::TruthTable, qint64(1) << mInputIds.size(), 0);
+}
+
+/*!
+ * Evaluate uniformly distributed random input vectors.
+ *
+ * \param vectorCount is the number of vectors to evaluate
+ * \param seed makes the sweep reproducible
+ * \return sweep result, see runSweep()
+ */
+QVariantMap LogicSimulator::runRandomSweep(int vectorCount, int seed)
+{
+    if (!mIsCompiled)
+        return errorResult("Circuit is not compiled");
+
+    if (vectorCount <= 0 || vectorCount > kMaxSweepVectors)
+        return errorResult(QString("Vector count must be between 1 and %1").arg(kMaxSweepVectors));
+
+    return runSweep(SweepMode::Random, vectorCount, quint32(seed));
+}
+
+/*!
+ * \return the value of input \a inputIndex in vector \a vectorIndex of the last sweep
+ */
+bool LogicSimulator::inputValue(int inputIndex, int vectorIndex) const
+{
+    if (inputIndex < 0 || inputIndex >= mInputBits.size() ||
+        vectorIndex < 0 || vectorIndex >= mLastVectorCount)
+        return false;
+
+    return (mInputBits[inputIndex][vectorIndex >> 6] >> (vectorIndex & 63)) & 1;
+}
+
+/*!
+ * \return the value of output \a outputIndex in vector \a vectorIndex of the last sweep
+ */
+bool LogicSimulator::outputValue(int outputIndex, int vectorIndex) const
+{
+    if (outputIndex < 0 || outputIndex >= mOutputBits.size() ||
+        vectorIndex < 0 || vectorIndex >= mLastVectorCount)
+        return false;
+
+    return (mOutputBits[outputIndex][vectorIndex >> 6] >> (vectorIndex & 63)) & 1;
+}
+
+bool LogicSimulator::isCompiled() const
+{
+    return mIsCompiled;
+}
+
+int LogicSimulator::inputCount() const
+{
+    return mInputIds.size();
+}
+
+int LogicSimulator::outputCount() const
+{
+    return mOutputIds.size();
+}
+
+int LogicSimulator::gateCount() const
+{
+    return mGates.size();
+}
+
+QString LogicSimulator::errorString() const
+{
+    return mErrorString;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+/*!
+ * Run the compiled netlist over \a vectorCount vectors, kBlockWords x 64 vectors per pass.
+ *
+ * \return map with
+ *      vectorCount: number of evaluated vectors
+ *      elapsedMs:   evaluation time
+ *      inputs:      input node ids, index i is bit i of a truth table vector
+ *      outputs:     [{nodeId, defined, ones, bits}], bits packs vector v into bit v % 8 of byte v / 8
+ *      toggles:     map <node id, number of value changes between consecutive vectors>
+ */
+QVariantMap LogicSimulator::runSweep(SweepMode mode, qint64 vectorCount, quint32 seed)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const int inputCount  = mInputIds.size();
+    const int slotCount   = mSlotIds.size();
+    const int outputCount = mOutputIds.size();
+    const qint64 wordCount  = (vectorCount + 63) / 64;
+    const qint64 blockCount = (wordCount + kBlockWords - 1) / kBlockWords;
+
+    mInputBits  = QVector<QVector<quint64>>(inputCount,  QVector<quint64>(wordCount, 0));
+    mOutputBits = QVector<QVector<quint64>>(outputCount, QVector<quint64>(wordCount, 0));
+    mLastVectorCount = vectorCount;
+
+    QVector<Block>   values(slotCount, Block{});
+    QVector<quint64> toggles(slotCount, 0);
+    QVector<quint64> lastBit(slotCount, 0);
+    QRandomGenerator generator(seed);
+
+    for (qint64 block = 0; block < blockCount; ++block) {
+        const qint64 firstWord = block * kBlockWords;
+        const int    words     = int(qMin<qint64>(kBlockWords, wordCount - firstWord));
+
+        // Input words
+        for (int i = 0; i < inputCount; ++i) {
+            Block &in = values[i];
+            for (int w = 0; w < words; ++w) {
+                if (mode == SweepMode::Random) {
+                    in[w] = generator.generate64();
+                } else if (i < 6) {
+                    in[w] = kTruthTablePatterns[i];
+                } else {
+                    in[w] = ((firstWord + w) >> (i - 6)) & 1 ? ~quint64(0) : quint64(0);
+                }
+            }
+        }
+
+        // Levelised gates, one bitwise op per word
+        for (int g = 0; g < mGates.size(); ++g) {
+            const Gate  &gate = mGates[g];
+            const Block &a    = values[gate.inA];
+            const Block &b    = values[gate.inB];
+            Block       &out  = values[inputCount + g];
+
+            switch (gate.type) {
+            case And:
+                for (int w = 0; w < kBlockWords; ++w)
+                    out[w] = a[w] & b[w];
+                break;
+            case Or:
+                for (int w = 0; w < kBlockWords; ++w)
+                    out[w] = a[w] | b[w];
+                break;
+            case Not:
+                for (int w = 0; w < kBlockWords; ++w)
+                    out[w] = ~a[w];
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Collect outputs and toggle counts
+        for (int w = 0; w < words; ++w) {
+            const qint64  word      = firstWord + w;
+            const qint64  validBits = qMin<qint64>(64, vectorCount - word * 64);
+            const quint64 validMask = validBits == 64 ? ~quint64(0) : (quint64(1) << validBits) - 1;
+            // The first vector of the sweep has no predecessor to toggle from
+            const quint64 toggleMask = word == 0 ? validMask & ~quint64(1) : validMask;
+
+            for (int s = 0; s < slotCount; ++s) {
+                const quint64 v = values[s][w];
+                toggles[s] += qPopulationCount((v ^ ((v << 1) | lastBit[s])) & toggleMask);
+                lastBit[s]  = v >> 63;
+            }
+
+            for (int i = 0; i < inputCount; ++i)
+                mInputBits[i][word] = values[i][w] & validMask;
+
+            for (int o = 0; o < outputCount; ++o) {
+                if (mOutputSlots[o] >= 0)
+                    mOutputBits[o][word] = values[mOutputSlots[o]][w] & validMask;
+            }
+        }
+    }
+
+    const qreal elapsedMs = timer.nsecsElapsed() / 1.0e6;
+
+    QVariantMap toggleMap;
+    for (int s = 0; s < slotCount; ++s)
+        toggleMap.insert(mSlotIds[s], toggles[s]);
+
+    QVariantList outputs;
+    for (int o = 0; o < outputCount; ++o) {
+        const QVector<quint64> &bits = mOutputBits[o];
+        quint64 ones = 0;
+        for (quint64 word : bits)
+            ones += qPopulationCount(word);
+
+        QByteArray packed(wordCount * sizeof(quint64), Qt::Uninitialized);
+        qToLittleEndian<quint64>(bits.constData(), wordCount, packed.data());
+
+        const bool defined = mOutputSlots[o] >= 0;
+        QVariantMap output;
+        output["nodeId"]  = mOutputIds[o];
+        output["defined"] = defined;
+        output["ones"]    = ones;
+        output["bits"]    = packed;
+        outputs.append(output);
+
+        toggleMap.insert(mOutputIds[o], defined ? toggles[mOutputSlots[o]] : 0);
+    }
+
+    QVariantMap result;
+    result["vectorCount"] = vectorCount;
+    result["elapsedMs"]   = elapsedMs;
+    result["inputs"]      = mInputIds;
+    result["outputs"]     = outputs;
+    result["toggles"]     = toggleMap;
+
+    return result;
+}
+
+QVariantMap LogicSimulator::errorResult(const QString &message) const
+{
+    QVariantMap result;
+    result["error"] = message;
+    return result;
+}
+
+void LogicSimulator::setError(const QString &message)
+{
+    qWarning() << "LogicSimulator:" << message;
+    mErrorString = message;
+    emit compiledChanged();
+}
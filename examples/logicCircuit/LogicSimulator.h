@@ -0,0 +1,121 @@
+#ifndef LOGICSIMULATOR_H
+#define LOGICSIMULATOR_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QQmlEngine>
+
+#include <array>
+
+/*! ***********************************************************************************************
+ * LogicSimulator compiles a logic circuit graph into a levelised netlist and evaluates it
+ * bit-parallel: every machine word carries 64 input vectors and AND, OR and NOT are single
+ * bitwise instructions over a block of words.
+ *
+ * The QML scene hands over a plain netlist description (see LogicCircuitScene.buildNetlist()),
+ * so the simulator never walks QML objects while a sweep is running.
+ * ************************************************************************************************/
+class LogicSimulator : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(LogicSimulatorCPP)
+
+    Q_PROPERTY(bool    isCompiled  READ isCompiled  NOTIFY compiledChanged)
+    Q_PROPERTY(int     inputCount  READ inputCount  NOTIFY compiledChanged)
+    Q_PROPERTY(int     outputCount READ outputCount NOTIFY compiledChanged)
+    Q_PROPERTY(int     gateCount   READ gateCount   NOTIFY compiledChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY compiledChanged)
+
+public:
+    //! Gate types, values mirror LSpecs.NodeType
+    enum GateType {
+        Input   = 0,
+        And     = 1,
+        Or      = 2,
+        Not     = 3,
+        Output  = 4
+    };
+    Q_ENUM(GateType)
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit LogicSimulator(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Compile nodes [{id, type}] and links [{from, to}] into a levelised netlist.
+    Q_INVOKABLE bool compile(const QVariantList &nodes, const QVariantList &links);
+
+    //! Evaluate all 2^inputCount input combinations.
+    Q_INVOKABLE QVariantMap runTruthTable();
+
+    //! Evaluate vectorCount random input vectors generated from seed.
+    Q_INVOKABLE QVariantMap runRandomSweep(int vectorCount, int seed = 0);
+
+    //! Value of an input/output for the given vector of the last sweep.
+    Q_INVOKABLE bool inputValue(int inputIndex, int vectorIndex) const;
+    Q_INVOKABLE bool outputValue(int outputIndex, int vectorIndex) const;
+
+    bool    isCompiled() const;
+    int     inputCount() const;
+    int     outputCount() const;
+    int     gateCount() const;
+    QString errorString() const;
+
+signals:
+    void compiledChanged();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    //! Vectors evaluated per gate instruction: kBlockWords x 64
+    static constexpr int kBlockWords = 4;
+    using Block = std::array<quint64, kBlockWords>;
+
+    //! One levelised instruction. Slots index into the value table, inputs come first.
+    struct Gate {
+        GateType type = And;
+        int      inA  = -1;
+        int      inB  = -1;
+    };
+
+    //! How the input words of a sweep are produced
+    enum class SweepMode {
+        TruthTable,
+        Random
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    QVariantMap runSweep(SweepMode mode, qint64 vectorCount, quint32 seed);
+    QVariantMap errorResult(const QString &message) const;
+    void        setError(const QString &message);
+
+    /* Attributes
+     * ****************************************************************************************/
+    bool             mIsCompiled;
+    QString          mErrorString;
+
+    //! Node id owning each value slot
+    QStringList      mSlotIds;
+
+    //! Gates in topological order, gate i writes slot (inputCount + i)
+    QVector<Gate>    mGates;
+
+    //! Node ids of input nodes (in slot order) and output nodes
+    QStringList      mInputIds;
+    QStringList      mOutputIds;
+
+    //! Value slot feeding each output, -1 when the output is undefined
+    QVector<int>     mOutputSlots;
+
+    //! Packed bits of the last sweep, bit v of word v/64 belongs to vector v
+    QVector<QVector<quint64>> mInputBits;
+    QVector<QVector<quint64>> mOutputBits;
+    qint64           mLastVectorCount;
+};
+
+#endif // LOGICSIMULATOR_H
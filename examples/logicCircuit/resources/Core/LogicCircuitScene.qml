@@ -62,10 +62,35 @@ I_Scene {
         scene: scene
     }
 
+    //! Compiled netlist used for truth-table and random sweeps
+    property LogicSimulatorCPP _simulator: LogicSimulatorCPP {}
+
+    //! The netlist is recompiled lazily on the next sweep after a structural change
+    property bool _netlistDirty: true
+
     //! Update logic when connections change
-    onLinkRemoved: updateLogic();
-    onNodeRemoved: updateLogic();
-    onLinkAdded: updateLogic();
+    onLinkRemoved: {
+        _netlistDirty = true;
+        updateLogic();
+    }
+    onNodeRemoved: {
+        _netlistDirty = true;
+        updateLogic();
+    }
+    onLinkAdded: {
+        _netlistDirty = true;
+        updateLogic();
+    }
+    onNodeAdded:     _netlistDirty = true;
+    onNodesAdded:    _netlistDirty = true;
+    onNodesRemoved: {
+        _netlistDirty = true;
+        _upateDataTimer.start();
+    }
+    onLinksAdded: {
+        _netlistDirty = true;
+        _upateDataTimer.start();
+    }
 
     property Timer _upateDataTimer: Timer {
         repeat: false
@@ -80,13 +105,18 @@ I_Scene {
     //! Create a node with node type and its position
     function createCustomizeNode(nodeType, xPos, yPos) {
         var title = nodeRegistry.nodeNames[nodeType] + "_" +
-                   (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+                   (scene._nodeIndex.typeCount(nodeType) + 1);
         return createSpecificNode(nodeRegistry.imports, nodeType,
                                  nodeRegistry.nodeTypes[nodeType],
                                  nodeRegistry.nodeColors[nodeType],
                                  title, xPos, yPos);
     }
 
+    //! Evaluate the graph (headless runs)
+    function evaluate() {
+        updateLogic();
+    }
+
     //! Update all logic in the circuit
     function updateLogic() {
 
@@ -186,6 +216,53 @@ I_Scene {
         }
     }
 
+    //! Build the plain netlist description consumed by LogicSimulatorCPP.compile()
+    //! nodes: [{id, type}], links: [{from: upstream node id, to: downstream node id}]
+    function buildNetlist() {
+        var netNodes = [];
+        var portOwner = {};
+        Object.values(nodes).forEach(node => {
+            netNodes.push({ id: node._qsUuid, type: node.type });
+            Object.keys(node.ports).forEach(portId => portOwner[portId] = node._qsUuid);
+        });
+
+        var netLinks = [];
+        Object.values(links).forEach(link => {
+            if (!link || !link.inputPort || !link.outputPort)
+                return;
+
+            var from = portOwner[link.inputPort._qsUuid];
+            var to   = portOwner[link.outputPort._qsUuid];
+            if (from && to)
+                netLinks.push({ from: from, to: to });
+        });
+
+        return { nodes: netNodes, links: netLinks };
+    }
+
+    //! Compile the circuit into the bit-parallel simulator
+    function compileCircuit() : bool {
+        var netlist = buildNetlist();
+        _netlistDirty = !_simulator.compile(netlist.nodes, netlist.links);
+        return !_netlistDirty;
+    }
+
+    //! Evaluate every input combination, see LogicSimulatorCPP.runTruthTable()
+    function runTruthTable() {
+        if (_netlistDirty && !compileCircuit())
+            return { error: _simulator.errorString };
+
+        return _simulator.runTruthTable();
+    }
+
+    //! Evaluate vectorCount random input vectors, see LogicSimulatorCPP.runRandomSweep()
+    function runRandomSweep(vectorCount, seed) {
+        if (_netlistDirty && !compileCircuit())
+            return { error: _simulator.errorString };
+
+        return _simulator.runRandomSweep(vectorCount, seed ?? 0);
+    }
+
     //! Link two nodes with validation
     function linkNodes(portA, portB) {
         if (canLinkNodes(portA, portB)) {
@@ -199,27 +276,25 @@ I_Scene {
         // Basic validation
         if (portA.length === 0 || portB.length === 0) return false;
 
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
 
         // Output can only connect to input
         if (portAObj.portType !== NLSpec.PortType.Output) return false;
         if (portBObj.portType !== NLSpec.PortType.Input) return false;
 
         // Prevent duplicate links
-        var sameLinks = Object.values(links).filter(link =>
-            link.inputPort._qsUuid === portA && link.outputPort._qsUuid === portB);
-        if (sameLinks.length > 0) return false;
+        if (_handles.hasLink(handleA, handleB)) return false;
 
         // Input port can only have one connection
-        var portBObjLinks = Object.values(links).filter(link =>
-            link.outputPort._qsUuid === portB);
-        if (portBObjLinks.length > 0) return false;
+        if (_handles.linkCountTo(handleB) > 0) return false;
 
         // Prevent self-connection
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
-        if (nodeA === nodeB) return false;
+        if (_handles.nodeOfPort(handleA) === _handles.nodeOfPort(handleB)) return false;
 
         return true;
     }
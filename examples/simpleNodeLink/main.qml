@@ -26,6 +26,9 @@ Window {
         defaultNode: 0
     }
 
+    //! The running progressive load (LoadFileCommand), null when idle
+    property var loadCommand: null
+
     /* Object Properties
      * ****************************************************************************************/
 
@@ -58,6 +61,18 @@ Window {
         //Set registry to scene
         window.scene = Qt.binding(function() { return NLCore.defaultRepo.qsRootObject;});
         window.scene.nodeRegistry = Qt.binding(function() { return window.nodeRegistry});
+
+        // Autosave data is left only by an unclean exit, offer to restore it
+        if (autosave.journal.hasRecoveryData())
+            recoveryDialog.open();
+        else
+            autosave.start();
+    }
+
+    // A clean exit leaves no recovery data
+    onClosing: {
+        autosave.stop();
+        autosave.discard();
     }
 
     /* Children
@@ -69,6 +84,30 @@ Window {
         anchors.fill: parent
     }
 
+    //! 1. Autosave: edits are journaled, the scene is checkpointed in the background
+    AutosaveJournal {
+        id: autosave
+        scene: window.scene
+
+        onRecovered: window.scene.nodeRegistry = Qt.binding(function() { return window.nodeRegistry});
+    }
+
+    MessageDialog {
+        id: recoveryDialog
+        title: qsTr("Restore Session")
+        text: qsTr("The last session did not end cleanly. Restore the autosaved scene?")
+        buttons: MessageDialog.Yes | MessageDialog.No
+
+        onButtonClicked: (button, role) => {
+            if (button === MessageDialog.Yes) {
+                autosave.recover();
+            } else {
+                autosave.discard();
+                autosave.start();
+            }
+        }
+    }
+
     //! 2. Save and load handlers
     Rectangle {
         anchors.left:  parent.left
@@ -114,6 +153,23 @@ Window {
 
     }
 
+    //! 3. Progress of a file load, Esc cancels it
+    ProgressBar {
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.top: parent.top
+        anchors.margins: 10
+
+        visible: window.loadCommand?.isLoading ?? false
+        value: window.loadCommand?.progress ?? 0
+    }
+
+    Shortcut {
+        sequence: "Esc"
+        enabled: window.loadCommand?.isLoading ?? false
+        onActivated: window.loadCommand.cancel()
+    }
+
     //Save
     FileDialog {
         id: saveDialog
@@ -121,7 +177,9 @@ Window {
         nameFilters: [ "QtQuickStream Files (*.QQS.json)" ]
         defaultSuffix: "QQS.json"
         onAccepted: {
-            NLCore.defaultRepo.saveToFile(saveDialog.selectedFile);
+            // The saved file holds the scene, the autosave starts over from it
+            if (NLCore.defaultRepo.saveToFile(saveDialog.selectedFile))
+                autosave.discard();
         }
     }
 
@@ -131,9 +189,9 @@ Window {
         fileMode: FileDialog.OpenFile
         nameFilters: [ "QtQuickStream Files (*.QQS.json)" ]
         onAccepted: {
-            NLCore.defaultRepo.clearObjects();
-            NLCore.defaultRepo.loadFromFile(loadDialog.selectedFile);
-//            window.scene = Qt.binding(function() { return NLCore.defaultRepo.qsRootObject;});
+            // The nodes, links and containers are read on a worker thread and added in chunks,
+            // the load can be undone
+            window.loadCommand = window.scene.loadFile(loadDialog.selectedFile, true);
         }
     }
 
@@ -0,0 +1,284 @@
+#include "ImagePipeline.h"
+
+#include <QDebug>
+#include <QVariantMap>
+#include <QtMath>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+//! Bytes of the rows of a tile, about the size of a core's cache
+constexpr qsizetype TileBytes = 256 * 1024;
+
+//! Tiles have at least this many rows per halo row, so the halos cost at most half a tile
+constexpr int HaloRatio = 4;
+
+std::array<uchar, 256> identityLut()
+{
+    std::array<uchar, 256> lut;
+    for (int value = 0; value < 256; ++value)
+        lut[value] = uchar(value);
+    return lut;
+}
+}
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*!
+ * The per-pixel stages are the same formulas as the single operations (brightness adds
+ * level * 255, contrast scales around 128) applied to the table, so a fused table gives the
+ * same values as the operations one after the other.
+ */
+ImagePipeline::ImagePipeline(const QVector<Stage> &stages)
+{
+    QStringList descriptions;
+    QStringList lutDescription;
+
+    auto closeLut = [&]() {
+        if (!lutDescription.isEmpty())
+            descriptions << "lut:" + lutDescription.join(',');
+        lutDescription.clear();
+    };
+
+    for (const Stage &stage : stages) {
+        if (stage.operation == Operation::Blur) {
+            const int radius = stage.value < 0.1 ? 0 : qRound(stage.value);
+            if (radius < 1)
+                continue;
+
+            closeLut();
+            Step step;
+            step.radius = radius;
+            mSteps.append(step);
+            descriptions << QString("blur:%1").arg(radius);
+            continue;
+        }
+
+        if (qAbs(stage.value) < 0.01)
+            continue;
+
+        if (mSteps.isEmpty() || mSteps.last().radius > 0) {
+            Step step;
+            step.lut = identityLut();
+            mSteps.append(step);
+        }
+
+        std::array<uchar, 256> &lut = mSteps.last().lut;
+        if (stage.operation == Operation::Brightness) {
+            const int adjustment = qRound(stage.value * 255.0);
+            for (uchar &value : lut)
+                value = uchar(qBound(0, value + adjustment, 255));
+            lutDescription << QString("brightness:%1").arg(stage.value, 0, 'g', 17);
+        } else {
+            const qreal factor = stage.value + 1.0;
+            for (uchar &value : lut)
+                value = uchar(qBound(0, qRound(factor * (value - 128) + 128), 255));
+            lutDescription << QString("contrast:%1").arg(stage.value, 0, 'g', 17);
+        }
+    }
+    closeLut();
+
+    mDescription = descriptions.join(';');
+}
+
+ImagePipeline ImagePipeline::fromVariant(const QVariantList &stages)
+{
+    QVector<Stage> result;
+    for (const QVariant &item : stages) {
+        const QVariantMap stage = item.toMap();
+        const QString kernel = stage.value("kernel").toString();
+        const qreal   value  = stage.value("value").toReal();
+
+        if (kernel == "blur")
+            result.append({ Operation::Blur, value });
+        else if (kernel == "brightness")
+            result.append({ Operation::Brightness, value });
+        else if (kernel == "contrast")
+            result.append({ Operation::Contrast, value });
+        else
+            qWarning() << "ImagePipeline: Unknown stage" << kernel;
+    }
+
+    return ImagePipeline(result);
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+bool ImagePipeline::isIdentity() const
+{
+    return mSteps.isEmpty();
+}
+
+int ImagePipeline::halo() const
+{
+    int rows = 0;
+    for (const Step &step : mSteps)
+        rows += step.radius;
+    return rows;
+}
+
+QString ImagePipeline::description() const
+{
+    return mDescription;
+}
+
+/*!
+ * A tile of output rows [first, last) reads the rows [first - halo, last + halo). Each blur
+ * clamps to the edges of the buffer, which spoils radius rows at a buffer edge that is not an
+ * image edge; the halo is the sum of the radii, so the output rows are never spoiled.
+ *
+ * \return the processed image (ARGB32), the source itself if no stage changes it
+ */
+QImage ImagePipeline::process(const QImage &source) const
+{
+    if (source.isNull() || isIdentity())
+        return source;
+
+    const int width  = source.width();
+    const int height = source.height();
+
+    QImage result(width, height, QImage::Format_ARGB32);
+    if (result.isNull()) {
+        qWarning() << "ImagePipeline: Cannot allocate the output image" << source.size();
+        return QImage();
+    }
+
+    const int halo     = this->halo();
+    const int tileRows = std::max<qsizetype>({ 1, TileBytes / (qsizetype(width) * 4),
+                                               qsizetype(HaloRatio) * halo });
+    const int bufferRows = std::min(height, tileRows + 2 * halo);
+
+    std::vector<QRgb> buffer(size_t(bufferRows) * width);
+    std::vector<QRgb> scratch(halo > 0 ? buffer.size() : 0);
+    QVector<int>      sums;
+
+    for (int first = 0; first < height; first += tileRows) {
+        const int last   = std::min(height, first + tileRows);
+        const int top    = std::max(0, first - halo);
+        const int bottom = std::min(height, last + halo);
+        const int rows   = bottom - top;
+
+        loadRows(source, top, rows, buffer.data());
+
+        for (const Step &step : mSteps) {
+            if (step.radius > 0)
+                blur(step.radius, width, rows, buffer.data(), scratch.data(), sums);
+            else
+                applyLut(step.lut, buffer.data(), qsizetype(rows) * width);
+        }
+
+        for (int row = first; row < last; ++row)
+            std::memcpy(result.scanLine(row), buffer.data() + size_t(row - top) * width,
+                        size_t(width) * sizeof(QRgb));
+    }
+
+    return result;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+/*!
+ * ARGB32 and RGB32 rows are copied, other formats are converted per tile.
+ */
+void ImagePipeline::loadRows(const QImage &source, int first, int count, QRgb *buffer)
+{
+    const int width = source.width();
+
+    QImage converted;
+    const QImage *rows = &source;
+    int rowOffset = first;
+    if (source.format() != QImage::Format_ARGB32 && source.format() != QImage::Format_RGB32) {
+        converted = source.copy(0, first, width, count).convertToFormat(QImage::Format_ARGB32);
+        rows      = &converted;
+        rowOffset = 0;
+    }
+
+    for (int row = 0; row < count; ++row)
+        std::memcpy(buffer + size_t(row) * width, rows->constScanLine(rowOffset + row),
+                    size_t(width) * sizeof(QRgb));
+
+    // The alpha byte of RGB32 is not guaranteed to be 0xff in memory
+    if (rows->format() == QImage::Format_RGB32) {
+        for (qsizetype index = 0; index < qsizetype(count) * width; ++index)
+            buffer[index] |= 0xff000000;
+    }
+}
+
+void ImagePipeline::applyLut(const std::array<uchar, 256> &lut, QRgb *pixels, qsizetype count)
+{
+    for (qsizetype index = 0; index < count; ++index) {
+        const QRgb pixel = pixels[index];
+        pixels[index] = qRgba(lut[qRed(pixel)], lut[qGreen(pixel)], lut[qBlue(pixel)], qAlpha(pixel));
+    }
+}
+
+/*!
+ * Horizontal then vertical pass with running sums: each pixel is the integer average of the
+ * 2 * radius + 1 pixels around it, positions outside the buffer are clamped to its edges.
+ */
+void ImagePipeline::blur(int radius, int width, int rows, QRgb *pixels, QRgb *scratch,
+                         QVector<int> &sums)
+{
+    const int count = 2 * radius + 1;
+
+    // Horizontal pass: pixels -> scratch
+    for (int row = 0; row < rows; ++row) {
+        const QRgb *in  = pixels + size_t(row) * width;
+        QRgb       *out = scratch + size_t(row) * width;
+
+        int r = 0, g = 0, b = 0, a = 0;
+        for (int dx = -radius; dx <= radius; ++dx) {
+            const QRgb pixel = in[qBound(0, dx, width - 1)];
+            r += qRed(pixel);
+            g += qGreen(pixel);
+            b += qBlue(pixel);
+            a += qAlpha(pixel);
+        }
+
+        for (int x = 0; x < width; ++x) {
+            out[x] = qRgba(r / count, g / count, b / count, a / count);
+
+            const QRgb added   = in[std::min(x + radius + 1, width - 1)];
+            const QRgb removed = in[std::max(x - radius, 0)];
+            r += qRed(added)   - qRed(removed);
+            g += qGreen(added) - qGreen(removed);
+            b += qBlue(added)  - qBlue(removed);
+            a += qAlpha(added) - qAlpha(removed);
+        }
+    }
+
+    // Vertical pass: scratch -> pixels, one running sum per column and channel
+    sums.fill(0, width * 4);
+    int *sum = sums.data();
+
+    auto addRow = [&](int row, int sign) {
+        const QRgb *in = scratch + size_t(qBound(0, row, rows - 1)) * width;
+        for (int x = 0; x < width; ++x) {
+            sum[4 * x]     += sign * qRed(in[x]);
+            sum[4 * x + 1] += sign * qGreen(in[x]);
+            sum[4 * x + 2] += sign * qBlue(in[x]);
+            sum[4 * x + 3] += sign * qAlpha(in[x]);
+        }
+    };
+
+    for (int dy = -radius; dy <= radius; ++dy)
+        addRow(dy, 1);
+
+    for (int row = 0; row < rows; ++row) {
+        QRgb *out = pixels + size_t(row) * width;
+        for (int x = 0; x < width; ++x)
+            out[x] = qRgba(sum[4 * x] / count, sum[4 * x + 1] / count,
+                           sum[4 * x + 2] / count, sum[4 * x + 3] / count);
+
+        addRow(row + radius + 1, 1);
+        addRow(row - radius, -1);
+    }
+}
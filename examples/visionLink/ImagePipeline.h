@@ -0,0 +1,86 @@
+#ifndef IMAGEPIPELINE_H
+#define IMAGEPIPELINE_H
+
+#include <QImage>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+
+#include <array>
+
+/*! ***********************************************************************************************
+ * ImagePipeline runs a chain of image operations as one pass over the image:
+ *      - consecutive per-pixel operations (brightness, contrast) are fused into one lookup table
+ *      - the image is processed in row tiles of about TileBytes, each tile is read with a halo of
+ *        the sum of the blur radii above and below, so the blurs of a tile need no other rows
+ *
+ * Only the output image is allocated, the intermediate results of the chain live in the tile
+ * buffers. The output is the same as running the operations one after the other (ARGB32).
+ * ************************************************************************************************/
+class ImagePipeline
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    enum class Operation {
+        Blur,
+        Brightness,
+        Contrast
+    };
+
+    struct Stage {
+        Operation operation;
+
+        //! Radius for blur, level (-1.0 to 1.0) for brightness and contrast
+        qreal     value;
+    };
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    //! Plans the stages: no-op stages are dropped, per-pixel runs are fused
+    explicit ImagePipeline(const QVector<Stage> &stages);
+
+    //! Stages from [{kernel: "blur" | "brightness" | "contrast", value}], unknown ones are skipped
+    static ImagePipeline fromVariant(const QVariantList &stages);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! No stage changes the image
+    bool    isIdentity() const;
+
+    //! Rows read above and below a tile
+    int     halo() const;
+
+    //! Description of the planned stages (e.g. "blur:5;lut:brightness:0.2,contrast:0.1"),
+    //! equal descriptions give equal outputs
+    QString description() const;
+
+    QImage  process(const QImage &source) const;
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Step {
+        //! Box blur radius, 0 for a lookup table step
+        int                     radius = 0;
+        std::array<uchar, 256>  lut;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Rows [first, first + count) of source as ARGB32 into buffer
+    static void loadRows(const QImage &source, int first, int count, QRgb *buffer);
+
+    static void applyLut(const std::array<uchar, 256> &lut, QRgb *pixels, qsizetype count);
+
+    //! Box blur of width x rows pixels, the rows outside the buffer are clamped to its edges
+    static void blur(int radius, int width, int rows, QRgb *pixels, QRgb *scratch,
+                     QVector<int> &sums);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QVector<Step> mSteps;
+    QString       mDescription;
+};
+
+#endif // IMAGEPIPELINE_H
@@ -1,5 +1,9 @@
 #include "ImageProcessor.h"
+#include "GraphExecutorCPP.h"
+#include "ImagePipeline.h"
+#include "NodeOutputCache.h"
 #include <QBuffer>
+#include <QCoreApplication>
 #include <QByteArray>
 #include <QPainter>
 #include <QDebug>
@@ -23,7 +27,7 @@ ImageProcessor::ImageProcessor(QObject *parent)
 
 /*!
  * Load image from file path and return as QVariant.
- * Handles file:// URL prefix cleanup and ensures detached image copy.
+ * Handles file:// URL prefix cleanup.
  * 
  * \param path is the file path or URL to the image file
  * \return QVariant containing loaded QImage, or invalid QVariant on failure
@@ -46,11 +50,8 @@ QVariant ImageProcessor::loadImage(const QString &path)
         return QVariant();
     }
 
-    // Ensure the image is detached and has its own data
-    // This prevents issues with shallow copies across C++/QML boundary
-    QImage detachedImage = image.copy();
-    
-    return imageToVariant(detachedImage);
+    // The loaded image owns its data, copies across the C++/QML boundary share it
+    return imageToVariant(image);
 }
 
 /*!
@@ -62,6 +63,14 @@ QVariant ImageProcessor::loadImage(const QString &path)
  */
 QVariant ImageProcessor::applyBlur(const QVariant &imageData, qreal radius)
 {
+    // Radii that round to the same box share an output, no-op radii are not cached
+    const QString key = radius < 0.1 ? QString()
+                                     : NodeOutputCache::fingerprint("blur", qRound(radius), imageData);
+    QImage cached;
+    if (NodeOutputCache::instance()->find(key, cached)) {
+        return imageToVariant(cached);
+    }
+
     QImage image = variantToImage(imageData);
     
     if (image.isNull()) {
@@ -74,6 +83,7 @@ QVariant ImageProcessor::applyBlur(const QVariant &imageData, qreal radius)
     }
     
     QImage result = boxBlur(image, qRound(radius));
+    NodeOutputCache::instance()->insert(key, result);
     
     return imageToVariant(result);
 }
@@ -87,6 +97,13 @@ QVariant ImageProcessor::applyBlur(const QVariant &imageData, qreal radius)
  */
 QVariant ImageProcessor::applyBrightness(const QVariant &imageData, qreal level)
 {
+    const QString key = qAbs(level) < 0.01 ? QString()
+                                           : NodeOutputCache::fingerprint("brightness", level, imageData);
+    QImage cached;
+    if (NodeOutputCache::instance()->find(key, cached)) {
+        return imageToVariant(cached);
+    }
+
     QImage image = variantToImage(imageData);
     
     if (image.isNull()) {
@@ -99,6 +116,7 @@ QVariant ImageProcessor::applyBrightness(const QVariant &imageData, qreal level)
     }
     
     QImage result = adjustBrightness(image, level);
+    NodeOutputCache::instance()->insert(key, result);
     
     return imageToVariant(result);
 }
@@ -112,6 +130,13 @@ QVariant ImageProcessor::applyBrightness(const QVariant &imageData, qreal level)
  */
 QVariant ImageProcessor::applyContrast(const QVariant &imageData, qreal level)
 {
+    const QString key = qAbs(level) < 0.01 ? QString()
+                                           : NodeOutputCache::fingerprint("contrast", level, imageData);
+    QImage cached;
+    if (NodeOutputCache::instance()->find(key, cached)) {
+        return imageToVariant(cached);
+    }
+
     QImage image = variantToImage(imageData);
     
     if (image.isNull()) {
@@ -124,10 +149,50 @@ QVariant ImageProcessor::applyContrast(const QVariant &imageData, qreal level)
     }
     
     QImage result = adjustContrast(image, level);
+    NodeOutputCache::instance()->insert(key, result);
     
     return imageToVariant(result);
 }
 
+/*!
+ * Apply a chain of operations in one tiled pass, see ImagePipeline. Only the output of the
+ * chain is allocated and cached.
+ *
+ * \param imageData is the QVariant containing input QImage
+ * \param stages is the list of operations [{kernel: "blur" | "brightness" | "contrast", value}]
+ * \return QVariant containing the processed QImage, or invalid QVariant on failure
+ */
+QVariant ImageProcessor::applyPipeline(const QVariant &imageData, const QVariantList &stages)
+{
+    const ImagePipeline pipeline = ImagePipeline::fromVariant(stages);
+
+    // Chains with equal planned stages share an output, no-op chains are not cached
+    const QString key = pipeline.isIdentity()
+                            ? QString()
+                            : NodeOutputCache::fingerprint("pipeline:" + pipeline.description(),
+                                                           0, imageData);
+    QImage cached;
+    if (NodeOutputCache::instance()->find(key, cached)) {
+        return imageToVariant(cached);
+    }
+
+    QImage image = variantToImage(imageData);
+
+    if (image.isNull()) {
+        qWarning() << "ImageProcessor: Invalid image data for pipeline";
+        return QVariant();
+    }
+
+    if (pipeline.isIdentity()) {
+        return imageData; // No change needed
+    }
+
+    QImage result = pipeline.process(image);
+    NodeOutputCache::instance()->insert(key, result);
+
+    return imageToVariant(result);
+}
+
 /*!
  * Convert image to base64 data URL for QML Image component.
  * 
@@ -165,25 +230,80 @@ bool ImageProcessor::isValidImage(const QVariant &imageData) const
     return !image.isNull();
 }
 
+/* ************************************************************************************************
+ * Graph Executor Kernels
+ * ************************************************************************************************/
+
+/*!
+ * Register the image operations as GraphExecutor kernels. The processing functions keep no
+ * state, so every kernel call uses its own ImageProcessor and runs on any pool thread.
+ *
+ * Kernel inputs: [image], params: {radius} for blur, {level} for brightness and contrast,
+ * {stages} for pipeline.
+ */
+void ImageProcessor::registerKernels()
+{
+    // The kernels share the output cache, create it on the GUI thread
+    NodeOutputCache::instance();
+
+    using Operation = QVariant (ImageProcessor::*)(const QVariant &, qreal);
+
+    auto makeKernel = [](Operation operation, const QString &paramName) {
+        return [operation, paramName](const QVariantList &inputs, const QVariantMap &params) {
+            QVariant input = inputs.value(0);
+            if (input.typeId() == QMetaType::QString || input.typeId() == QMetaType::QUrl) {
+                ImageProcessor loader;
+                input = loader.loadImage(input.toString());
+            }
+
+            // No input is not an error, the node is just not connected yet
+            if (!input.canConvert<QImage>() || input.value<QImage>().isNull())
+                return QVariant();
+
+            ImageProcessor processor;
+            return (processor.*operation)(input, params.value(paramName).toReal());
+        };
+    };
+
+    // Fused chain of operations, params: {stages: [{kernel, value}]}
+    GraphExecutorCPP::registerKernel("pipeline", [](const QVariantList &inputs, const QVariantMap &params) {
+        QVariant input = inputs.value(0);
+        if (input.typeId() == QMetaType::QString || input.typeId() == QMetaType::QUrl) {
+            ImageProcessor loader;
+            input = loader.loadImage(input.toString());
+        }
+
+        if (!input.canConvert<QImage>() || input.value<QImage>().isNull())
+            return QVariant();
+
+        ImageProcessor processor;
+        return processor.applyPipeline(input, params.value("stages").toList());
+    });
+
+    GraphExecutorCPP::registerKernel("blur",       makeKernel(&ImageProcessor::applyBlur,       "radius"));
+    GraphExecutorCPP::registerKernel("brightness", makeKernel(&ImageProcessor::applyBrightness, "level"));
+    GraphExecutorCPP::registerKernel("contrast",   makeKernel(&ImageProcessor::applyContrast,   "level"));
+}
+
+// Registered in every application that links the VisionLink module (VisionLink, nodelink-run)
+Q_COREAPP_STARTUP_FUNCTION(ImageProcessor::registerKernels)
+
 /* ************************************************************************************************
  * Private Helper Functions
  * ************************************************************************************************/
 
 /*!
- * Convert QVariant to QImage with detached copy.
- * This ensures proper memory management across C++/QML boundary.
+ * Convert QVariant to QImage.
+ * The image shares the data of the QVariant, the operations never write to their input
+ * (QImage copies on write, with a thread-safe reference count).
  *
  * \param imageData is the QVariant containing QImage data
- * \return QImage with detached data, or null QImage if conversion fails
+ * \return QImage sharing the data, or null QImage if conversion fails
  */
 QImage ImageProcessor::variantToImage(const QVariant &imageData) const
 {
     if (imageData.canConvert<QImage>()) {
-        QImage image = imageData.value<QImage>();
-        // Ensure we have a detached copy
-        if (!image.isNull()) {
-            return image.copy();
-        }
+        return imageData.value<QImage>();
     }
     return QImage();
 }
@@ -201,7 +321,7 @@ QVariant ImageProcessor::imageToVariant(const QImage &image) const
 
 /*!
  * Apply box blur algorithm with given radius.
- * Performs horizontal and vertical blur passes for improved performance.
+ * Runs the horizontal and vertical passes tile by tile (ImagePipeline).
  * 
  * \param source is the input QImage
  * \param radius is the blur radius in pixels
@@ -209,60 +329,7 @@ QVariant ImageProcessor::imageToVariant(const QImage &image) const
  */
 QImage ImageProcessor::boxBlur(const QImage &source, int radius)
 {
-    if (radius < 1) {
-        return source;
-    }
-    
-    QImage result = source.convertToFormat(QImage::Format_ARGB32);
-    
-    int width = result.width();
-    int height = result.height();
-    
-    // Horizontal pass
-    QImage temp(width, height, QImage::Format_ARGB32);
-    
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int r = 0, g = 0, b = 0, a = 0;
-            int count = 0;
-            
-            for (int dx = -radius; dx <= radius; ++dx) {
-                int xx = qBound(0, x + dx, width - 1);
-                QRgb pixel = result.pixel(xx, y);
-                
-                r += qRed(pixel);
-                g += qGreen(pixel);
-                b += qBlue(pixel);
-                a += qAlpha(pixel);
-                count++;
-            }
-            
-            temp.setPixel(x, y, qRgba(r / count, g / count, b / count, a / count));
-        }
-    }
-    
-    // Vertical pass
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            int r = 0, g = 0, b = 0, a = 0;
-            int count = 0;
-            
-            for (int dy = -radius; dy <= radius; ++dy) {
-                int yy = qBound(0, y + dy, height - 1);
-                QRgb pixel = temp.pixel(x, yy);
-                
-                r += qRed(pixel);
-                g += qGreen(pixel);
-                b += qBlue(pixel);
-                a += qAlpha(pixel);
-                count++;
-            }
-            
-            result.setPixel(x, y, qRgba(r / count, g / count, b / count, a / count));
-        }
-    }
-    
-    return result;
+    return ImagePipeline({ { ImagePipeline::Operation::Blur, qreal(radius) } }).process(source);
 }
 
 /*!
@@ -274,28 +341,7 @@ QImage ImageProcessor::boxBlur(const QImage &source, int radius)
  */
 QImage ImageProcessor::adjustBrightness(const QImage &source, qreal level)
 {
-    QImage result = source.convertToFormat(QImage::Format_ARGB32);
-    
-    int width = result.width();
-    int height = result.height();
-    
-    // level range: -1.0 to 1.0
-    // Convert to adjustment value: -255 to 255
-    int adjustment = qRound(level * 255.0);
-    
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QRgb pixel = result.pixel(x, y);
-            
-            int r = qBound(0, qRed(pixel) + adjustment, 255);
-            int g = qBound(0, qGreen(pixel) + adjustment, 255);
-            int b = qBound(0, qBlue(pixel) + adjustment, 255);
-            
-            result.setPixel(x, y, qRgba(r, g, b, qAlpha(pixel)));
-        }
-    }
-    
-    return result;
+    return ImagePipeline({ { ImagePipeline::Operation::Brightness, level } }).process(source);
 }
 
 /*!
@@ -307,29 +353,5 @@ QImage ImageProcessor::adjustBrightness(const QImage &source, qreal level)
  */
 QImage ImageProcessor::adjustContrast(const QImage &source, qreal level)
 {
-    QImage result = source.convertToFormat(QImage::Format_ARGB32);
-    
-    int width = result.width();
-    int height = result.height();
-    
-    // level range: -1.0 to 1.0
-    // Convert to contrast factor: 0.0 to 2.0
-    qreal factor = (level + 1.0);
-    
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QRgb pixel = result.pixel(x, y);
-            
-            // Apply contrast formula: newValue = factor * (oldValue - 128) + 128
-            int r = qBound(0, qRound(factor * (qRed(pixel) - 128) + 128), 255);
-            int g = qBound(0, qRound(factor * (qGreen(pixel) - 128) + 128), 255);
-            int b = qBound(0, qRound(factor * (qBlue(pixel) - 128) + 128), 255);
-            
-            result.setPixel(x, y, qRgba(r, g, b, qAlpha(pixel)));
-        }
-    }
-    
-    return result;
+    return ImagePipeline({ { ImagePipeline::Operation::Contrast, level } }).process(source);
 }
-
-
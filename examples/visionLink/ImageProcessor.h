@@ -6,6 +6,7 @@
 #include <QString>
 #include <QUrl>
 #include <QVariant>
+#include <QVariantList>
 #include <QQmlEngine>
 #include <QJSEngine>
 
@@ -39,9 +40,18 @@ public:
     Q_INVOKABLE QVariant applyBlur(const QVariant &imageData, qreal radius);
     Q_INVOKABLE QVariant applyBrightness(const QVariant &imageData, qreal level);
     Q_INVOKABLE QVariant applyContrast(const QVariant &imageData, qreal level);
+
+    //! Apply a chain of operations [{kernel, value}] in one tiled pass
+    Q_INVOKABLE QVariant applyPipeline(const QVariant &imageData, const QVariantList &stages);
+
     Q_INVOKABLE QString saveToDataUrl(const QVariant &imageData);
     Q_INVOKABLE bool isValidImage(const QVariant &imageData) const;
 
+    /* Graph Executor Kernels
+     * ****************************************************************************************/
+    //! Register blur, brightness, contrast and pipeline as thread-safe GraphExecutor kernels
+    static void registerKernels();
+
 private:
     /* Private Helper Functions
      * ****************************************************************************************/
@@ -0,0 +1,167 @@
+#include "NodeOutputCache.h"
+
+#include <QMutexLocker>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor, 256 MB budget
+ * ************************************************************************************************/
+NodeOutputCache::NodeOutputCache(QObject *parent)
+    : QObject(parent)
+    , mOutputs(256 * 1024 * 1024)
+    , mHits(0)
+    , mMisses(0)
+    , mNotifyPosted(false)
+{
+}
+
+/* ************************************************************************************************
+ * Singleton Instance Provider
+ * ************************************************************************************************/
+
+NodeOutputCache *NodeOutputCache::instance()
+{
+    static NodeOutputCache cache;
+    return &cache;
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * The input is identified by QImage::cacheKey(), which is shared by all copies of an image until
+ * one of them is modified. Outputs taken from the cache keep their key, so a chain of cached
+ * operations hits all the way down.
+ *
+ * \param operation is the operation name, e.g. "blur"
+ * \param parameter is the normalized operation parameter (equal parameters, equal outputs)
+ * \param input is the QVariant containing the input QImage
+ */
+QString NodeOutputCache::fingerprint(const QString &operation, qreal parameter,
+                                     const QVariant &input)
+{
+    if (!input.canConvert<QImage>())
+        return QString();
+
+    const QImage image = input.value<QImage>();
+    if (image.isNull())
+        return QString();
+
+    return QString("%1|%2|%3").arg(operation)
+                              .arg(parameter, 0, 'g', 17)
+                              .arg(image.cacheKey());
+}
+
+bool NodeOutputCache::find(const QString &key, QImage &output)
+{
+    if (key.isEmpty())
+        return false;
+
+    {
+        QMutexLocker locker(&mMutex);
+        const QImage *cached = mOutputs.object(key);
+        if (cached)
+            output = *cached;
+    }
+
+    if (output.isNull())
+        ++mMisses;
+    else
+        ++mHits;
+
+    notifyStatsChanged();
+    return !output.isNull();
+}
+
+void NodeOutputCache::insert(const QString &key, const QImage &output)
+{
+    if (key.isEmpty() || output.isNull())
+        return;
+
+    {
+        QMutexLocker locker(&mMutex);
+        // QCache deletes the copy itself if it does not fit
+        mOutputs.insert(key, new QImage(output), output.sizeInBytes());
+    }
+
+    notifyStatsChanged();
+}
+
+void NodeOutputCache::clear()
+{
+    {
+        QMutexLocker locker(&mMutex);
+        mOutputs.clear();
+    }
+
+    notifyStatsChanged();
+}
+
+void NodeOutputCache::resetCounters()
+{
+    mHits   = 0;
+    mMisses = 0;
+
+    notifyStatsChanged();
+}
+
+qint64 NodeOutputCache::byteBudget() const
+{
+    QMutexLocker locker(&mMutex);
+    return mOutputs.maxCost();
+}
+
+void NodeOutputCache::setByteBudget(qint64 byteBudget)
+{
+    {
+        QMutexLocker locker(&mMutex);
+        if (mOutputs.maxCost() == byteBudget)
+            return;
+
+        // Evicts the least recently used outputs right away
+        mOutputs.setMaxCost(byteBudget);
+    }
+
+    emit byteBudgetChanged();
+    notifyStatsChanged();
+}
+
+qint64 NodeOutputCache::usedBytes() const
+{
+    QMutexLocker locker(&mMutex);
+    return mOutputs.totalCost();
+}
+
+int NodeOutputCache::entryCount() const
+{
+    QMutexLocker locker(&mMutex);
+    return mOutputs.count();
+}
+
+qint64 NodeOutputCache::hits() const
+{
+    return mHits;
+}
+
+qint64 NodeOutputCache::misses() const
+{
+    return mMisses;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+void NodeOutputCache::notifyStatsChanged()
+{
+    if (mNotifyPosted.exchange(true))
+        return;
+
+    QMetaObject::invokeMethod(this, [this]() {
+        mNotifyPosted = false;
+        emit statsChanged();
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,100 @@
+#ifndef NODEOUTPUTCACHE_H
+#define NODEOUTPUTCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QVariant>
+#include <QQmlEngine>
+#include <QJSEngine>
+
+#include <atomic>
+
+/*! ***********************************************************************************************
+ * NodeOutputCache memoises the outputs of the image operations. An output is keyed by the
+ * fingerprint of the operation, its parameter and the identity of the input image
+ * (QImage::cacheKey()), so going back to a previous parameter set (undo, a slider moved back)
+ * returns the previous output, and unchanged downstream outputs are found as well.
+ *
+ * Entries are evicted least recently used first when their size exceeds byteBudget.
+ * The cache is shared by the QML processing functions and the GraphExecutor kernels and is
+ * safe to use from any thread.
+ * ************************************************************************************************/
+class NodeOutputCache : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(NodeOutputCacheCPP)
+    QML_SINGLETON
+
+    Q_PROPERTY(qint64 byteBudget READ byteBudget WRITE setByteBudget NOTIFY byteBudgetChanged)
+    Q_PROPERTY(qint64 usedBytes  READ usedBytes  NOTIFY statsChanged)
+    Q_PROPERTY(int    entryCount READ entryCount NOTIFY statsChanged)
+    Q_PROPERTY(qint64 hits       READ hits       NOTIFY statsChanged)
+    Q_PROPERTY(qint64 misses     READ misses     NOTIFY statsChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit NodeOutputCache(QObject *parent = nullptr);
+
+    /* Singleton Instance Provider
+     * ****************************************************************************************/
+    //! Process-wide cache, also used by the kernel threads
+    static NodeOutputCache *instance();
+
+    //! The QML singleton is the process-wide cache, it stays owned by C++
+    static NodeOutputCache* create(QQmlEngine *qmlEngine, QJSEngine *jsEngine)
+    {
+        Q_UNUSED(qmlEngine);
+        Q_UNUSED(jsEngine);
+        QJSEngine::setObjectOwnership(instance(), QJSEngine::CppOwnership);
+        return instance();
+    }
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Key of an operation output, empty if the input is not an image
+    static QString fingerprint(const QString &operation, qreal parameter, const QVariant &input);
+
+    //! Find a cached output, counts a hit or a miss
+    bool find(const QString &key, QImage &output);
+
+    //! Store an output, ignored if it alone exceeds byteBudget
+    void insert(const QString &key, const QImage &output);
+
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE void resetCounters();
+
+    qint64 byteBudget() const;
+    void   setByteBudget(qint64 byteBudget);
+
+    qint64 usedBytes() const;
+    int    entryCount() const;
+    qint64 hits() const;
+    qint64 misses() const;
+
+signals:
+    void byteBudgetChanged();
+    void statsChanged();
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    //! statsChanged() once per event loop iteration, on the cache thread
+    void notifyStatsChanged();
+
+    /* Attributes
+     * ****************************************************************************************/
+    mutable QMutex           mMutex;
+
+    //! LRU of outputs, cost in bytes
+    QCache<QString, QImage>  mOutputs;
+
+    std::atomic<qint64>      mHits;
+    std::atomic<qint64>      mMisses;
+    std::atomic<bool>        mNotifyPosted;
+};
+
+#endif // NODEOUTPUTCACHE_H
@@ -24,6 +24,10 @@ QtObject {
     function applyContrast(imageData, level) {
         return ImageProcessorCPP.applyContrast(imageData, level);
     }
+
+    function applyPipeline(imageData, stages) {
+        return ImageProcessorCPP.applyPipeline(imageData, stages);
+    }
     
     function saveToDataUrl(imageData) {
         return ImageProcessorCPP.saveToDataUrl(imageData);
@@ -11,5 +11,8 @@ I_NodeData {
      * ****************************************************************************************/
     //! Input image data (can be file path or data URL)
     property var input: null
+
+    //! The output was streamed into the next operation of a fused chain and is not kept
+    property bool _streamed: false
 }
 
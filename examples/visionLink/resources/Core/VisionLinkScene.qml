@@ -57,6 +57,9 @@ I_Scene {
             existObjects: [...Object.keys(nodes), ...Object.keys(links), ...Object.keys(containers)]
         }
 
+    //! Headless runs wait for the executor
+    _evaluating: _executor.busy
+
     /* Property Declarations
      * ****************************************************************************************/
     //! Undo Core
@@ -72,18 +75,28 @@ I_Scene {
         onTriggered: scene.updateData();
     }
 
+    //! Evaluates the image operations on a thread pool
+    property GraphExecutor _executor: GraphExecutor {
+        onNodesEvaluated: (results) => scene._applyResults(results)
+        onFinished: (stats) => scene.evaluationStats = stats
+    }
+
+    //! Stats of the last evaluation, see GraphExecutor.finished()
+    property var evaluationStats: ({})
+
     /* Children
     * ****************************************************************************************/
     //! update node data when a link removed, node removed and link added.
     onLinkRemoved: _upateDataTimer.start();
     onNodeRemoved: _upateDataTimer.start();
     onLinkAdded:   updateData();
+    onLinksAdded:  updateData();
 
     /* Functions
      * ****************************************************************************************/
     //! Create a node with node type and its position
     function createCustomizeNode(nodeType : int, xPos : real, yPos : real) : string {
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(scene.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (scene._nodeIndex.typeCount(nodeType) + 1);
         return createSpecificNode(nodeRegistry.imports, nodeType,
                                   nodeRegistry.nodeTypes[nodeType],
                                   nodeRegistry.nodeColors[nodeType],
@@ -118,193 +131,266 @@ I_Scene {
         if (portA.length === 0 || portB.length === 0)
             return false;
 
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+
         // Just a input port can be link to output port
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
         if (portAObj.portType === NLSpec.PortType.Input)
             return false;
         if (portBObj.portType === NLSpec.PortType.Output)
             return false;
 
         // Find exist links with portA as input port and portB as output port.
-        var sameLinks = Object.values(links).filter(link =>
-            HashCompareString.compareStringModels(link.inputPort._qsUuid, portA) &&
-            HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-
-        if (sameLinks.length > 0)
+        if (_handles.hasLink(handleA, handleB))
             return false;
 
         // An input port can accept only a single link.
-        var portBObjLinks = Object.values(links).filter(link => HashCompareString.compareStringModels(link.outputPort._qsUuid, portB));
-        if (portBObjLinks.length)
+        if (_handles.linkCountTo(handleB) > 0)
             return false;
 
         // A node cannot establish a link with itself
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
-        if (HashCompareString.compareStringModels(nodeA, nodeB)
-                    || nodeA.length === 0 || nodeB.length === 0) {
+        var nodeA = _handles.nodeOfPort(handleA);
+        var nodeB = _handles.nodeOfPort(handleB);
+        if (nodeA === nodeB || nodeA === 0 || nodeB === 0)
             return false;
-        }
 
         // A node can be connect to another at one direction
-        var sameReverseLinks = Object.values(links).filter(link =>
-            findNodeId(link.outputPort._qsUuid) === nodeA &&
-            findNodeId(link.inputPort._qsUuid) === nodeB);
-
-        if (sameReverseLinks.length > 0)
+        if (_handles.hasNodeLink(nodeB, nodeA))
             return false;
 
         return true;
     }
 
-    //! Updata node data with connected links
-    function updateData() {
-        // Initialize node data for all operation and result nodes (reset them)
-        Object.values(nodes).forEach(node => {
-            switch (node.type) {
-                case CSpecs.NodeType.Blur:
-                case CSpecs.NodeType.Brightness:
-                case CSpecs.NodeType.Contrast:
-                     {
-                        node.nodeData.data = null;
-                        node.nodeData.input = null;
-                     } break;
-
-                case CSpecs.NodeType.ImageResult: {
-                        node.nodeData.data = null;
-                } break;
+    //! Evaluate the graph (headless runs), _evaluating is true until the executor has finished
+    function evaluate() {
+        updateData();
+    }
 
-                default: {
-                }
-         }
-        });
+    //! Updata node data with connected links, independent branches are evaluated in parallel
+    function updateData() {
+        var graph = _graphLinks();
 
-        // Get all links as an array
-        var allLinks = Object.values(links);
-        var processedLinks = [];
-        var remainingLinks = allLinks.slice(); // Copy all links
-        
-        var maxIterations = 100; // Prevent infinite loop
-        var iteration = 0;
-        
-        // Keep processing until all links are done or we hit max iterations
-        while (remainingLinks.length > 0 && iteration < maxIterations) {
-            iteration++;
-            
-            var linksProcessedThisIteration = [];
-            var linksStillWaiting = [];
-            
-            // Try to process each remaining link
-            remainingLinks.forEach(function(link) {
-                var portA = link.inputPort._qsUuid;
-                var portB = link.outputPort._qsUuid;
-
-                var upstreamNode   = findNode(portA);
-                var downStreamNode = findNode(portB);
-                
-                // Check if upstream node has data
-                var upstreamHasData = upstreamNode.nodeData.data !== null && 
-                                     upstreamNode.nodeData.data !== undefined;
-                
-                // ImageInput always has data (or should have it)
-                if (upstreamNode.type === CSpecs.NodeType.ImageInput) {
-                    upstreamHasData = true;
-                }
-                
-                if (upstreamHasData) {
-                    // Process this link now
-                    upadateNodeData(upstreamNode, downStreamNode);
-                    linksProcessedThisIteration.push(link);
-                } else {
-                    // Can't process yet, upstream doesn't have data
-                    linksStillWaiting.push(link);
-                }
-            });
-            
-            // Update remaining links for next iteration
-            remainingLinks = linksStillWaiting;
-            
-            // If no links were processed in this iteration, we can't make progress
-            if (linksProcessedThisIteration.length === 0) {
-                console.warn("No links processed in iteration", iteration, "- breaking");
-                if (remainingLinks.length > 0) {
-                    console.warn("Could not process", remainingLinks.length, "links - check for missing data");
-                }
-                break;
-            }
-        }
-        
-        if (iteration >= maxIterations) {
-            console.error("Max iterations reached! Possible circular dependency");
-        }
+        _run(Object.values(nodes).map(node => _nodeSpec(node)), graph.links);
     }
 
     //! Update only downstream nodes from a specific starting node
     function updateDataFromNode(startingNode: Node) {
-        
-        // First, update the starting node itself (it may need to recalculate with new parameters)
-        if (startingNode.type === CSpecs.NodeType.Blur ||
-            startingNode.type === CSpecs.NodeType.Brightness ||
-            startingNode.type === CSpecs.NodeType.Contrast) {
-            // Re-run the operation with current input and new parameters
-            startingNode.updataData();
+        var graph = _graphLinks();
+
+        // A streamed node has no output to start from, start at the head of its chain
+        var startId = startingNode._qsUuid;
+        while (graph.upstream[startId] && nodes[graph.upstream[startId]].nodeData._streamed)
+            startId = graph.upstream[startId];
+
+        // Starting node and everything downstream of it
+        var affected = {};
+        var queue = [startId];
+        while (queue.length > 0) {
+            var nodeId = queue.shift();
+            if (affected[nodeId])
+                continue;
+
+            affected[nodeId] = true;
+            (graph.downstream[nodeId] ?? []).forEach(downId => queue.push(downId));
         }
-        
-        // Find all downstream nodes and update them
-        var nodesToUpdate = [startingNode];
-        var processedNodes = [];
-        var maxIterations = 100;
-        var iteration = 0;
-        
-        while (nodesToUpdate.length > 0 && iteration < maxIterations) {
-            iteration++;
-            var currentNode = nodesToUpdate.shift(); // Get first node from queue
-            processedNodes.push(currentNode._qsUuid);
-            
-            // Find all links where this node is upstream (output)
-            var downstreamLinks = Object.values(links).filter(function(link) {
-                var upstreamNodeId = findNodeId(link.inputPort._qsUuid);
-                return upstreamNodeId === currentNode._qsUuid;
-            });
-                        
-            // Process each downstream link
-            downstreamLinks.forEach(function(link) {
-                var portB = link.outputPort._qsUuid;
-                var downStreamNode = findNode(portB);
-                
-                // Update the downstream node
-                upadateNodeData(currentNode, downStreamNode);
-                
-                // Add to queue if not already processed
-                if (processedNodes.indexOf(downStreamNode._qsUuid) === -1) {
-                    nodesToUpdate.push(downStreamNode);
+
+        var specs = Object.keys(affected).map(nodeId => _nodeSpec(nodes[nodeId]));
+        var sources = {};
+        var affectedLinks = graph.links.filter(link => affected[link.to]);
+        affectedLinks.forEach(link => {
+            // Unchanged upstream nodes feed their current data
+            if (affected[link.from] || sources[link.from])
+                return;
+
+            sources[link.from] = true;
+            specs.push({ id: link.from, value: nodes[link.from].nodeData.data });
+        });
+
+        _run(specs, affectedLinks);
+    }
+
+    //! Run the executor with the chains of image operations fused (see _fuseChains)
+    function _run(specs, graphLinks) {
+        var plan = _fuseChains(specs, graphLinks);
+
+        plan.streamed.forEach(nodeId => {
+            var nodeData = nodes[nodeId].nodeData;
+            nodeData.input     = null;
+            nodeData.data      = null;
+            nodeData._streamed = true;
+        });
+
+        _executor.run(plan.specs, plan.links, _evaluateOnGui);
+    }
+
+    //! Fuse chains of kernel nodes into one pipeline kernel: a node whose only consumer is the
+    //! next operation of the chain is streamed through it and not materialised. The last node
+    //! of a chain (feeding a result node, several nodes or none) keeps its output.
+    //! Returns {specs, links, streamed: [node ids]}
+    function _fuseChains(specs, graphLinks) {
+        if (!_executor.hasKernel("pipeline"))
+            return { specs: specs, links: graphLinks, streamed: [] };
+
+        var specOf = {};
+        specs.forEach(spec => specOf[spec.id] = spec);
+
+        var consumers = {};
+        var producer = {};
+        graphLinks.forEach(link => {
+            if (!consumers[link.from])
+                consumers[link.from] = [];
+            consumers[link.from].push(link.to);
+            producer[link.to] = link.from;
+        });
+
+        var fusible = nodeId => ["blur", "brightness", "contrast"].includes(specOf[nodeId]?.kernel);
+        var streamsInto = nodeId => fusible(nodeId) && consumers[nodeId]?.length === 1 &&
+                                    fusible(consumers[nodeId][0]);
+
+        // Node id -> id of the last node of its chain
+        var tailOf = {};
+        var fusedSpecs = [];
+        specs.forEach(spec => {
+            if (streamsInto(spec.id))
+                return;
+
+            var chain = [spec.id];
+            while (producer[chain[0]] && streamsInto(producer[chain[0]]))
+                chain.unshift(producer[chain[0]]);
+
+            if (chain.length === 1) {
+                fusedSpecs.push(spec);
+                return;
+            }
+
+            chain.forEach(nodeId => tailOf[nodeId] = spec.id);
+            fusedSpecs.push({
+                id: spec.id,
+                kernel: "pipeline",
+                params: {
+                    stages: chain.map(nodeId => {
+                        var params = specOf[nodeId].params;
+                        return { kernel: specOf[nodeId].kernel, value: params.radius ?? params.level };
+                    })
                 }
             });
-        }
+        });
+
+        var streamed = Object.keys(tailOf).filter(nodeId => tailOf[nodeId] !== nodeId);
+
+        // Links inside a chain are dropped, the link into its head feeds its last node
+        var fusedLinks = [];
+        graphLinks.forEach(link => {
+            if (tailOf[link.from] && tailOf[link.from] !== link.from)
+                return;
+
+            fusedLinks.push({ from: link.from, to: tailOf[link.to] ?? link.to });
+        });
+
+        return { specs: fusedSpecs, links: fusedLinks, streamed: streamed };
     }
 
-    //! Update node data
-    function upadateNodeData(upstreamNode: Node, downStreamNode: Node) {
-        switch (downStreamNode.type) {
-            // Update operation nodes data
-            case CSpecs.NodeType.Blur:
-            case CSpecs.NodeType.Brightness:
-            case CSpecs.NodeType.Contrast:
-                 {
-                    // Always update input from upstream node
-                    downStreamNode.nodeData.input = upstreamNode.nodeData.data;
-
-                    // Update downStreamNode data with specific operation
-                    downStreamNode.updataData();
-                 } break;
-
-            case CSpecs.NodeType.ImageResult: {
-                     downStreamNode.nodeData.data = upstreamNode.nodeData.data;
+    //! Links as [{from, to}] node ids, the downstream node ids and the upstream node id of each
+    //! node
+    function _graphLinks() {
+        var nodeIdOfPort = {};
+        Object.values(nodes).forEach(node => {
+            Object.keys(node.ports).forEach(portId => nodeIdOfPort[portId] = node._qsUuid);
+        });
+
+        var graphLinks = [];
+        var downstream = {};
+        var upstream = {};
+        Object.values(links).forEach(link => {
+            var from = nodeIdOfPort[link.inputPort._qsUuid];
+            var to   = nodeIdOfPort[link.outputPort._qsUuid];
+            if (!from || !to)
+                return;
+
+            graphLinks.push({ from: from, to: to });
+            if (!downstream[from])
+                downstream[from] = [];
+            downstream[from].push(to);
+            upstream[to] = from;
+        });
+
+        return { links: graphLinks, downstream: downstream, upstream: upstream };
+    }
+
+    //! Executor description of a node: image operations are thread-safe C++ kernels, an
+    //! operation without a registered kernel falls back to its updataData() on the GUI thread.
+    function _nodeSpec(node: Node) {
+        var kernel = "";
+        var params = {};
+        switch (node.type) {
+            case CSpecs.NodeType.ImageInput:
+                return { id: node._qsUuid, value: node.nodeData.data };
+
+            case CSpecs.NodeType.Blur: {
+                kernel = "blur";
+                params = { radius: node.blurRadius };
+            } break;
+
+            case CSpecs.NodeType.Brightness: {
+                kernel = "brightness";
+                params = { level: node.brightnessLevel };
+            } break;
+
+            case CSpecs.NodeType.Contrast: {
+                kernel = "contrast";
+                params = { level: node.contrastLevel };
             } break;
 
             default: {
+                // Result node: passes its input through
+                return { id: node._qsUuid };
             }
         }
+
+        if (!_executor.hasKernel(kernel))
+            return { id: node._qsUuid, guiAffine: true };
+
+        return { id: node._qsUuid, kernel: kernel, params: params };
+    }
+
+    //! GUI-affine evaluation: run the QML operation of the node
+    function _evaluateOnGui(nodeId, inputs, params) {
+        var node = nodes[nodeId];
+        if (!node)
+            return null;
+
+        node.nodeData.input = inputs[0] ?? null;
+        node.updataData();
+
+        return node.nodeData.data;
+    }
+
+    //! Write a batch of executor results back to the nodes
+    function _applyResults(results) {
+        results.forEach(result => {
+            var node = nodes[result.id];
+            if (!node)
+                return;
+
+            switch (node.type) {
+                case CSpecs.NodeType.Blur:
+                case CSpecs.NodeType.Brightness:
+                case CSpecs.NodeType.Contrast: {
+                    node.nodeData.input     = result.inputs[0] ?? null;
+                    node.nodeData.data      = result.value ?? null;
+                    node.nodeData._streamed = false;
+                } break;
+
+                case CSpecs.NodeType.ImageResult: {
+                    node.nodeData.data = result.value ?? null;
+                } break;
+
+                default: {
+                }
+            }
+        });
     }
 }
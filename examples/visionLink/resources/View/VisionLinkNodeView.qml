@@ -560,8 +560,10 @@ NodeView {
                     id: statusText
                     width: parent.width
                     horizontalAlignment: Text.AlignHCenter
-                    text: node?.nodeData?.data ? qsTr("✓ Blurred") : qsTr("Waiting...")
-                    color: node?.nodeData?.data ? "#4CAF50" : NLStyle.primaryTextColor
+                    text: node?.nodeData?.data ? qsTr("✓ Blurred")
+                                               : node?.nodeData?._streamed ? qsTr("✓ Streamed")
+                                                                           : qsTr("Waiting...")
+                    color: node?.nodeData?.data || node?.nodeData?._streamed ? "#4CAF50" : NLStyle.primaryTextColor
                     font.pointSize: 8
                 }
             }
@@ -714,8 +716,10 @@ NodeView {
                     id: statusText
                     width: parent.width
                     horizontalAlignment: Text.AlignHCenter
-                    text: node?.nodeData?.data ? qsTr("✓ Adjusted") : qsTr("Waiting...")
-                    color: node?.nodeData?.data ? "#4CAF50" : NLStyle.primaryTextColor
+                    text: node?.nodeData?.data ? qsTr("✓ Adjusted")
+                                               : node?.nodeData?._streamed ? qsTr("✓ Streamed")
+                                                                           : qsTr("Waiting...")
+                    color: node?.nodeData?.data || node?.nodeData?._streamed ? "#4CAF50" : NLStyle.primaryTextColor
                     font.pointSize: 8
                 }
             }
@@ -868,8 +872,10 @@ NodeView {
                     id: statusText
                     width: parent.width
                     horizontalAlignment: Text.AlignHCenter
-                    text: node?.nodeData?.data ? qsTr("✓ Enhanced") : qsTr("Waiting...")
-                    color: node?.nodeData?.data ? "#4CAF50" : NLStyle.primaryTextColor
+                    text: node?.nodeData?.data ? qsTr("✓ Enhanced")
+                                               : node?.nodeData?._streamed ? qsTr("✓ Streamed")
+                                                                           : qsTr("Waiting...")
+                    color: node?.nodeData?.data || node?.nodeData?._streamed ? "#4CAF50" : NLStyle.primaryTextColor
                     font.pointSize: 8
                 }
             }
@@ -0,0 +1,210 @@
+#ifndef COMMANDSTACKCPP_H
+#define COMMANDSTACKCPP_H
+
+#include <QObject>
+#include <QJSValue>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <QVariantList>
+#include <QVector>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * CommandStackCPP keeps the undo/redo history of a scene (see CommandStack.qml).
+ *
+ * Commands pushed in a short time (batchInterval) are grouped into one macro, undo and redo
+ * apply a macro as a whole. The built-in edits are pushed as typed records:
+ *      pushAddNode / pushAddNodes             undo detaches the nodes, redo adds them again
+ *      pushRemoveNode / pushRemoveNodes       undo restores the nodes and their links
+ *      pushAddContainer / pushRemoveContainer
+ *      pushCreateLink / pushUnlink
+ *      pushProperty                           target[key] = oldValue / newValue
+ * Any JS object or QML object with undo() and redo() functions is a custom command (push()).
+ *
+ * The macros live in a ring buffer of maxStackSize slots: the undo entries are the slots before
+ * the head, the redo entries the slots from the head on, so push, undo and redo are O(1). The
+ * slots and their records are reused, a discarded macro keeps its storage for the next one.
+ * Scene objects that a discarded macro holds and that are no longer in the scene are deleted.
+ * ************************************************************************************************/
+class CommandStackCPP : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(bool     isValidUndo   READ isValidUndo   NOTIFY stacksUpdated)
+    Q_PROPERTY(bool     isValidRedo   READ isValidRedo   NOTIFY stacksUpdated)
+    Q_PROPERTY(int      undoCount     READ undoCount     NOTIFY stacksUpdated)
+    Q_PROPERTY(int      redoCount     READ redoCount     NOTIFY stacksUpdated)
+    Q_PROPERTY(bool     isReplaying   READ isReplaying   WRITE setIsReplaying   NOTIFY isReplayingChanged)
+    Q_PROPERTY(int      maxStackSize  READ maxStackSize  WRITE setMaxStackSize  NOTIFY maxStackSizeChanged)
+    Q_PROPERTY(int      batchInterval READ batchInterval WRITE setBatchInterval NOTIFY batchIntervalChanged)
+    Q_PROPERTY(QObject* undoSpec      READ undoSpec      WRITE setUndoSpec      NOTIFY undoSpecChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit CommandStackCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Push a custom command, appliedAlready = false runs its redo() first
+    Q_INVOKABLE void push(const QJSValue &command, bool appliedAlready = true);
+
+    Q_INVOKABLE void pushAddNode(QObject *scene, QObject *node);
+    Q_INVOKABLE void pushAddNodes(QObject *scene, const QVariantList &nodes);
+
+    //! links: the Link objects removed with the node, restored on undo
+    Q_INVOKABLE void pushRemoveNode(QObject *scene, QObject *node, const QVariantList &links);
+    Q_INVOKABLE void pushRemoveNodes(QObject *scene, const QVariantList &nodes,
+                                     const QVariantList &links);
+
+    Q_INVOKABLE void pushAddContainer(QObject *scene, QObject *container);
+    Q_INVOKABLE void pushRemoveContainer(QObject *scene, QObject *container);
+
+    Q_INVOKABLE void pushCreateLink(QObject *scene, const QString &inputPortUuid,
+                                    const QString &outputPortUuid, QObject *link);
+    Q_INVOKABLE void pushUnlink(QObject *scene, const QString &inputPortUuid,
+                                const QString &outputPortUuid, QObject *link);
+
+    Q_INVOKABLE void pushProperty(QObject *target, const QString &key,
+                                  const QJSValue &oldValue, const QJSValue &newValue);
+
+    Q_INVOKABLE void undo();
+    Q_INVOKABLE void redo();
+
+    Q_INVOKABLE void clearRedo();
+
+    //! Discard all commands, the pending batch too
+    Q_INVOKABLE void resetStacks();
+
+    bool    isValidUndo() const;
+    bool    isValidRedo() const;
+
+    int     undoCount() const;
+    int     redoCount() const;
+
+    bool    isReplaying() const;
+    void    setIsReplaying(bool isReplaying);
+
+    //! 0 for unlimited (not recommended for memory)
+    int     maxStackSize() const;
+    void    setMaxStackSize(int maxStackSize);
+
+    int     batchInterval() const;
+    void    setBatchInterval(int batchInterval);
+
+    //! Object with the blockObservers flag (NLSpec.undo), set while a command is replayed
+    QObject *undoSpec() const;
+    void    setUndoSpec(QObject *undoSpec);
+
+signals:
+    void stacksUpdated();
+    void undoRedoDone();
+
+    //! A macro changed the scene: finalized, undone or redone (used by AutosaveJournal).
+    //! macro is {subCommands: [...]}, a record is {node, nodes, links, container, createdLink,
+    //! removedLink, target} with the members of its type, a custom command is itself.
+    void macroApplied(const QVariant &macro);
+
+    void isReplayingChanged();
+    void maxStackSizeChanged();
+    void batchIntervalChanged();
+    void undoSpecChanged();
+
+private slots:
+    //! Move the pending batch into the undo stack as one macro
+    void finalizePending();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    enum class CommandType {
+        Custom,
+        AddNode,
+        AddNodes,
+        RemoveNode,
+        RemoveNodes,
+        AddContainer,
+        RemoveContainer,
+        CreateLink,
+        Unlink,
+        Property
+    };
+
+    struct Command {
+        CommandType                 type = CommandType::Custom;
+        QPointer<QObject>           scene;
+
+        //! The nodes, the container, the link or the property target
+        QVector<QPointer<QObject>>  objects;
+
+        //! Links removed with nodes
+        QVector<QPointer<QObject>>  links;
+
+        QString                     inputPortUuid;
+        QString                     outputPortUuid;
+
+        QString                     key;
+        QJSValue                    oldValue;
+        QJSValue                    newValue;
+
+        QJSValue                    custom;
+    };
+
+    //! Slot of the ring or pending batch, records [0, size) are in use
+    struct Macro {
+        QVector<Command>    commands;
+        int                 size = 0;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Next free record of the pending batch
+    Command &nextCommand(CommandType type, QObject *scene);
+
+    //! Restart the batch timer after a record was added
+    void    schedule();
+
+    void    apply(Command &command, bool isUndo);
+    void    replay(Macro &macro, bool isUndo);
+
+    //! Delete the scene objects of the macro that are no longer in the scene, reset its records
+    void    discard(Macro &macro);
+    void    release(const Command &command);
+    void    releaseCustom(const QJSValue &command);
+
+    //! Delete object if it is not in scene[collection]
+    void    releaseObject(const QJSValue &scene, const QString &collection, QObject *object);
+
+    //! Ring with newCapacity slots, the oldest undo entries are dropped if they do not fit
+    void    relayout(int newCapacity);
+    int     slot(int index) const;
+
+    void    setObserversBlocked(bool blocked);
+
+    QJSValue call(const QJSValue &object, const QString &function,
+                  const QJSValueList &args = {}) const;
+    QJSValue toArray(const QVector<QPointer<QObject>> &objects) const;
+
+    void    emitMacroApplied(const Macro &macro);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QVector<Macro>      mRing;
+
+    //! Slot of the next pushed macro
+    int                 mHead       = 0;
+    int                 mUndoCount  = 0;
+    int                 mRedoCount  = 0;
+
+    Macro               mPending;
+    QTimer              mBatchTimer;
+
+    bool                mIsReplaying  = false;
+    int                 mMaxStackSize = 30;
+    QPointer<QObject>   mUndoSpec;
+};
+
+#endif // COMMANDSTACKCPP_H
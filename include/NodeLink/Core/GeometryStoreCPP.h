@@ -0,0 +1,127 @@
+#ifndef GEOMETRYSTORECPP_H
+#define GEOMETRYSTORECPP_H
+
+#include <QObject>
+#include <QHash>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+class NodeGuiConfigCPP;
+class LinkGuiConfigCPP;
+
+/*! ***********************************************************************************************
+ * GeometryStoreCPP keeps the geometry of the nodes and links of a repository (scene) in
+ * struct-of-arrays buffers: one contiguous column per attribute, one row per node or link.
+ *
+ * Rows are allocated by NodeGuiConfigCPP / LinkGuiConfigCPP, the bases of NodeGuiConfig and
+ * LinkGUIConfig. C++ subsystems (layout, hit-testing, routing) iterate the columns directly;
+ * rows of free slots have no alive flag. Colors are kept as set (names or #rrggbb strings).
+ *
+ * A store belongs to one repository and is used from the thread of that repository.
+ * ************************************************************************************************/
+class GeometryStoreCPP
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    enum RowFlag : quint8 {
+        Alive  = 0x01,
+        Locked = 0x02
+    };
+
+    //! Called with a node row whose rectangle changed (moved, resized, allocated, released)
+    using NodeObserver = std::function<void(int row)>;
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    GeometryStoreCPP() = default;
+
+    //! Store of a repository, created on first use and released with the repository.
+    //! Objects without repository share a detached store of their thread.
+    static std::shared_ptr<GeometryStoreCPP> forRepo(QObject *repo);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    int  allocateNode(NodeGuiConfigCPP *config);
+    void releaseNode(int row);
+
+    int  allocateLink(LinkGuiConfigCPP *config);
+    void releaseLink(int row);
+
+    //! Number of rows, including free ones (see isNodeAlive)
+    int  nodeRowCount() const { return int(mNodeFlags.size()); }
+    int  linkRowCount() const { return int(mLinkFlags.size()); }
+
+    //! Number of allocated rows
+    int  nodeCount() const    { return nodeRowCount() - int(mFreeNodeRows.size()); }
+    int  linkCount() const    { return linkRowCount() - int(mFreeLinkRows.size()); }
+
+    bool isNodeAlive(int row) const { return mNodeFlags.at(row) & Alive; }
+    bool isLinkAlive(int row) const { return mLinkFlags.at(row) & Alive; }
+
+    //! Columns, indexed by row
+    const QVector<float>  &nodeX() const       { return mNodeX; }
+    const QVector<float>  &nodeY() const       { return mNodeY; }
+    const QVector<int>    &nodeWidth() const   { return mNodeWidth; }
+    const QVector<int>    &nodeHeight() const  { return mNodeHeight; }
+    const QVector<QString> &nodeColor() const  { return mNodeColor; }
+    const QVector<qreal>  &nodeOpacity() const { return mNodeOpacity; }
+    const QVector<quint8> &nodeFlags() const   { return mNodeFlags; }
+
+    const QVector<QString> &linkColor() const  { return mLinkColor; }
+    const QVector<qint8>  &linkStyle() const   { return mLinkStyle; }
+    const QVector<qint8>  &linkType() const    { return mLinkType; }
+    const QVector<quint8> &linkFlags() const   { return mLinkFlags; }
+
+    QRectF nodeRect(int row) const;
+
+    //! Object that owns the row (e.g. the node), set on the gui config
+    QObject *nodeOwner(int row) const;
+    QObject *linkOwner(int row) const;
+
+    //! Move / resize a node from C++, the QML properties are notified
+    void setNodePosition(int row, float x, float y);
+    void setNodeSize(int row, int width, int height);
+
+    //! Observers of the node rectangles (e.g. spatial indexes), returns the id to remove it
+    int  addNodeObserver(NodeObserver observer);
+    void removeNodeObserver(int id);
+
+private:
+    friend class NodeGuiConfigCPP;
+    friend class LinkGuiConfigCPP;
+
+    /* Private Functions
+     * ****************************************************************************************/
+    void notifyNodeObservers(int row) const;
+
+    /* Attributes
+     * ****************************************************************************************/
+    //! Node columns
+    QVector<float>             mNodeX;
+    QVector<float>             mNodeY;
+    QVector<int>               mNodeWidth;
+    QVector<int>               mNodeHeight;
+    QVector<QString>           mNodeColor;
+    QVector<qreal>             mNodeOpacity;
+    QVector<quint8>            mNodeFlags;
+    QVector<NodeGuiConfigCPP*> mNodeConfigs;
+    QVector<int>               mFreeNodeRows;
+
+    //! Link columns
+    QVector<QString>           mLinkColor;
+    QVector<qint8>             mLinkStyle;
+    QVector<qint8>             mLinkType;
+    QVector<quint8>            mLinkFlags;
+    QVector<LinkGuiConfigCPP*> mLinkConfigs;
+    QVector<int>               mFreeLinkRows;
+
+    QHash<int, NodeObserver>   mNodeObservers;
+    int                        mNextObserverId = 0;
+};
+
+#endif // GEOMETRYSTORECPP_H
@@ -0,0 +1,147 @@
+#ifndef GRAPHEXECUTORCPP_H
+#define GRAPHEXECUTORCPP_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJSValue>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVariant>
+#include <QVector>
+#include <QQmlEngine>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/*! ***********************************************************************************************
+ * GraphExecutorCPP evaluates a DAG of nodes in parallel: a node is scheduled as soon as all its
+ * inputs are complete, so independent branches run on different cores.
+ *
+ * Each node declares how it is evaluated:
+ *      kernel:    name of a registered thread-safe C++ kernel, runs on the thread pool
+ *      guiAffine: evaluated on the GUI thread by the guiEvaluator passed to run()
+ *      value:     source node, its output is value
+ *      otherwise: pass-through, its output is its first input
+ *
+ * A worker that completes a node continues with one of the released nodes itself and hands
+ * the others to the pool. Results are marshalled back to the GUI thread in batches
+ * (nodesEvaluated), one batch per GUI event loop iteration.
+ * ************************************************************************************************/
+class GraphExecutorCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(GraphExecutor)
+
+    Q_PROPERTY(bool busy           READ busy           NOTIFY busyChanged)
+    Q_PROPERTY(int  maxThreadCount READ maxThreadCount WRITE setMaxThreadCount NOTIFY maxThreadCountChanged)
+
+public:
+    //! Thread-safe kernel: output from the inputs (in link order) and the node parameters
+    using Kernel = std::function<QVariant(const QVariantList &inputs, const QVariantMap &params)>;
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit GraphExecutorCPP(QObject *parent = nullptr);
+    ~GraphExecutorCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Register a thread-safe kernel for all executors.
+    static void registerKernel(const QString &name, const Kernel &kernel);
+
+    Q_INVOKABLE bool hasKernel(const QString &name) const;
+
+    //! Evaluate nodes [{id, kernel, params, guiAffine, value}] and links [{from, to}].
+    //! A running evaluation is cancelled.
+    Q_INVOKABLE bool run(const QVariantList &nodes, const QVariantList &links,
+                         const QJSValue &guiEvaluator = QJSValue());
+
+    //! Cancel the running evaluation, nodes that are already running complete silently.
+    Q_INVOKABLE void cancel();
+
+    bool busy() const;
+
+    int  maxThreadCount() const;
+    void setMaxThreadCount(int maxThreadCount);
+
+signals:
+    void busyChanged();
+    void maxThreadCountChanged();
+
+    //! Batch of results [{id, value, inputs}]
+    void nodesEvaluated(const QVariantList &results);
+
+    //! All nodes are evaluated, stats {nodeCount, elapsedMs, kernelMs, parallelism,
+    //! peakConcurrency, threadCount, skippedNodes}
+    void finished(const QVariantMap &stats);
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    enum class TaskKind {
+        Kernel,
+        GuiAffine,
+        Source,
+        PassThrough
+    };
+
+    struct Task {
+        TaskKind     kind = TaskKind::PassThrough;
+        QString      id;
+        Kernel       kernel;
+        QVariantMap  params;
+        QVariant     value;
+        QVector<int> upstream;
+        QVector<int> downstream;
+    };
+
+    //! State of one evaluation, shared with the workers
+    struct RunState {
+        //! Read-only while the run is in flight
+        QVector<Task>         tasks;
+
+        //! Written once per task before its downstream tasks are released
+        std::vector<QVariant> outputs;
+
+        //! Inputs each task still waits for
+        std::unique_ptr<std::atomic<int>[]> pending;
+        std::atomic<int>    remaining { 0 };
+        std::atomic<bool>   cancelled { false };
+
+        std::atomic<int>    running { 0 };
+        std::atomic<int>    peakRunning { 0 };
+        std::atomic<qint64> kernelNsecs { 0 };
+        QElapsedTimer       timer;
+        int                 skippedNodes = 0;
+
+        //! Results not yet delivered to the GUI thread
+        QMutex       mutex;
+        QVariantList completed;
+        bool         flushPosted = false;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    static QHash<QString, Kernel> &kernels();
+    static QMutex &kernelsMutex();
+
+    void dispatch(const std::shared_ptr<RunState> &state, int index);
+    void execute(const std::shared_ptr<RunState> &state, int index);
+    QVariant evaluateOnGui(const Task &task, const QVariantList &inputs);
+    bool canRunInline(TaskKind kind, bool isGuiThread) const;
+
+    void flush(const std::shared_ptr<RunState> &state);
+    void finish(const std::shared_ptr<RunState> &state);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QThreadPool               mPool;
+    std::shared_ptr<RunState> mState;
+    QJSValue                  mGuiEvaluator;
+};
+
+#endif // GRAPHEXECUTORCPP_H
@@ -0,0 +1,43 @@
+#ifndef GUICONFIGCPP_H
+#define GUICONFIGCPP_H
+
+#include <QObject>
+#include <QVariant>
+#include <QQmlEngine>
+
+#include "QSObjectCpp.h"
+
+/*! ***********************************************************************************************
+ * GuiConfigCPP is the common base of NodeGuiConfigCPP and LinkGuiConfigCPP. It adds the parts of
+ * the QML QSObject API that QSObjectCpp does not have, so the gui configs behave like the other
+ * QSObjects of a scene: setProperties() and the loadedFromStorage / removedFromRepo signals.
+ * ************************************************************************************************/
+class GuiConfigCPP : public QSObjectCpp
+{
+    Q_OBJECT
+    QML_ANONYMOUS
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit GuiConfigCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Copy the properties of another object or of a map, as QSObject.setProperties(). Internal
+    //! (_ and qs prefixed) properties, objectName and properties this object does not have are
+    //! skipped.
+    Q_INVOKABLE void setProperties(const QVariant &properties);
+
+signals:
+    //! Signals of QSObject
+    void loadedFromStorage();
+    void removedFromRepo();
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    void setCopiedProperty(const QString &key, const QVariant &value);
+};
+
+#endif // GUICONFIGCPP_H
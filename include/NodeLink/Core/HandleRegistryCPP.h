@@ -0,0 +1,161 @@
+#ifndef HANDLEREGISTRYCPP_H
+#define HANDLEREGISTRYCPP_H
+
+#include <QObject>
+#include <QHash>
+#include <QMetaMethod>
+#include <QPointer>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * HandleRegistryCPP interns object UUIDs to compact integer handles and keeps handle-keyed
+ * indices of the nodes, ports and links of a scene (target).
+ *
+ * A UUID is interned once per process; equal UUIDs always get the same handle, so identity
+ * checks compare integers. UUID strings remain the serialization keys.
+ *
+ * The indices are updated incrementally: the scene adds and removes its nodes and links with
+ * addNode(s) / removeNode(s) / addLink(s) / removeLink(s) before it emits its own signals, so
+ * handlers of nodeRemoved / linkRemoved already see the updated indices. rebuild() indexes
+ * scene.nodes / scene.links at once, e.g. after a repository was loaded. Every query is O(1)
+ * instead of a loop over the scene:
+ *      port -> node, link by (upstream port, downstream port), links ending at a port,
+ *      links between two nodes
+ *
+ * Handle 0 is invalid (unknown UUID or object).
+ * ************************************************************************************************/
+class HandleRegistryCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(HandleRegistry)
+
+    Q_PROPERTY(QObject *target READ target WRITE setTarget NOTIFY targetChanged)
+
+public:
+    using Handle = int;
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit HandleRegistryCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Handle of a UUID, interned on first use. Thread-safe.
+    static Handle intern(const QString &uuid);
+
+    //! Handle of an interned UUID, 0 for unknown UUIDs (nothing is interned). Thread-safe.
+    static Handle lookup(const QString &uuid);
+
+    //! UUID of a handle, empty for invalid handles. Thread-safe.
+    static QString uuidOf(Handle handle);
+
+    //! Handle of an object of the scene (or a port a link refers to), 0 for unknown UUIDs
+    Q_INVOKABLE int     handle(const QString &uuid);
+    Q_INVOKABLE QString uuid(int handle) const;
+
+    //! Objects of the scene by handle, null if they are not in the scene
+    Q_INVOKABLE QObject *node(int handle);
+    Q_INVOKABLE QObject *port(int handle);
+    Q_INVOKABLE QObject *link(int handle);
+
+    //! Node that owns the port
+    Q_INVOKABLE int      nodeOfPort(int portHandle);
+
+    //! Link from the upstream port to the downstream port
+    Q_INVOKABLE QObject *linkBetween(int inputPortHandle, int outputPortHandle);
+    Q_INVOKABLE bool     hasLink(int inputPortHandle, int outputPortHandle);
+
+    //! Number of links that end at (downstream) or start from (upstream) a port
+    Q_INVOKABLE int      linkCountTo(int portHandle);
+    Q_INVOKABLE int      linkCountFrom(int portHandle);
+
+    //! A link leads from a port of fromNode to a port of toNode
+    Q_INVOKABLE bool     hasNodeLink(int fromNodeHandle, int toNodeHandle);
+
+    //! Index nodes (and their ports) and links that were added to the scene
+    Q_INVOKABLE void     addNode(QObject *node);
+    Q_INVOKABLE void     addNodes(const QVariantList &nodes);
+    Q_INVOKABLE void     addLink(QObject *link);
+    Q_INVOKABLE void     addLinks(const QVariantList &links);
+
+    //! Drop nodes (and their ports) and links that were removed from the scene
+    Q_INVOKABLE void     removeNode(QObject *node);
+    Q_INVOKABLE void     removeNodes(const QVariantList &nodes);
+    Q_INVOKABLE void     removeLink(QObject *link);
+    Q_INVOKABLE void     removeLinks(const QVariantList &links);
+
+    //! Index scene.nodes and scene.links from scratch
+    Q_INVOKABLE void     rebuild();
+
+    QObject *target() const;
+    void     setTarget(QObject *target);
+
+signals:
+    void targetChanged();
+
+private slots:
+    void onPortsChanged();
+    void onLinkPortsChanged();
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    static QHash<QString, Handle> &handles();
+    static QVector<QString>       &uuids();
+    static QReadWriteLock         &handlesLock();
+
+    static quint64 pairKey(Handle first, Handle second);
+
+    //! The UUID -> object entries of a QML map property, e.g. scene.nodes
+    static QList<QPair<QString, QObject *>> mapEntries(QObject *object, const char *property);
+
+    //! Call slot (normalized signature) when the property of sender changes
+    void watchProperty(QObject *sender, const char *property, const char *slot);
+
+    static Handle uuidHandle(QObject *object);
+
+    void indexPorts(Handle nodeHandle, QObject *node);
+    void unindexPorts(Handle nodeHandle);
+
+    void indexLink(Handle linkHandle, QObject *link);
+    void unindexLink(Handle linkHandle);
+
+    //! The handle of a port object, ports outside the scene are identified by their UUID
+    Handle portHandle(QObject *port);
+
+    /* Attributes
+     * ****************************************************************************************/
+    //! Ports and nodes of an indexed link, kept to undo its entries on removal
+    struct LinkEntry
+    {
+        QPointer<QObject> link;
+        Handle            inputPort  = 0;
+        Handle            outputPort = 0;
+        Handle            fromNode   = 0;
+        Handle            toNode     = 0;
+    };
+
+    QPointer<QObject> mTarget;
+
+    QHash<Handle, QPointer<QObject>> mNodes;
+    QHash<Handle, QPointer<QObject>> mPorts;
+    QHash<Handle, LinkEntry>         mLinks;
+
+    QHash<Handle, Handle>            mNodeOfPort;
+    QHash<Handle, QVector<Handle>>   mPortsOfNode;
+    QHash<QObject *, Handle>         mPortHandles;
+
+    //! (upstream port, downstream port) -> link
+    QHash<quint64, Handle>   mLinkByPorts;
+    QHash<Handle, int>       mLinksTo;
+    QHash<Handle, int>       mLinksFrom;
+
+    //! (upstream node, downstream node) -> number of links
+    QHash<quint64, int>      mNodeLinks;
+};
+
+#endif // HANDLEREGISTRYCPP_H
@@ -0,0 +1,156 @@
+#ifndef JOURNALFILECPP_H
+#define JOURNALFILECPP_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantMap>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * JournalFileCPP is the storage of the autosave journal: a write-ahead journal of compact edit
+ * records next to a periodic full checkpoint of the repository.
+ *
+ * Files, for a given filePath:
+ *      <filePath>.checkpoint    {version, sequence, objects: repository dump}
+ *      <filePath>.journal       one JSON record per line {seq, ops}
+ *      <filePath>.journal.prev  journal of the checkpoint that is being written
+ *
+ * Records are buffered and group-committed (written and synced) on a timer, the checkpoint is
+ * serialized and written on a worker thread. Recovery loads the checkpoint and applies the
+ * records of both journals that are newer than it.
+ *
+ * Record operations (see AutosaveJournal.qml):
+ *      {op: "put",    uuid, props}      store the object image
+ *      {op: "drop",   uuid}             remove the object image
+ *      {op: "insert", collection, uuid} add the object to a collection of the root object
+ *      {op: "erase",  collection, uuid} remove the object from a collection of the root object
+ * ************************************************************************************************/
+class JournalFileCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(JournalFile)
+
+    Q_PROPERTY(QString filePath        READ filePath       WRITE setFilePath       NOTIFY filePathChanged)
+    Q_PROPERTY(QString defaultFilePath READ defaultFilePath CONSTANT)
+    Q_PROPERTY(int     commitInterval  READ commitInterval WRITE setCommitInterval NOTIFY commitIntervalChanged)
+    Q_PROPERTY(int     pendingRecords  READ pendingRecords NOTIFY journalChanged)
+    Q_PROPERTY(qint64  sequence        READ sequence       NOTIFY journalChanged)
+    Q_PROPERTY(qint64  journalBytes    READ journalBytes   NOTIFY journalChanged)
+    Q_PROPERTY(bool    busy            READ busy           NOTIFY busyChanged)
+
+public:
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit JournalFileCPP(QObject *parent = nullptr);
+    ~JournalFileCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! True when a checkpoint exists for filePath.
+    Q_INVOKABLE bool hasRecoveryData() const;
+
+    //! Buffer a record {ops}, it is written on the next group commit. Returns its sequence.
+    Q_INVOKABLE qint64 append(const QVariantMap &record);
+
+    //! Write and sync the buffered records now.
+    Q_INVOKABLE bool commit();
+
+    //! Rotate the journal and write objects (a repository dump) as the new checkpoint.
+    Q_INVOKABLE bool writeCheckpoint(const QVariantMap &objects);
+
+    //! Replay checkpoint and journals on a worker thread, emits recovered() or failed().
+    Q_INVOKABLE bool recover();
+
+    //! Remove all autosave files, e.g. after the scene was saved by the user.
+    Q_INVOKABLE void discard();
+
+    QString filePath() const;
+    void    setFilePath(const QString &filePath);
+
+    //! <AppDataLocation>/autosave/scene
+    QString defaultFilePath() const;
+
+    int     commitInterval() const;
+    void    setCommitInterval(int commitInterval);
+
+    int     pendingRecords() const;
+    qint64  sequence() const;
+    qint64  journalBytes() const;
+    bool    busy() const;
+
+signals:
+    void filePathChanged();
+    void commitIntervalChanged();
+    void journalChanged();
+    void busyChanged();
+
+    //! A group of records was written and synced
+    void committed(int recordCount, qint64 bytes);
+
+    void checkpointWritten(qint64 sequence);
+
+    //! Recovered repository dump, ready for QSRepository.loadRepo()
+    void recovered(const QVariantMap &objects, int replayedRecords);
+
+    void failed(const QString &error);
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct CheckpointResult {
+        qint64  sequence = 0;
+        QString error;
+    };
+
+    struct RecoveryResult {
+        QVariantMap objects;
+        qint64      sequence        = 0;
+        int         replayedRecords = 0;
+        QString     error;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    QString checkpointPath() const;
+    QString journalPath() const;
+    QString previousJournalPath() const;
+
+    bool openJournal();
+    void closeJournal();
+    bool rotateJournal();
+
+    static CheckpointResult writeCheckpointFile(const QString &path, const QVariantMap &objects,
+                                                qint64 sequence);
+    static RecoveryResult   recoverFiles(const QString &checkpointPath,
+                                         const QStringList &journalPaths);
+
+    void onCheckpointFinished();
+    void onRecoveryFinished();
+
+    /* Attributes
+     * ****************************************************************************************/
+    QString   mFilePath;
+
+    //! Open journal, records are appended
+    QFile     mJournal;
+
+    //! Records of the next group commit
+    QByteArray mPending;
+    int       mPendingRecords;
+
+    qint64    mSequence;
+    qint64    mJournalBytes;
+
+    QTimer    mCommitTimer;
+
+    QFutureWatcher<CheckpointResult> mCheckpointWatcher;
+    QFutureWatcher<RecoveryResult>   mRecoveryWatcher;
+};
+
+#endif // JOURNALFILECPP_H
@@ -0,0 +1,70 @@
+#ifndef LINKGUICONFIGCPP_H
+#define LINKGUICONFIGCPP_H
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QQmlEngine>
+
+#include <memory>
+
+#include "GuiConfigCPP.h"
+#include "GeometryStoreCPP.h"
+
+/*! ***********************************************************************************************
+ * LinkGuiConfigCPP is the base of LinkGUIConfig. Color, style and type are read and written in
+ * the row of the link in the GeometryStoreCPP of its repository.
+ * ************************************************************************************************/
+class LinkGuiConfigCPP : public GuiConfigCPP
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QObject *_owner READ owner WRITE setOwner NOTIFY ownerChanged)
+    Q_PROPERTY(QString  color  READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(int      style  READ style WRITE setStyle NOTIFY styleChanged)
+    Q_PROPERTY(int      type   READ type  WRITE setType  NOTIFY typeChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit LinkGuiConfigCPP(QObject *parent = nullptr);
+    ~LinkGuiConfigCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    GeometryStoreCPP *store() const;
+    int               row() const;
+
+    //! Link that owns the row, set by the link (not serialized)
+    QObject *owner() const;
+    void     setOwner(QObject *owner);
+
+    QString  color() const;
+    void     setColor(const QString &color);
+
+    int      style() const;
+    void     setStyle(int style);
+
+    int      type() const;
+    void     setType(int type);
+
+signals:
+    void ownerChanged();
+    void colorChanged();
+    void styleChanged();
+    void typeChanged();
+
+private slots:
+    //! Copy the values into a row of the store of the new repository
+    void onRepoChanged();
+
+private:
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QObject>                 mOwner;
+    std::shared_ptr<GeometryStoreCPP> mStore;
+    int                               mRow;
+};
+
+#endif // LINKGUICONFIGCPP_H
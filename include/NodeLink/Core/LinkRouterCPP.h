@@ -0,0 +1,209 @@
+#ifndef LINKROUTERCPP_H
+#define LINKROUTERCPP_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QSet>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include <QVector2D>
+#include <QQmlEngine>
+
+#include <memory>
+
+#include "GeometryStoreCPP.h"
+
+/*! ***********************************************************************************************
+ * LinkRouterCPP computes the control points of links in C++ and keeps them in a cache:
+ *      L lines:  orthogonal routes around the node rectangles (A* over the lines of the
+ *                obstacle edges, with a penalty per bend)
+ *      Bezier:   the default curve, or a smooth curve along the orthogonal route when the
+ *                default curve crosses a node
+ *      Straight: the default line
+ *
+ * The node rectangles come from the GeometryStoreCPP of the repository and are kept in a grid
+ * (spatial index) that follows the store incrementally. With a scene only the nodes of the scene
+ * are obstacles (removed nodes keep their rows while the undo stack holds them), the scene reports
+ * its changes through addNodes() / removeNodes(). Nodes without views (hiddenNodes, e.g. inside
+ * collapsed or paged out containers) are left out of the grid. A route is recomputed when its end
+ * points change, or when a node moves into or out of its bounds. Recomputing is time-sliced:
+ * each frame spends at most frameBudget milliseconds, the remaining links keep their previous
+ * route and get routeChanged() when their new route is ready.
+ * ************************************************************************************************/
+class LinkRouterCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(LinkRouter)
+
+    Q_PROPERTY(QObject *repo         READ repo         WRITE setRepo        NOTIFY repoChanged)
+    Q_PROPERTY(QObject *scene        READ scene        WRITE setScene       NOTIFY sceneChanged)
+    Q_PROPERTY(bool     enabled      READ enabled      WRITE setEnabled     NOTIFY enabledChanged)
+    Q_PROPERTY(qreal    clearance    READ clearance    WRITE setClearance   NOTIFY clearanceChanged)
+    Q_PROPERTY(int      frameBudget  READ frameBudget  WRITE setFrameBudget NOTIFY frameBudgetChanged)
+    Q_PROPERTY(int      pendingCount READ pendingCount NOTIFY pendingCountChanged)
+    Q_PROPERTY(QVariantMap hiddenNodes READ hiddenNodes WRITE setHiddenNodes NOTIFY hiddenNodesChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit LinkRouterCPP(QObject *parent = nullptr);
+    ~LinkRouterCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Control points of a link from start (upstream port) to end, with the port sides and
+    //! the link type / direction (NLSpec). The cached route is returned while it is valid.
+    Q_INVOKABLE QVariantList route(QObject *link, const QVector2D &start, const QVector2D &end,
+                                   int type, int startSide, int endSide, int direction);
+
+    //! Forget the route of a link (e.g. removed from the scene)
+    Q_INVOKABLE void         invalidate(QObject *link);
+
+    //! Recompute all routes in the next frames
+    Q_INVOKABLE void         invalidateAll();
+
+    //! Nodes added to / removed from the scene (I_Scene signals)
+    Q_INVOKABLE void         addNodes(const QVariantList &nodes);
+    Q_INVOKABLE void         removeNodes(const QVariantList &nodes);
+
+    QObject *repo() const;
+    void     setRepo(QObject *repo);
+
+    //! Scene whose nodes (map <UUID, node>) are the obstacles, all nodes of the repository
+    //! without a scene
+    QObject *scene() const;
+    void     setScene(QObject *scene);
+
+    bool     enabled() const;
+    void     setEnabled(bool enabled);
+
+    //! Distance kept between routes and node rectangles
+    qreal    clearance() const;
+    void     setClearance(qreal clearance);
+
+    //! Milliseconds of routing per frame
+    int      frameBudget() const;
+    void     setFrameBudget(int frameBudget);
+
+    //! Links waiting for a new route
+    int      pendingCount() const;
+
+    //! Nodes that are not obstacles, map <node UUID, any> (e.g. I_Scene._collapsedNodes)
+    QVariantMap hiddenNodes() const;
+    void     setHiddenNodes(const QVariantMap &hiddenNodes);
+
+signals:
+    void repoChanged();
+    void sceneChanged();
+    void enabledChanged();
+    void clearanceChanged();
+    void frameBudgetChanged();
+    void pendingCountChanged();
+    void hiddenNodesChanged();
+
+private slots:
+    void onLinkDestroyed(QObject *link);
+
+    //! Recompute pending routes within the frame budget
+    void processPending();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Route {
+        QPointF          start;
+        QPointF          end;
+        int              type      = 0;
+        int              startSide = -1;
+        int              endSide   = -1;
+        int              direction = 0;
+
+        QVector<QPointF> points;
+        QRectF           bounds;
+
+        //! Grid cells of bounds in the link index, null for the large links
+        QRect            cells;
+        bool             pending   = false;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    void   attachStore();
+    void   detachStore();
+
+    //! Store observer: moves the row in the node grid and invalidates the routes nearby
+    void   onNodeChanged(int row);
+
+    //! The owner of the row is not in the scene, or in hiddenNodes
+    bool   isNodeHidden(int row) const;
+
+    //! Row of a node in the store, -1 if it has none
+    int    rowOf(QObject *node) const;
+
+    //! Moves the rows whose state changed into or out of the grid
+    void   updateRows(const QVariantList &nodes);
+
+    //! Starts a new frame when the previous one is over
+    void   beginFrame();
+    bool   hasBudget() const;
+
+    //! Without avoidObstacles: the route of an empty scene, until the final one is computed
+    void   computeRoute(Route &route, bool avoidObstacles) const;
+    void   storeRoute(QObject *link, Route &route);
+    void   enqueue(QObject *link, Route &route);
+    void   invalidateRegion(const QRectF &region);
+
+    //! Obstacles (node rectangles grown by the clearance) around region
+    QVector<QRectF>  obstaclesIn(const QRectF &region) const;
+
+    //! Orthogonal route between the stubs, empty if there is none
+    QVector<QPointF> orthogonalPath(const QPointF &from, int fromDirection,
+                                    const QPointF &to, int toDirection,
+                                    const QVector<QRectF> &obstacles, const QRectF &region) const;
+
+    static QVector<QPointF> simplified(const QVector<QPointF> &points);
+    static QVector<QPointF> roundedBezier(const QVector<QPointF> &points);
+    static bool             curveIntersects(const QVector<QPointF> &curve,
+                                            const QVector<QRectF> &obstacles);
+
+    QRect  cellsOf(const QRectF &rect) const;
+    static quint64 cellKey(int column, int row);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QObject>                  mRepo;
+    std::shared_ptr<GeometryStoreCPP>  mStore;
+    int                                mObserverId = -1;
+
+    bool                               mEnabled     = true;
+    qreal                              mClearance   = 10;
+    int                                mFrameBudget = 4;
+
+    //! Node grid: cell -> rows, and the rectangle each row was indexed with
+    QHash<quint64, QVector<int>>       mNodeCells;
+    QHash<int, QRectF>                 mIndexedNodes;
+    QVariantMap                        mHiddenNodes;
+
+    QPointer<QObject>                  mScene;
+    QSet<const QObject *>              mSceneNodes;
+
+    //! Link grid: cell -> links, over the route bounds
+    QHash<quint64, QVector<QObject *>> mLinkCells;
+    QSet<QObject *>                    mLargeLinks;
+
+    QHash<QObject *, Route>            mRoutes;
+    QVector<QObject *>                 mPending;
+
+    QTimer                             mSliceTimer;
+    QElapsedTimer                      mFrameClock;
+    qint64                             mFrameSpentNs = 0;
+};
+
+#endif // LINKROUTERCPP_H
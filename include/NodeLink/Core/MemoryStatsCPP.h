@@ -0,0 +1,92 @@
+#ifndef MEMORYSTATSCPP_H
+#define MEMORYSTATSCPP_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQuickItem>
+#include <QSet>
+#include <QVariantMap>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * MemoryStatsCPP reports where the memory of a scene goes:
+ *      objects:  count and estimated bytes of each category (nodes, ports, node gui configs,
+ *                images models, node data, links, link gui configs, containers, ...)
+ *      jsHeap:   used / allocated bytes of the JS heap of the engine
+ *      view:     count of the items under the view, per item type
+ *      process:  resident set size
+ *
+ * Objects that are referenced more than once (shared default instances) are counted once, the
+ * number of references to shared instances and the bytes the private copies of the other
+ * references would take (savedBytes) are reported per category.
+ * The byte figures are estimates: a fixed cost per object and per property plus the size of the
+ * property values (strings, lists, maps), the engine does not expose exact per object figures.
+ * ************************************************************************************************/
+class MemoryStatsCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(MemoryStats)
+
+    Q_PROPERTY(QObject    *target READ target WRITE setTarget NOTIFY targetChanged)
+    Q_PROPERTY(QQuickItem *view   READ view   WRITE setView   NOTIFY viewChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit MemoryStatsCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Snapshot: {objects: {category: {count, bytes, sharedRefs, savedBytes}}, objectCount,
+    //! objectBytes, savedBytes, jsHeap: {used, allocated}, view: {itemCount, types: {type: count}},
+    //! process: {rss}}.
+    //! Unavailable figures are -1
+    Q_INVOKABLE QVariantMap collect() const;
+
+    //! Estimated bytes of one object and its property values (referenced objects excluded)
+    Q_INVOKABLE qint64      estimateObjectBytes(QObject *object) const;
+
+    //! The scene
+    QObject    *target() const;
+    void        setTarget(QObject *target);
+
+    QQuickItem *view() const;
+    void        setView(QQuickItem *view);
+
+signals:
+    void targetChanged();
+    void viewChanged();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Category {
+        QSet<QObject *>       objects;
+
+        //! References to each shared default instance
+        QHash<QObject *, int> sharedRefs;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Adds object to category, shared default instances add a shared reference
+    static void      addObject(Category &category, QObject *object);
+
+    //! Objects of a map / list valued property (scene.nodes, node.ports ...)
+    static QObjectList objectsOf(const QVariant &value);
+
+    qint64           estimateValueBytes(const QVariant &value, int depth) const;
+
+    QVariantMap      collectObjects() const;
+    QVariantMap      collectJsHeap() const;
+    QVariantMap      collectView() const;
+    static QVariantMap collectProcess();
+
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QObject>    mTarget;
+    QPointer<QQuickItem> mView;
+};
+
+#endif // MEMORYSTATSCPP_H
@@ -0,0 +1,89 @@
+#ifndef NODEGUICONFIGCPP_H
+#define NODEGUICONFIGCPP_H
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVector2D>
+#include <QQmlEngine>
+
+#include <memory>
+
+#include "GuiConfigCPP.h"
+#include "GeometryStoreCPP.h"
+
+/*! ***********************************************************************************************
+ * NodeGuiConfigCPP is the base of NodeGuiConfig. Position, size, color, opacity and lock are not
+ * kept in the object: they are read and written in the row of the node in the GeometryStoreCPP
+ * of its repository (struct-of-arrays columns).
+ *
+ * When _qsRepo changes the row moves to the store of the new repository.
+ * ************************************************************************************************/
+class NodeGuiConfigCPP : public GuiConfigCPP
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QObject  *_owner   READ owner    WRITE setOwner    NOTIFY ownerChanged)
+    Q_PROPERTY(QVector2D position READ position WRITE setPosition NOTIFY positionChanged)
+    Q_PROPERTY(int       width    READ width    WRITE setWidth    NOTIFY widthChanged)
+    Q_PROPERTY(int       height   READ height   WRITE setHeight   NOTIFY heightChanged)
+    Q_PROPERTY(QString   color    READ color    WRITE setColor    NOTIFY colorChanged)
+    Q_PROPERTY(qreal     opacity  READ opacity  WRITE setOpacity  NOTIFY opacityChanged)
+    Q_PROPERTY(bool      locked   READ locked   WRITE setLocked   NOTIFY lockedChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit NodeGuiConfigCPP(QObject *parent = nullptr);
+    ~NodeGuiConfigCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    GeometryStoreCPP *store() const;
+    int               row() const;
+
+    //! Node returned by geometry queries, set by the node (not serialized)
+    QObject  *owner() const;
+    void      setOwner(QObject *owner);
+
+    QVector2D position() const;
+    void      setPosition(const QVector2D &position);
+
+    int       width() const;
+    void      setWidth(int width);
+
+    int       height() const;
+    void      setHeight(int height);
+
+    QString   color() const;
+    void      setColor(const QString &color);
+
+    qreal     opacity() const;
+    void      setOpacity(qreal opacity);
+
+    bool      locked() const;
+    void      setLocked(bool locked);
+
+signals:
+    void ownerChanged();
+    void positionChanged();
+    void widthChanged();
+    void heightChanged();
+    void colorChanged();
+    void opacityChanged();
+    void lockedChanged();
+
+private slots:
+    //! Copy the values into a row of the store of the new repository
+    void onRepoChanged();
+
+private:
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QObject>                 mOwner;
+    std::shared_ptr<GeometryStoreCPP> mStore;
+    int                               mRow;
+};
+
+#endif // NODEGUICONFIGCPP_H
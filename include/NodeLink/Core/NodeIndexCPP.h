@@ -0,0 +1,101 @@
+#ifndef NODEINDEXCPP_H
+#define NODEINDEXCPP_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include <QQmlEngine>
+
+#include <set>
+#include <utility>
+
+/*! ***********************************************************************************************
+ * NodeIndexCPP keeps per-type node counts and a title index of the nodes of a scene. It is
+ * updated incrementally: the scene inserts and removes nodes (nodeAdded / nodeRemoved ...) and
+ * renames or type changes of an indexed node are followed through its change signals.
+ *
+ * Searches are case-insensitive and return pages of node handles (HandleRegistryCPP):
+ *      prefix:    O(log N + page) on the sorted titles
+ *      substring: one scan over the contiguous folded titles
+ * ************************************************************************************************/
+class NodeIndexCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(NodeIndex)
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit NodeIndexCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Index a node (title, type), nodes that are already indexed are skipped
+    Q_INVOKABLE void insert(QObject *node);
+    Q_INVOKABLE void insertAll(const QVariantList &nodes);
+
+    Q_INVOKABLE void remove(QObject *node);
+    Q_INVOKABLE void removeAll(const QVariantList &nodes);
+
+    Q_INVOKABLE void clear();
+
+    //! Number of indexed nodes of a type
+    Q_INVOKABLE int  typeCount(int type) const;
+
+    //! Page of the nodes whose title starts with / contains text:
+    //! {total, offset, handles: [handle]}. limit < 0: all results
+    Q_INVOKABLE QVariantMap findByPrefix(const QString &text, int offset = 0, int limit = 100) const;
+    Q_INVOKABLE QVariantMap findBySubstring(const QString &text, int offset = 0, int limit = 100) const;
+
+    //! Page of the nodes of a type
+    Q_INVOKABLE QVariantMap findByType(int type, int offset = 0, int limit = 100) const;
+
+    int count() const;
+
+signals:
+    void countChanged();
+
+private slots:
+    void onTitleChanged();
+    void onTypeChanged();
+    void onNodeDestroyed(QObject *node);
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Entry {
+        int     handle;
+        int     type;
+        QString foldedTitle;
+        int     row;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Call slot (normalized signature) when the property of node changes
+    void watchProperty(QObject *node, const char *property, const char *slot);
+
+    void removeEntry(QObject *node);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QHash<QObject *, Entry> mEntries;
+
+    //! (folded title, handle), sorted for prefix search
+    std::set<std::pair<QString, int>> mSortedTitles;
+
+    //! Rows of the scans, removed by swapping with the last row
+    QVector<QString>   mRowTitles;
+    QVector<int>       mRowTypes;
+    QVector<int>       mRowHandles;
+    QVector<QObject *> mRowNodes;
+
+    QHash<int, int>    mTypeCounts;
+};
+
+#endif // NODEINDEXCPP_H
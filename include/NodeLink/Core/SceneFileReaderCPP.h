@@ -0,0 +1,75 @@
+#ifndef SCENEFILEREADERCPP_H
+#define SCENEFILEREADERCPP_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QString>
+#include <QVariantMap>
+#include <QQmlEngine>
+
+/*! ***********************************************************************************************
+ * SceneFileReaderCPP reads and parses a scene file (.QQS.json) on a worker thread, so the GUI
+ * thread is not blocked by file IO and JSON parsing of large projects.
+ *
+ * With renewUuids the objects get new UUIDs (keys, qqs:/ references and UUID keys of maps such
+ * as ports), so the file can be loaded next to objects that were loaded from it before.
+ * ************************************************************************************************/
+class SceneFileReaderCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(SceneFileReader)
+
+    Q_PROPERTY(bool busy        READ busy        NOTIFY busyChanged)
+    Q_PROPERTY(bool renewUuids  READ renewUuids  WRITE setRenewUuids NOTIFY renewUuidsChanged)
+
+public:
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit SceneFileReaderCPP(QObject *parent = nullptr);
+    ~SceneFileReaderCPP();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Start reading filePath, emits finished() or failed() when done.
+    Q_INVOKABLE bool read(const QString &filePath);
+
+    //! Drop the result of the running read.
+    Q_INVOKABLE void cancel();
+
+    bool busy() const;
+
+    bool renewUuids() const;
+    void setRenewUuids(bool renewUuids);
+
+signals:
+    void busyChanged();
+    void renewUuidsChanged();
+
+    //! Parsed file objects, map <UUID, object properties>
+    void finished(const QVariantMap &objects);
+
+    void failed(const QString &error);
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct ReadResult {
+        QVariantMap objects;
+        QString     error;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    static ReadResult readFile(const QString &filePath, bool renewUuids);
+    void onReadFinished();
+
+    /* Attributes
+     * ****************************************************************************************/
+    QFutureWatcher<ReadResult> mWatcher;
+
+    bool mIsCancelled;
+    bool mRenewUuids;
+};
+
+#endif // SCENEFILEREADERCPP_H
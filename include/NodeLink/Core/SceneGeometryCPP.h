@@ -0,0 +1,64 @@
+#ifndef SCENEGEOMETRYCPP_H
+#define SCENEGEOMETRYCPP_H
+
+#include <QObject>
+#include <QPointer>
+#include <QRectF>
+#include <QVariantList>
+#include <QQmlEngine>
+
+#include <memory>
+
+#include "GeometryStoreCPP.h"
+
+/*! ***********************************************************************************************
+ * SceneGeometryCPP gives QML the geometry queries of a repository (scene): the node columns of
+ * its GeometryStoreCPP are scanned in C++ instead of reading guiConfig properties in a loop.
+ *
+ * Queries return the owners of the rows (the nodes), rows without owner are skipped.
+ * ************************************************************************************************/
+class SceneGeometryCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(SceneGeometry)
+
+    Q_PROPERTY(QObject *repo READ repo WRITE setRepo NOTIFY repoChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit SceneGeometryCPP(QObject *parent = nullptr);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    GeometryStoreCPP *store() const;
+
+    Q_INVOKABLE int          nodeCount() const;
+
+    //! Bounding rectangle of all nodes
+    Q_INVOKABLE QRectF       nodesBoundingRect() const;
+
+    //! Nodes that overlap the rectangle (touching edges do not overlap)
+    Q_INVOKABLE QVariantList nodesInRect(const QRectF &rect) const;
+
+    //! Nodes whose center is inside the polygon or whose rectangle intersects it.
+    //! points: [{x, y}] or [point]
+    Q_INVOKABLE QVariantList nodesInPolygon(const QVariantList &points) const;
+
+    //! A node at the point, null if there is none
+    Q_INVOKABLE QObject     *nodeAt(qreal x, qreal y) const;
+
+    QObject *repo() const;
+    void     setRepo(QObject *repo);
+
+signals:
+    void repoChanged();
+
+private:
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QObject>                 mRepo;
+    std::shared_ptr<GeometryStoreCPP> mStore;
+};
+
+#endif // SCENEGEOMETRYCPP_H
@@ -0,0 +1,96 @@
+#ifndef STARTUPPROFILERCPP_H
+#define STARTUPPROFILERCPP_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include <QQmlEngine>
+#include <QJSEngine>
+#include <QQuickWindow>
+
+/*! ***********************************************************************************************
+ * StartupProfilerCPP records the startup time of an application as named phases, e.g.
+ *      engineInit        construction of the QML engine
+ *      moduleImport      loading of the QML modules (plugins, qmldir, type registration)
+ *      mainComponent     compilation and creation of the main component
+ *      componentWarmup   background compilation of the views and node types (ObjectCreator)
+ *      firstFrame        from the end of the main component to the first frame on screen
+ *
+ * Times are milliseconds since the profiler was created, so the application creates it first
+ * thing in main(). Phases may overlap (the warm-up runs in the background).
+ * With NODELINK_STARTUP_PROFILE set in the environment, the report is printed after the first
+ * frame.
+ * ************************************************************************************************/
+class StartupProfilerCPP : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(StartupProfiler)
+    QML_SINGLETON
+
+    Q_PROPERTY(QVariantList phases READ phases NOTIFY phasesChanged)
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit StartupProfilerCPP(QObject *parent = nullptr);
+
+    /* Singleton Instance Provider
+     * ****************************************************************************************/
+    //! Process-wide profiler, starts the clock on the first call
+    static StartupProfilerCPP *instance();
+
+    //! The QML singleton is the process-wide profiler, it stays owned by C++
+    static StartupProfilerCPP* create(QQmlEngine *qmlEngine, QJSEngine *jsEngine)
+    {
+        Q_UNUSED(qmlEngine);
+        Q_UNUSED(jsEngine);
+        QJSEngine::setObjectOwnership(instance(), QJSEngine::CppOwnership);
+        return instance();
+    }
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Start a phase, a phase may be started again after it has ended
+    Q_INVOKABLE void    begin(const QString &phase);
+
+    //! End the last started phase with this name
+    Q_INVOKABLE void    end(const QString &phase);
+
+    //! Ends firstFrame (started now) when the window has shown its first frame
+    Q_INVOKABLE void    trackFirstFrame(QQuickWindow *window);
+
+    //! Milliseconds since the profiler was created
+    Q_INVOKABLE double  elapsedMs() const;
+
+    //! Text table of the phases, one line per phase
+    Q_INVOKABLE QString report() const;
+
+    Q_INVOKABLE void    reset();
+
+    //! [{name, startMs, durationMs}], durationMs is -1 while the phase runs
+    QVariantList        phases() const;
+
+signals:
+    void phasesChanged();
+
+    //! The first frame was shown, see trackFirstFrame()
+    void firstFrameShown();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Phase {
+        QString name;
+        double  startMs    = 0;
+        double  durationMs = -1;
+    };
+
+    /* Attributes
+     * ****************************************************************************************/
+    QElapsedTimer   mClock;
+    QVector<Phase>  mPhases;
+};
+
+#endif // STARTUPPROFILERCPP_H
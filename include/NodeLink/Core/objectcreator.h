@@ -5,16 +5,22 @@
 #include <QQmlEngine>
 #include <QQmlComponent>
 #include <QQuickItem>
+#include <QElapsedTimer>
+#include <QStringList>
 #include <QVector>
 #include <QVariantMap>
 #include <QtQml/qqmlregistration.h>
 
+#include <functional>
+
 class ObjectCreator : public QObject
 {
     Q_OBJECT
     QML_NAMED_ELEMENT(ObjectCreator)
     QML_SINGLETON
 
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY pendingCountChanged)
+
 public:
     explicit ObjectCreator(QObject *parent = nullptr);
     ~ObjectCreator();
@@ -33,11 +39,44 @@ public:
         const QVariantMap &baseProperties
         );
 
+    //! Compile components in the background into the component cache (warm-up):
+    //! componentUrls are view urls, shared with createItem() and createItems(),
+    //! typeNames are QML types looked up in the first of imports that has them.
+    //! preloadFinished() is emitted when nothing is pending.
+    Q_INVOKABLE void preload(
+        QObject *context,
+        const QStringList &componentUrls,
+        const QStringList &typeNames = QStringList(),
+        const QStringList &imports = QStringList()
+        );
+
+    //! Components and types still compiling
+    int pendingCount() const;
+
+signals:
+    void pendingCountChanged();
+
+    //! Warm-up done: {components, types, errors, elapsedMs}
+    void preloadFinished(const QVariantMap &stats);
+
 private:
     QQmlEngine *m_engine;
     QHash<QString, QQmlComponent*> m_components;
 
+    int m_pendingCount;
+    QElapsedTimer m_preloadTimer;
+    QVariantMap m_preloadStats;
+
     QQmlComponent* getOrCreateComponent(const QString &componentUrl);
+
+    //! Load typeName from modules[moduleIndex], the next module is tried on error
+    void preloadType(const QString &typeName, const QStringList &modules, int moduleIndex);
+
+    //! Calls done(ready) once component is no longer loading, always from the event loop
+    void whenLoaded(QQmlComponent *component, const std::function<void(bool)> &done);
+
+    void beginPending();
+    void endPending(const QString &counter);
 };
 
 #endif
@@ -24,6 +24,20 @@ I_Node {
         _qsRepo: root._qsRepo
     }
 
+    //! Cached summary shown while the container is collapsed (not saved)
+    //! bounds:         bounding rect of the inner nodes and containers
+    //! nodeCount:      number of inner nodes
+    //! containerCount: number of inner containers
+    //! inputPorts:     inner ports linked from outside the container
+    //! outputPorts:    inner ports linking to outside the container
+    property var _summary: ({
+        bounds:         Qt.rect(0, 0, 0, 0),
+        nodeCount:      0,
+        containerCount: 0,
+        inputPorts:     [],
+        outputPorts:    []
+    })
+
     /* Object Properties
     * ****************************************************************************************/
     objectType:     NLSpec.ObjectType.Container
@@ -68,4 +82,47 @@ I_Node {
         delete containersInside[container._qsUuid];
         containersInsideChanged();
     }
+
+    //! Update the cached summary, links is the scene links map
+    function updateSummary(links) {
+        var innerPorts = {};
+        var innerItems = [...Object.values(nodes), ...Object.values(containersInside)];
+
+        Object.values(nodes).forEach(node => {
+            Object.keys(node.ports).forEach(portId => innerPorts[portId] = true);
+        });
+
+        var left = Infinity, top = Infinity, right = -Infinity, bottom = -Infinity;
+        innerItems.forEach(item => {
+            var cfg = item.guiConfig;
+            left   = Math.min(left,   cfg.position.x);
+            top    = Math.min(top,    cfg.position.y);
+            right  = Math.max(right,  cfg.position.x + cfg.width);
+            bottom = Math.max(bottom, cfg.position.y + cfg.height);
+        });
+
+        // Links with exactly one end inside the container cross its boundary
+        var inputPorts = {};
+        var outputPorts = {};
+        Object.values(links ?? {}).forEach(link => {
+            if (!link?.inputPort || !link?.outputPort)
+                return;
+
+            var upstreamInside   = innerPorts[link.inputPort._qsUuid]  ?? false;
+            var downstreamInside = innerPorts[link.outputPort._qsUuid] ?? false;
+            if (upstreamInside && !downstreamInside)
+                outputPorts[link.inputPort._qsUuid] = link.inputPort;
+            else if (!upstreamInside && downstreamInside)
+                inputPorts[link.outputPort._qsUuid] = link.outputPort;
+        });
+
+        _summary = {
+            bounds:         innerItems.length > 0 ? Qt.rect(left, top, right - left, bottom - top)
+                                                  : Qt.rect(0, 0, 0, 0),
+            nodeCount:      Object.keys(nodes).length,
+            containerCount: Object.keys(containersInside).length,
+            inputPorts:     Object.values(inputPorts),
+            outputPorts:    Object.values(outputPorts)
+        };
+    }
 }
@@ -27,6 +27,10 @@ QSObject {
     //! Lock
     property bool     locked:              false
 
+    //! Collapsed: inner node, link and container views are not instantiated,
+    //! the container shows its cached summary instead
+    property bool     collapsed:           false
+
     //! Title text height
     property int      containerTextHeight: 35
 }
@@ -48,6 +48,53 @@ QSObject {
         // _qsRepo will be set in Component.onCompleted to ensure proper type
     }
 
+    //! Objects inside collapsed containers, their views and undo observers are not instantiated.
+    //! Nested collapsed containers are covered by the outermost one.
+    //! map <node UUID, collapsed container UUID>
+    property var            _collapsedNodes:      ({})
+
+    //! map <port UUID, collapsed container UUID>, ports of the collapsed nodes
+    property var            _collapsedPorts:      ({})
+
+    //! map <container UUID, collapsed container UUID>
+    property var            _collapsedContainers: ({})
+
+    //! Interned integer handles of the nodes, ports and links for O(1) lookups,
+    //! see HandleRegistryCPP
+    property HandleRegistry _handles: HandleRegistry {
+        target: scene
+    }
+
+    //! Node geometry of the repository in struct-of-arrays columns, see GeometryStoreCPP
+    property SceneGeometry  _geometry: SceneGeometry {
+        repo: scene._qsRepo
+    }
+
+    //! Per-type node counts and title search, updated on node add/remove, see NodeIndexCPP
+    property NodeIndex      _nodeIndex: NodeIndex {}
+
+    //! Control points of the links, routed around the nodes, see LinkRouterCPP.
+    //! Disable it to use BasicLinkCalculator. Only the nodes of the scene are obstacles, nodes
+    //! without views are not: a NodesRect also passes the nodes of its paged out containers
+    property LinkRouter     _linkRouter: LinkRouter {
+        repo: scene._qsRepo
+        scene: scene
+        hiddenNodes: scene._collapsedNodes
+    }
+
+    //! Memory accounting of the scene objects and views, see memoryStats()
+    property MemoryStats    _memoryStats: MemoryStats {
+        target: scene
+    }
+
+    //! The graph is being evaluated asynchronously, see evaluate()
+    property bool           _evaluating: false
+
+    //! Undoable load of a file into the scene, see loadFile()
+    property Component      _loadFileCommand: Component {
+        LoadFileCommand {}
+    }
+
     /* Signals
      * ****************************************************************************************/
 
@@ -81,6 +128,9 @@ QSObject {
     //! Container Removed
     signal containerRemoved(Container container)
 
+    //! Collapsed containers or their inner objects changed, the collapsed maps are updated
+    signal collapsedContainersUpdated()
+
     //! Copy Nodes 
     signal copyCalled();
 
@@ -171,7 +221,8 @@ QSObject {
         target: _sceneActiveRepoObject
         function onIsLoadingChanged() {
             if (_sceneActiveRepoObject._isLoading) {
-                Object.values(nodes).forEach(node => nodeRemoved(node));
+                // One batch for the nodes, the views rebuild their lists once
+                nodesRemoved(Object.values(nodes));
                 Object.values(links).forEach(link => linkRemoved(link));
                 Object.values(containers).forEach(container => containerRemoved(container));
             } else {
@@ -187,13 +238,73 @@ QSObject {
                     }
                 }
                 
-                Object.values(nodes).forEach(node => nodeAdded(node));
-                Object.values(links).forEach(link => linkAdded(link));
+                // nodes and links were replaced as a whole
+                _handles.rebuild();
+
+                // Update collapsed maps first so the views skip the collapsed objects
+                updateCollapsedContainers();
+
+                nodesAdded(Object.values(nodes));
+                linksAdded(Object.values(links));
                 Object.values(containers).forEach(container => containerAdded(container));
             }
         }
     }
 
+    //! Keep the node index in sync, every add/remove path emits these signals
+    property Connections _nodeIndexCon: Connections {
+        target: scene
+        function onNodeAdded(node)     { _nodeIndex.insert(node); }
+        function onNodesAdded(nodes)   { _nodeIndex.insertAll(nodes); }
+        function onNodeRemoved(node)   { _nodeIndex.remove(node); }
+        function onNodesRemoved(nodes) { _nodeIndex.removeAll(nodes); }
+    }
+
+    //! Removed nodes stay in the repository while the undo stack holds them, they are no
+    //! obstacles of the link routes
+    property Connections _linkRouterCon: Connections {
+        target: scene
+        function onNodeAdded(node)     { _linkRouter.addNodes([node]); }
+        function onNodesAdded(nodes)   { _linkRouter.addNodes(nodes); }
+        function onNodeRemoved(node)   { _linkRouter.removeNodes([node]); }
+        function onNodesRemoved(nodes) { _linkRouter.removeNodes(nodes); }
+    }
+
+    //! Keep the collapsed maps in sync with the collapsed state and the content of containers
+    property Instantiator _collapseWatchers: Instantiator {
+        model: Object.values(scene.containers)
+
+        delegate: QtObject {
+            property Connections _guiConfigCon: Connections {
+                target: modelData.guiConfig
+
+                function onCollapsedChanged() {
+                    Qt.callLater(scene.updateCollapsedContainers);
+                }
+            }
+
+            property Connections _contentCon: Connections {
+                target: modelData
+                enabled: modelData.guiConfig.collapsed
+
+                function onNodesChanged() {
+                    Qt.callLater(scene.updateCollapsedContainers);
+                }
+
+                function onContainersInsideChanged() {
+                    Qt.callLater(scene.updateCollapsedContainers);
+                }
+            }
+        }
+    }
+
+    //! Containers and links change the collapsed maps and the boundary ports of summaries
+    onContainersChanged: Qt.callLater(scene.updateCollapsedContainers);
+    onLinksChanged: {
+        if (Object.keys(_collapsedNodes).length > 0)
+            Qt.callLater(scene.updateCollapsedContainers);
+    }
+
     //! Creates a new container
     function createContainer() {
         let obj = QSSerializer.createQSObject("Container", ["NodeLink"], sceneActiveRepo);
@@ -225,10 +336,7 @@ QSObject {
 
         // Push command (skip during replay)
         if (!scene._undoCore.undoStack.isReplaying) {
-            var cmdAddContainer = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; AddContainerCommand { }', scene._undoCore.undoStack)
-            cmdAddContainer.scene = scene
-            cmdAddContainer.container = container
-            scene._undoCore.undoStack.push(cmdAddContainer)
+            scene._undoCore.undoStack.pushAddContainer(scene, container)
         }
 
         return container;
@@ -250,10 +358,7 @@ QSObject {
         // Push undo command BEFORE destroying container (skip during replay)
         // This allows undo to restore the container
         if (!scene._undoCore.undoStack.isReplaying && containerRef) {
-            var cmdRemoveContainer = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; RemoveContainerCommand { }', scene._undoCore.undoStack)
-            cmdRemoveContainer.scene = scene
-            cmdRemoveContainer.container = containerRef
-            scene._undoCore.undoStack.push(cmdRemoveContainer)
+            scene._undoCore.undoStack.pushRemoveContainer(scene, containerRef)
         }
         // Don't destroy container during replay - it needs to be preserved for undo
         // Container will be destroyed when command is cleaned up from stack
@@ -284,12 +389,9 @@ QSObject {
             // Push undo command BEFORE destroying containers (skip during replay)
             // This allows undo to restore the containers
             if (!scene._undoCore.undoStack.isReplaying) {
-                // Create individual RemoveContainerCommand for each container
+                // Push an individual remove container command for each container
                 for (var j = 0; j < removedContainers.length; j++) {
-                    var cmdRemoveContainer = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; RemoveContainerCommand { }', scene._undoCore.undoStack)
-                    cmdRemoveContainer.scene = scene
-                    cmdRemoveContainer.container = removedContainers[j]
-                    scene._undoCore.undoStack.push(cmdRemoveContainer)
+                    scene._undoCore.undoStack.pushRemoveContainer(scene, removedContainers[j])
                 }
             }
             // Don't destroy containers during replay - they need to be preserved for undo
@@ -299,6 +401,75 @@ QSObject {
         }
     }
 
+    //! Collapse or expand a container, views of its inner objects are released or created
+    function setContainerCollapsed(container: Container, collapsed: bool) {
+        if (!container || container.guiConfig.collapsed === collapsed)
+            return;
+
+        container.guiConfig.collapsed = collapsed;
+        updateCollapsedContainers();
+    }
+
+    //! Rebuild the collapsed maps and the summaries of collapsed containers
+    function updateCollapsedContainers() {
+        var collapsedNodes = {};
+        var collapsedPorts = {};
+        var collapsedContainers = {};
+
+        var collapsed = Object.values(containers).filter(container => container?.guiConfig?.collapsed ?? false);
+
+        // Collapsed containers inside another collapsed container are covered by the outer one
+        var covered = {};
+        collapsed.forEach(container => {
+            Object.keys(container.containersInside).forEach(innerId => covered[innerId] = true);
+        });
+
+        collapsed.forEach(container => {
+            var containerId = container._qsUuid;
+            if (covered[containerId])
+                return;
+
+            Object.values(container.nodes).forEach(node => {
+                if (nodes[node._qsUuid] !== node)
+                    return;
+
+                collapsedNodes[node._qsUuid] = containerId;
+                Object.keys(node.ports).forEach(portId => collapsedPorts[portId] = containerId);
+            });
+
+            Object.keys(container.containersInside).forEach(innerId => {
+                if (containers[innerId])
+                    collapsedContainers[innerId] = containerId;
+            });
+
+            container.updateSummary(links);
+        });
+
+        _collapsedNodes      = collapsedNodes;
+        _collapsedPorts      = collapsedPorts;
+        _collapsedContainers = collapsedContainers;
+
+        collapsedContainersUpdated();
+    }
+
+    //! Node is inside a collapsed container or not
+    function isNodeHidden(nodeId: string) : bool {
+        return _collapsedNodes[nodeId] !== undefined;
+    }
+
+    //! Container is inside a collapsed container or not
+    function isContainerHidden(containerId: string) : bool {
+        return _collapsedContainers[containerId] !== undefined;
+    }
+
+    //! Link is internal to a collapsed container or not. Links crossing the container
+    //! boundary stay visible and are attached to the summary ports of the container.
+    function isLinkHidden(link: Link) : bool {
+        var containerId = _collapsedPorts[link?.inputPort?._qsUuid ?? ""];
+        return containerId !== undefined &&
+               containerId === _collapsedPorts[link?.outputPort?._qsUuid ?? ""];
+    }
+
     //! Checks if scene is empty or not
     function isSceneEmpty() : bool {
         if (Object.keys(nodes).length === 0 && Object.keys(links).length === 0 && Object.keys(containers).length === 0)
@@ -306,6 +477,12 @@ QSObject {
         return false;
     }
 
+    //! Override this function in your scene
+    //! Evaluate the graph, e.g. for headless runs (SceneRunner). A scene that evaluates
+    //! asynchronously keeps _evaluating true until the node data is complete.
+    function evaluate() {
+    }
+
     //! Adds a node the to nodes map
     function addNode(node: Node, autoSelect: bool) : Node {
         //Sanity check - skip null or invalid nodes
@@ -320,6 +497,7 @@ QSObject {
 
         // Add to local administration
         nodes[node._qsUuid] = node;
+        _handles.addNode(node);
         nodesChanged();
         nodeAdded(node);
         node.nodeCompleted()
@@ -330,10 +508,7 @@ QSObject {
         }
 
         if (!scene._undoCore.undoStack.isReplaying) {
-            var cmdAddNode = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; AddNodeCommand { }', scene._undoCore.undoStack)
-            cmdAddNode.scene = scene
-            cmdAddNode.node = node
-            scene._undoCore.undoStack.push(cmdAddNode)
+            scene._undoCore.undoStack.pushAddNode(scene, node)
         }
 
         return node;
@@ -366,6 +541,7 @@ QSObject {
         }
 
         if (addedNodes.length > 0) {
+            _handles.addNodes(addedNodes);
             nodesChanged();
             nodesAdded(addedNodes);
 
@@ -376,10 +552,7 @@ QSObject {
 
             // Push undo command (skip during replay)
             if (!scene._undoCore.undoStack.isReplaying) {
-                var cmdAddNodes = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; AddNodesCommand { }', scene._undoCore.undoStack)
-                cmdAddNodes.scene = scene
-                cmdAddNodes.nodes = addedNodes
-                scene._undoCore.undoStack.push(cmdAddNodes)
+                scene._undoCore.undoStack.pushAddNodes(scene, addedNodes)
             }
         }
 
@@ -445,9 +618,13 @@ QSObject {
             delete nodes[nodeUUId];
         }
 
+        // Handlers of linkRemoved must not find the removed nodes
+        _handles.removeNodes(removedNodes);
+
         // Remove links from scene but don't destroy them (for undo/redo)
         affectedLinks.forEach(link => {
                                   if (links[link._qsUuid]) {
+                                      _handles.removeLink(link);
                                       linkRemoved(link);
                                       delete links[link._qsUuid];
                                   }
@@ -459,11 +636,7 @@ QSObject {
             // Push undo command BEFORE destroying nodes (skip during replay)
             // This allows undo to restore the nodes
             if (!scene._undoCore.undoStack.isReplaying) {
-                var cmdRemoveNodes = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; RemoveNodesCommand { }', scene._undoCore.undoStack)
-                cmdRemoveNodes.scene = scene
-                cmdRemoveNodes.nodes = removedNodes.slice() // Create a copy of the array
-                cmdRemoveNodes.links = affectedLinks.slice() // Create a copy of the array
-                scene._undoCore.undoStack.push(cmdRemoveNodes)
+                scene._undoCore.undoStack.pushRemoveNodes(scene, removedNodes, affectedLinks)
             }
             // Don't destroy nodes during replay - they need to be preserved for undo
             // Nodes will be destroyed when command is cleaned up from stack
@@ -513,11 +686,13 @@ QSObject {
                 }
                 if (value.inputPort._qsUuid === portId ||
                         value.outputPort._qsUuid === portId) {
+                    _handles.removeLink(value);
                     linkRemoved(value);
                     delete links[key];
                 }
             });
         });
+        _handles.removeNode(nodeRef);
         nodeRemoved(nodeRef);
 
         delete nodes[nodeUUId];
@@ -528,11 +703,7 @@ QSObject {
         // Push undo command BEFORE destroying node (skip during replay)
         // This allows undo to restore the node
         if (!scene._undoCore.undoStack.isReplaying && nodeRef) {
-            var cmdRemoveNode = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; RemoveNodeCommand { }', scene._undoCore.undoStack)
-            cmdRemoveNode.scene = scene
-            cmdRemoveNode.node = nodeRef
-            cmdRemoveNode.links = connectedLinks.slice() // Create a copy of the array
-            scene._undoCore.undoStack.push(cmdRemoveNode)
+            scene._undoCore.undoStack.pushRemoveNode(scene, nodeRef, connectedLinks)
         }
         // Don't destroy node during replay - it needs to be preserved for undo
         // Node will be destroyed when command is cleaned up from stack
@@ -650,7 +821,9 @@ QSObject {
 
             // Create the link object
             let obj = NLCore.createLink();
-            obj.guiConfig.colorIndex = linkData.colorIndex !== undefined ? linkData.colorIndex : 0;
+            const colorIndex = linkData.colorIndex !== undefined ? linkData.colorIndex : 0;
+            if (obj.guiConfig.colorIndex !== colorIndex)
+                obj.mutableGuiConfig().colorIndex = colorIndex;
             obj.inputPort = findPort(linkData.portA);
             obj.outputPort = findPort(linkData.portB);
             obj._qsRepo = sceneActiveRepo;
@@ -666,6 +839,7 @@ QSObject {
         }
 
         if (addedLinks.length > 0) {
+            _handles.addLinks(addedLinks);
             linksChanged();
             linksAdded(addedLinks);
         }
@@ -735,6 +909,7 @@ QSObject {
         }
 
         if (restoredLinks.length > 0) {
+            _handles.addLinks(restoredLinks);
             linksChanged();
             linksAdded(restoredLinks);
         }
@@ -742,10 +917,46 @@ QSObject {
         return restoredLinks;
     }
 
+    //! Adds already created links at once (used by progressive loading).
+    //! The ports of the links must belong to scene nodes; unlike restoreLinks() no port lookup
+    //! is done, so the node parents/children relations are updated by the caller.
+    function addLinks(linkArray: list<Link>) : list<Link> {
+        if (!linkArray || linkArray.length === 0) {
+            return [];
+        }
+
+        var addedLinks = [];
+
+        for (var i = 0; i < linkArray.length; i++) {
+            var link = linkArray[i];
+
+            // Skip invalid links and links already in scene
+            if (!link || !link._qsUuid || !link.inputPort || !link.outputPort) {
+                continue;
+            }
+
+            if (links[link._qsUuid] === link) {
+                continue;
+            }
+
+            links[link._qsUuid] = link;
+            addedLinks.push(link);
+        }
+
+        if (addedLinks.length > 0) {
+            _handles.addLinks(addedLinks);
+            linksChanged();
+            linksAdded(addedLinks);
+        }
+
+        return addedLinks;
+    }
+
     //! Link two nodes (via their ports) - portA is the upstream and portB the downstream one
     function createLink(portA : string, portB : string) : Link {
             let obj = NLCore.createLink();
-            obj.guiConfig.colorIndex = 0;
+            if (obj.guiConfig.colorIndex !== 0)
+                obj.mutableGuiConfig().colorIndex = 0;
             obj.inputPort  = findPort(portA);
             obj.outputPort = findPort(portB);
             obj._qsRepo = sceneActiveRepo;
@@ -764,17 +975,13 @@ QSObject {
             }
             
             links[obj._qsUuid] = obj;
+            _handles.addLink(obj);
             linksChanged();
 
             // Add link into UI
             linkAdded(obj);
             if (!scene._undoCore.undoStack.isReplaying) {
-                var cmdCreateLink = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; CreateLinkCommand { }', scene._undoCore.undoStack)
-                cmdCreateLink.scene = scene
-                cmdCreateLink.inputPortUuid = portA
-                cmdCreateLink.outputPortUuid = portB
-                cmdCreateLink.createdLink = obj // Set the created link object
-                scene._undoCore.undoStack.push(cmdCreateLink)
+                scene._undoCore.undoStack.pushCreateLink(scene, portA, portB, obj)
             }
             return obj;
     }
@@ -809,6 +1016,7 @@ QSObject {
                     nodeY.parentsChanged()
                 }
 
+                _handles.removeLink(value);
                 linkRemoved(value);
                 selectionModel.remove(key);
                 delete links[key];
@@ -817,18 +1025,77 @@ QSObject {
         linksChanged();
 
         if (!scene._undoCore.undoStack.isReplaying && removedLinkRef) {
-            var cmdUnlink = Qt.createQmlObject('import QtQuick; import NodeLink; import "Undo/Commands"; UnlinkCommand { }', scene._undoCore.undoStack)
-            cmdUnlink.scene = scene
-            cmdUnlink.inputPortUuid = portA
-            cmdUnlink.outputPortUuid = portB
-            cmdUnlink.removedLink = removedLinkRef
-            scene._undoCore.undoStack.push(cmdUnlink)
+            scene._undoCore.undoStack.pushUnlink(scene, portA, portB, removedLinkRef)
         }
     }
 
+    //! Removes nodes from the scene without deleting them (undo of an add, used by CommandStack)
+    //! Links are handled by their own commands
+    function _detachNodes(nodeArray: list<Node>) {
+        var isChanged = false;
+        for (var i = 0; i < nodeArray.length; i++) {
+            var node = nodeArray[i];
+            if (!node || !node._qsUuid || !nodes[node._qsUuid]) {
+                continue;
+            }
+
+            selectionModel.remove(node._qsUuid);
+            _handles.removeNode(node);
+            nodeRemoved(node);
+            delete nodes[node._qsUuid];
+            isChanged = true;
+        }
+
+        if (isChanged)
+            nodesChanged();
+    }
+
+    //! Removes a container from the scene without deleting it (used by CommandStack)
+    function _detachContainer(container: Container) {
+        if (!container || !container._qsUuid || !containers[container._qsUuid]) {
+            return;
+        }
+
+        selectionModel.remove(container._qsUuid);
+        containerRemoved(container);
+        delete containers[container._qsUuid];
+        containersChanged();
+    }
+
+    //! Removes a link from the scene without deleting it (used by CommandStack)
+    function _detachLink(link: Link) {
+        if (!link || !link._qsUuid || !links[link._qsUuid]) {
+            return;
+        }
+
+        // Remove parent/children relationships before removing link
+        if (link.inputPort && link.outputPort) {
+            let nodeX = findNode(link.inputPort._qsUuid);
+            let nodeY = findNode(link.outputPort._qsUuid);
+
+            if (nodeX && nodeY) {
+                if (Object.keys(nodeX.children).includes(nodeY._qsUuid)) {
+                    delete nodeX.children[nodeY._qsUuid];
+                    nodeX.childrenChanged();
+                }
+
+                if (Object.keys(nodeY.parents).includes(nodeX._qsUuid)) {
+                    delete nodeY.parents[nodeX._qsUuid];
+                    nodeY.parentsChanged();
+                }
+            }
+        }
+
+        _handles.removeLink(link);
+        linkRemoved(link);
+        selectionModel.remove(link._qsUuid);
+        delete links[link._qsUuid];
+        linksChanged();
+    }
+
     //! Finds the node according given portId
     function findNodeId(portId: string) : string {
-        return Object.values(nodes).find( node => node.findPort(portId) !== null )?._qsUuid ?? "";
+        return _handles.uuid(_handles.nodeOfPort(_handles.handle(portId)));
     }
 
     //! Finds Node using its ID
@@ -836,23 +1103,47 @@ QSObject {
         return Object.values(nodes).find(node => node._qsUuid === nodeId);
     }
 
+    //! Page of the nodes whose title starts with text (contains text if substring is true),
+    //! case-insensitive: {total, offset, handles}. _handles.node(handle) returns the node.
+    //! API for applications, NodeLink itself has no search view.
+    function searchNodes(text: string, substring: bool, offset: int, limit: int) : var {
+        return substring ? _nodeIndex.findBySubstring(text, offset, limit)
+                         : _nodeIndex.findByPrefix(text, offset, limit);
+    }
+
+    //! Memory report of the scene: object counts and estimated bytes per category, JS heap,
+    //! items of view (optional, e.g. the scene view) and process memory, see MemoryStatsCPP
+    function memoryStats(view = null) : var {
+        _memoryStats.view = view;
+        return _memoryStats.collect();
+    }
+
+    //! Replaces the nodes, links and containers with the ones of the file (undoable), the scene
+    //! itself and its configuration are kept. A progressive load reads the file on a worker
+    //! thread and adds the objects in chunks, the returned LoadFileCommand reports isLoading and
+    //! progress and can be cancelled.
+    function loadFile(filePath: url, progressive: bool) : var {
+        var command = _loadFileCommand.createObject(scene._undoCore, {
+            scene: scene,
+            repo: scene.sceneActiveRepo,
+            filePath: filePath,
+            progressive: progressive
+        });
+
+        // Executes redo(), which starts the load
+        scene._undoCore.undoStack.push(command, false);
+
+        return command;
+    }
+
     //! Finds the exact node according to the given portId
     function findNode(portId: string) : Node {
-        let foundNodeId = findNodeId(portId);
-        if  (Object.keys(nodes).includes(foundNodeId))
-            return nodes[foundNodeId];
-        return null;
+        return _handles.node(_handles.nodeOfPort(_handles.handle(portId)));
     }
 
     //! Finds port object from port id
     function findPort(portId: string) : Port {
-        var portObj = null;
-        Object.values(nodes).find(node => {
-            let foundPort = node.findPort(portId);
-            if (foundPort !== null) {
-                portObj = foundPort;
-            }});
-        return portObj;
+        return _handles.port(_handles.handle(portId));
     }
 
     //! Delete all selected objects (Node + Link + Container)
@@ -902,10 +1193,12 @@ QSObject {
 
         var matches = [];
 
-        function scan(map) {
+        function scan(map, hiddenMap) {
             if (!map) return;
             for (var key in map) {
                 if (!map.hasOwnProperty(key)) continue;
+                // Objects inside collapsed containers are not selectable
+                if (hiddenMap[key] !== undefined) continue;
                 var item = map[key];
                 if (!item || !item.guiConfig) continue;
 
@@ -928,8 +1221,13 @@ QSObject {
             }
         }
 
-        scan(nodes);
-        scan(containers);
+        // Nodes are tested on the geometry columns
+        _geometry.nodesInRect(Qt.rect(bandLeft, bandTop, containerItem.width, containerItem.height))
+                 .forEach(node => {
+            if (nodes[node._qsUuid] === node && _collapsedNodes[node._qsUuid] === undefined)
+                matches.push(node);
+        });
+        scan(containers, _collapsedContainers);
 
         return matches;
     }
@@ -1025,10 +1323,12 @@ QSObject {
 
         var matches = [];
 
-        function scanMap(mapObj) {
+        function scanMap(mapObj, hiddenMap) {
             if (!mapObj) return;
             for (var k in mapObj) {
                 if (!mapObj.hasOwnProperty(k)) continue;
+                // Objects inside collapsed containers are not selectable
+                if (hiddenMap[k] !== undefined) continue;
                 var item = mapObj[k];
                 if (!item || !item.guiConfig) continue;
 
@@ -1049,8 +1349,12 @@ QSObject {
             }
         }
 
-        scanMap(scene.nodes);
-        scanMap(scene.containers);
+        // Nodes are tested on the geometry columns
+        _geometry.nodesInPolygon(points).forEach(node => {
+            if (scene.nodes[node._qsUuid] === node && _collapsedNodes[node._qsUuid] === undefined)
+                matches.push(node);
+        });
+        scanMap(scene.containers, _collapsedContainers);
 
         return matches;
     }
@@ -15,6 +15,10 @@ QSObject {
     //! Image source picture
     property int coverImageIndex: -1
 
+    //! The shared empty model of NLSpec.memory.sharedDefaults, it is not written:
+    //! Node.mutableImagesModel() gives the node its own copy first
+    property bool isSharedDefault: false
+
     /* Functions
     * ****************************************************************************************/
     function addImage(base64int) {
@@ -23,19 +23,65 @@ I_Node {
     //! Direction
     property int        direction:      NLSpec.LinkDirection.Unidirectional
 
-    //! Link Ui properties
-    property LinkGUIConfig guiConfig: LinkGUIConfig {
-        _qsRepo: root._qsRepo
-    }
+    //! Link Ui properties. With NLSpec.memory.sharedDefaults it is set on completion
+    //! (NLCore.defaultLinkGuiConfig()) and may be the shared default config:
+    //! write it through mutableGuiConfig()
+    property LinkGUIConfig guiConfig: NLSpec.memory.sharedDefaults
+                                      ? null : NLCore.createLinkGuiConfig(root)
 
     /* Object Properties
     * ****************************************************************************************/
     objectType: NLSpec.ObjectType.Link
 
+    /* Signals
+     * ****************************************************************************************/
+    //! The link router (LinkRouterCPP) has a new route for the link, computed in a later frame
+    signal routeChanged()
+
+    /* Slots
+     * ****************************************************************************************/
+    //! The assignment ends the initial binding, the mode of a link does not change later
+    Component.onCompleted: {
+        guiConfig = guiConfig ?? NLCore.defaultLinkGuiConfig(root);
+    }
+
+    //! Store rows of shared configs have no owner
+    onGuiConfigChanged: {
+        if (guiConfig && !guiConfig.isSharedDefault)
+            guiConfig._owner = root;
+    }
+
+    //! A shared config belongs to one repo, moved links use the one of the new repo
+    onRepoChanged: {
+        if (guiConfig?.isSharedDefault && _qsRepo && guiConfig._qsRepo !== _qsRepo)
+            guiConfig = NLCore.sharedLinkGuiConfig(_qsRepo);
+    }
+
     /* Functions
      * ****************************************************************************************/
     //! Function for handling link guiconfgi when copying and pasting
     onCloneFrom: function (baseLink)  {
-        root.guiConfig?.setProperties(baseLink.guiConfig);
+        // A shared default config stays shared
+        if (baseLink.guiConfig?.isSharedDefault && root.guiConfig?.isSharedDefault)
+            return;
+
+        const config = root.mutableGuiConfig();
+        config.setProperties(baseLink.guiConfig);
+        config.isSharedDefault = false;
+    }
+
+    //! The gui config to write to, a shared default config is replaced by a copy first
+    function mutableGuiConfig() : LinkGUIConfig {
+        if (guiConfig && !guiConfig.isSharedDefault)
+            return guiConfig;
+
+        let config = NLCore.createLinkGuiConfig(root);
+        if (guiConfig) {
+            config.setProperties(guiConfig);
+            config.isSharedDefault = false;
+        }
+        guiConfig = config;
+
+        return config;
     }
 }
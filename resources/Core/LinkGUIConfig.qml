@@ -1,10 +1,15 @@
 import QtQuick
 import QtQuickStream
+import NodeLink
 
 /*! ***********************************************************************************************
  * The LinkGuiConfig is a QSObject that keep the Ui Link properties.
+ * Color, style and type are properties of LinkGuiConfigCPP, kept in the geometry store of the
+ * repository. setProperties() and the QSObject signals come from GuiConfigCPP.
  * ************************************************************************************************/
-QSObject {
+LinkGuiConfigCPP {
+    id: root
+
     Component.onDestruction: _qsRepo?.unregisterObject(this)
     /* Property Properties
      * ****************************************************************************************/
@@ -12,18 +17,18 @@ QSObject {
     //! Link description
     property string description: ""
 
-    //! Color
-    property string color:       "white"
-
     property int colorIndex:     -1
 
-    //! Style
-    property int    style:       NLSpec.LinkStyle.Solid
-
-    //! Type
-    property int    type:        NLSpec.LinkType.Bezier
+    //! The shared default config of NLSpec.memory.sharedDefaults, it is not written:
+    //! Link.mutableGuiConfig() gives the link its own copy first
+    property bool isSharedDefault: false
 
     //! isEditableDescription to handle editable description
     property bool _isEditableDescription: false
 
+    /* Object Properties
+     * ****************************************************************************************/
+    color: "white"
+    style: NLSpec.LinkStyle.Solid
+    type:  NLSpec.LinkType.Bezier
 }
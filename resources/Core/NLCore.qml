@@ -17,6 +17,15 @@ QSCore {
 
     property QtObject _internal: QtObject {
         readonly property var imports: [ "QtQuickStream", "NodeLink"]
+
+        //! Shared default instances (NLSpec.memory.sharedDefaults)
+        property ImagesModel sharedImagesModel:     null
+
+        //! [{repo, config}]
+        property var         sharedLinkGuiConfigs:  []
+
+        property Component   imagesModelComponent:   Component { ImagesModel {} }
+        property Component   linkGuiConfigComponent: Component { LinkGUIConfig {} }
     }
 
     //! Shallow Copied Nodes, to be used in paste when needed
@@ -64,4 +73,57 @@ QSCore {
         obj._qsRepo = defaultRepo;
         return obj;
     }
+
+    //! Create images model
+    function createImagesModel(parent = null) : ImagesModel {
+        return _internal.imagesModelComponent.createObject(parent);
+    }
+
+    //! Create link gui config, it follows the repo of the link
+    function createLinkGuiConfig(link) : LinkGUIConfig {
+        let obj = _internal.linkGuiConfigComponent.createObject(link);
+        obj._qsRepo = Qt.binding(() => link._qsRepo);
+        return obj;
+    }
+
+    //! Images model of a new node: the shared empty model in shared-default mode
+    function defaultImagesModel(node) : ImagesModel {
+        if (!NLSpec.memory.sharedDefaults)
+            return createImagesModel(node);
+
+        if (!_internal.sharedImagesModel) {
+            _internal.sharedImagesModel = createImagesModel(core);
+            _internal.sharedImagesModel.isSharedDefault = true;
+        }
+
+        return _internal.sharedImagesModel;
+    }
+
+    //! Gui config of a new link: the shared config of its repo in shared-default mode
+    function defaultLinkGuiConfig(link) : LinkGUIConfig {
+        if (!NLSpec.memory.sharedDefaults || !link._qsRepo)
+            return createLinkGuiConfig(link);
+
+        return sharedLinkGuiConfig(link._qsRepo);
+    }
+
+    //! The shared default link gui config of a repo, created on first use
+    function sharedLinkGuiConfig(qsRepo) : LinkGUIConfig {
+        // Entries of destroyed repos are dropped
+        _internal.sharedLinkGuiConfigs = _internal.sharedLinkGuiConfigs.filter(
+                    entry => entry.repo && entry.config);
+
+        let entry = _internal.sharedLinkGuiConfigs.find(entry => entry.repo === qsRepo);
+        if (!entry) {
+            let obj = _internal.linkGuiConfigComponent.createObject(core);
+            obj._qsRepo = qsRepo;
+            obj.colorIndex = 0;
+            obj.isSharedDefault = true;
+
+            entry = { repo: qsRepo, config: obj };
+            _internal.sharedLinkGuiConfigs.push(entry);
+        }
+
+        return entry.config;
+    }
 }
@@ -10,6 +10,14 @@ QtObject {
         property bool blockObservers: false
     }
 
+    //! Memory options, set them before the scene is created
+    property QtObject memory: QtObject {
+        //! Unmodified link gui configs and empty images models point to one shared instance,
+        //! a private copy is made on the first write (Link.mutableGuiConfig(),
+        //! Node.mutableImagesModel())
+        property bool sharedDefaults: false
+    }
+
     //! Object types
     enum ObjectType {
         Node = 0,
@@ -15,6 +15,7 @@ I_Node  {
     //! GUI Config
     property NodeGuiConfig  guiConfig:  NodeGuiConfig {
          _qsRepo: root._qsRepo
+         _owner: root
     }
 
 
@@ -34,8 +35,11 @@ I_Node  {
     //! map<uuid, Port>
     property var            ports:      ({})
 
-    //! Manages node images
-    property ImagesModel    imagesModel: ImagesModel {}
+    //! Manages node images. With NLSpec.memory.sharedDefaults it is set on completion
+    //! (NLCore.defaultImagesModel()) and may be the shared empty model:
+    //! write it through mutableImagesModel()
+    property ImagesModel    imagesModel: NLSpec.memory.sharedDefaults
+                                         ? null : NLCore.createImagesModel(root)
 
     /* Object Properties
     * ****************************************************************************************/
@@ -43,6 +47,16 @@ I_Node  {
 
     /* Slots
      * ****************************************************************************************/
+    //! The assignment ends the initial binding, the mode of a node does not change later
+    Component.onCompleted: {
+        imagesModel = imagesModel ?? NLCore.defaultImagesModel(root);
+    }
+
+    //! Geometry queries (SceneGeometry) return the node, also for a loaded guiConfig
+    onGuiConfigChanged: {
+        if (guiConfig)
+            guiConfig._owner = root;
+    }
 
     //! adds functionionality for this layer
     //! Handle clone node operation
@@ -51,7 +65,12 @@ I_Node  {
         title = baseNode.title;
         type  = baseNode.type;
 
-        root.imagesModel?.setProperties(baseNode.imagesModel);
+        // A shared empty model stays shared
+        if (!baseNode.imagesModel?.isSharedDefault) {
+            const model = root.mutableImagesModel();
+            model.setProperties(baseNode.imagesModel);
+            model.isSharedDefault = false;
+        }
         root.guiConfig?.setProperties(baseNode.guiConfig);
     }
 
@@ -86,6 +105,21 @@ I_Node  {
         }
     }
 
+    //! The images model to write to, a shared default model is replaced by a copy first
+    function mutableImagesModel() : ImagesModel {
+        if (imagesModel && !imagesModel.isSharedDefault)
+            return imagesModel;
+
+        let model = NLCore.createImagesModel(root);
+        if (imagesModel) {
+            model.setProperties(imagesModel);
+            model.isSharedDefault = false;
+        }
+        imagesModel = model;
+
+        return model;
+    }
+
     //! find port with portUuid
     function findPort(portId: string): Port {
         if (Object.keys(ports).includes(portId)) {
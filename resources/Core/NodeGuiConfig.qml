@@ -5,8 +5,13 @@ import QtQuickStream
 
 /*! ***********************************************************************************************
  * The NodeGuiConfig is a QSObject that keep the Ui Node properties.
+ * Position, width, height, color, opacity and locked are properties of NodeGuiConfigCPP, kept in
+ * the geometry store of the repository: C++ reads them without touching this object.
+ * setProperties() and the QSObject signals come from GuiConfigCPP.
  * ************************************************************************************************/
-QSObject {
+NodeGuiConfigCPP {
+    id: root
+
     Component.onDestruction: _qsRepo?.unregisterObject(this)
     /* Property Properties
      * ****************************************************************************************/
@@ -17,29 +22,11 @@ QSObject {
     //! \todo change to bytearray of image?
     property string     logoUrl:    ""
 
-    //! Position in the world
-    property vector2d   position:   Qt.vector2d(0.0, 0.0);
-
     //! 3D Position (optional, for 3D scenes)
     property vector3d   position3D: Qt.vector3d(0.0, 0.0, 0.0);
 
-    //! Width
-    property int        width:      NLStyle.node.width
-
-    //! Height
-    property int        height:     NLStyle.node.height
-
-    //! Color
-    property string     color:      NLStyle.node.color
-
     property  int       colorIndex: -1
 
-    //! Opacity
-    property real       opacity:    NLStyle.node.opacity
-
-    //! Lock
-    property bool       locked:     false
-
     //! Auto size node based on content and port titles
     property bool autoSize: true
 
@@ -49,4 +36,11 @@ QSObject {
 
     //! Base content width (space for operation/image in the middle)
     property int baseContentWidth: 100
+
+    /* Object Properties
+     * ****************************************************************************************/
+    width:   NLStyle.node.width
+    height:  NLStyle.node.height
+    color:   NLStyle.node.color
+    opacity: NLStyle.node.opacity
 }
@@ -62,7 +62,7 @@ I_Scene {
             return null;
         }
 
-        var title = nodeRegistry.nodeNames[nodeType] + "_" + (Object.values(root.nodes).filter(node => node.type === nodeType).length + 1);
+        var title = nodeRegistry.nodeNames[nodeType] + "_" + (root._nodeIndex.typeCount(nodeType) + 1);
         if (NLStyle.snapEnabled) {
             var position = snappedPosition(Qt.vector2d(xPos, yPos));
             xPos = position.x;
@@ -114,39 +114,25 @@ I_Scene {
         if (portA.length === 0 || portB.length === 0)
             return false;
 
-        // Find nodes first (cheaper than iterating all links)
-        var nodeA = findNodeId(portA);
-        var nodeB = findNodeId(portB);
+        // Identity checks compare interned handles
+        var handleA = _handles.handle(portA);
+        var handleB = _handles.handle(portB);
+        var nodeA = _handles.nodeOfPort(handleA);
+        var nodeB = _handles.nodeOfPort(handleB);
 
-        // Early exit: empty node IDs or same node
-        if (nodeA.length === 0 || nodeB.length === 0 ||
-            HashCompareString.compareStringModels(nodeA, nodeB)) {
+        // Early exit: unknown ports or same node
+        if (nodeA === 0 || nodeB === 0 || nodeA === nodeB)
             return false;
-        }
-
-        // Check port types (cheaper than iterating links)
-        var portAObj = findPort(portA);
-        var portBObj = findPort(portB);
 
-        if (!portAObj || !portBObj)
-            return false;
+        var portAObj = _handles.port(handleA);
+        var portBObj = _handles.port(handleB);
 
         // Input port cannot be source, output port cannot be destination
         if (portAObj.portType === NLSpec.PortType.Input ||
             portBObj.portType === NLSpec.PortType.Output)
             return false;
 
-        // Check for existing link (most expensive operation - do last)
-        var linkKeys = Object.keys(links);
-        for (var i = 0; i < linkKeys.length; i++) {
-            var link = links[linkKeys[i]];
-            if (link &&
-                HashCompareString.compareStringModels(link.inputPort._qsUuid, portA) &&
-                HashCompareString.compareStringModels(link.outputPort._qsUuid, portB)) {
-                return false;
-            }
-        }
-
-        return true;
+        // Check for existing link
+        return !_handles.hasLink(handleA, handleB);
     }
 }
@@ -0,0 +1,138 @@
+import QtQuick
+import QtQuickStream
+import NodeLink
+
+/*! ***********************************************************************************************
+ * SceneRunner evaluates a saved scene without views, e.g. for nodelink-run.
+ *
+ * load() loads the file objects into a new repository, then each run sets the inputs (apply()),
+ * evaluates the graph (evaluate()) and reads the node data (collect()). A scene with an
+ * asynchronous evaluation keeps I_Scene._evaluating true until its outputs are complete.
+ *
+ * Undo observers are blocked while the runner changes the scene, no commands are recorded.
+ * ************************************************************************************************/
+QtObject {
+    id: root
+
+    /* Property Declarations
+     * ****************************************************************************************/
+    //! Imports to create the scene objects, e.g. ["QtQuickStream", "Calculator"]
+    property var     imports: ["QtQuickStream", "NodeLink"]
+
+    //! Repository of the loaded scene
+    property var     repo: null
+
+    //! Loaded scene
+    property I_Scene scene: null
+
+    //! The scene is evaluating asynchronously
+    readonly property bool busy: scene?._evaluating ?? false
+
+    /* Functions
+     * ****************************************************************************************/
+    //! Load file objects (map <UUID, properties>), returns false on failure
+    function load(fileObjects) {
+        repo = NLCore.createDefaultRepo(imports);
+
+        NLSpec.undo.blockObservers = true;
+        var loaded = repo.loadRepo(fileObjects);
+        NLSpec.undo.blockObservers = false;
+
+        scene = loaded ? repo.qsRootObject : null;
+        if (!scene)
+            console.warn("SceneRunner: Failed to load the scene");
+
+        return scene !== null;
+    }
+
+    //! Set the inputs {<node UUID or title>: value} and returns the number of set properties.
+    //! A value sets nodeData.data, an object sets property paths: {"nodeData.data": 1, "imagePath": ""}
+    function apply(inputs) {
+        var count = 0;
+
+        NLSpec.undo.blockObservers = true;
+        Object.entries(inputs ?? {}).forEach(([key, value]) => {
+            var matchedNodes = findNodes(key);
+            if (matchedNodes.length === 0) {
+                console.warn("SceneRunner: No node", key);
+                return;
+            }
+
+            var assignments = (value !== null && typeof value === "object" && !Array.isArray(value))
+                              ? value : { "nodeData.data": value };
+
+            matchedNodes.forEach(node => {
+                Object.entries(assignments).forEach(([path, propertyValue]) => {
+                    if (_setProperty(node, path, propertyValue))
+                        count++;
+                    else
+                        console.warn("SceneRunner: No property", path, "in node", key);
+                });
+            });
+        });
+        NLSpec.undo.blockObservers = false;
+
+        return count;
+    }
+
+    //! Call the evaluation function of the scene, returns false if it does not exist
+    function evaluate(functionName) {
+        if (!scene || typeof scene[functionName] !== "function") {
+            console.warn("SceneRunner: The scene has no function", functionName);
+            return false;
+        }
+
+        NLSpec.undo.blockObservers = true;
+        scene[functionName]();
+        NLSpec.undo.blockObservers = false;
+
+        return true;
+    }
+
+    //! Node data of the given nodes (UUIDs or titles), of all nodes if keys is empty
+    //! [{uuid, title, type, value}]
+    function collect(keys) {
+        if (!scene)
+            return [];
+
+        var matchedNodes = [];
+        if (!keys || keys.length === 0)
+            matchedNodes = Object.values(scene.nodes);
+        else
+            keys.forEach(key => matchedNodes.push(...findNodes(key)));
+
+        return matchedNodes.map(node => ({
+            uuid:  node._qsUuid,
+            title: node.title,
+            type:  node.type,
+            value: node.nodeData?.data ?? null
+        }));
+    }
+
+    //! Nodes with the UUID or title
+    function findNodes(key) {
+        if (!scene)
+            return [];
+
+        var node = scene.nodes[key];
+        if (node)
+            return [node];
+
+        return Object.values(scene.nodes).filter(node => node.title === key);
+    }
+
+    function _setProperty(obj, path, value) {
+        var names = path.split(".");
+        var target = obj;
+        for (var i = 0; i < names.length - 1; i++) {
+            target = target?.[names[i]];
+        }
+
+        var name = names[names.length - 1];
+        if (!target || !(name in target))
+            return false;
+
+        target[name] = value;
+        return true;
+    }
+}
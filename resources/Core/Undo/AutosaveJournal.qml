@@ -0,0 +1,270 @@
+import QtQuick
+import QtQuickStream
+import NodeLink
+
+/*! ***********************************************************************************************
+ * AutosaveJournal appends every macro of the CommandStack (finalized, undone or redone) to a
+ * write-ahead journal as a compact record of the objects it touched, and writes a full
+ * checkpoint of the repository in the background every checkpointInterval. Autosave IO follows
+ * the edit rate, the scene is only dumped for checkpoints.
+ *
+ * Records hold the object images after the macro, so undo and redo are journaled the same way
+ * as new edits. Commands without known targets (e.g. LoadFileCommand) request a checkpoint.
+ *
+ * Usage: set scene and filePath, then call recover() if journal.hasRecoveryData(), otherwise
+ * start(). Call discard() once the scene is safe (saved, or the application closes cleanly), so
+ * recovery data only remains after an unclean exit.
+ * ************************************************************************************************/
+QtObject {
+    id: root
+
+    /* Property Declarations
+     * ****************************************************************************************/
+    //! Journaled scene, its repository is checkpointed and recovered
+    property I_Scene scene: null
+
+    //! Autosave base path, see JournalFile for the file names. Empty: journal.defaultFilePath
+    property string  filePath: ""
+
+    //! Autosave is running
+    property bool    enabled: false
+
+    //! Group commit interval (ms)
+    property int     commitInterval: 1000
+
+    //! Full checkpoint interval (ms)
+    property int     checkpointInterval: 5 * 60 * 1000
+
+    //! Checkpoint early when the journal grows beyond this size (bytes)
+    property real    maxJournalBytes: 64 * 1024 * 1024
+
+    //! Journal and checkpoint storage
+    property JournalFile journal: JournalFile {
+        filePath: root.filePath !== "" ? root.filePath : defaultFilePath
+        commitInterval: root.commitInterval
+
+        onBusyChanged: {
+            if (!busy)
+                Qt.callLater(root._checkpointIfRequested)
+        }
+        onCheckpointWritten: (sequence) => root._checkpointSequence = sequence
+        onRecovered: (objects, replayedRecords) => root._loadRecovered(objects, replayedRecords)
+        onFailed: (error) => console.warn("AutosaveJournal:", error)
+    }
+
+    //! Sequence of the last written checkpoint
+    property real    _checkpointSequence: -1
+
+    //! A checkpoint is waiting for the journal or a running load
+    property bool    _checkpointRequested: false
+
+    //! A progressive LoadFileCommand that is still adding objects
+    property var     _loadingCommand: null
+
+    property Timer _checkpointTimer: Timer {
+        interval: root.checkpointInterval
+        repeat: true
+        running: root.enabled && root.scene !== null
+
+        onTriggered: {
+            // Nothing to fold into a new checkpoint
+            if (root.journal.sequence !== root._checkpointSequence)
+                root.checkpoint()
+        }
+    }
+
+    property Connections _commandStackCon: Connections {
+        target: root.enabled ? root.scene?._undoCore?.undoStack ?? null : null
+
+        function onMacroApplied(macro) {
+            root.record(macro)
+        }
+    }
+
+    /* Signals
+     * ****************************************************************************************/
+    //! The recovered repository is loaded
+    signal recovered(int replayedRecords)
+
+    /* Object Properties
+     * ****************************************************************************************/
+    // A loaded or recovered scene replaces the journaled objects
+    onSceneChanged: {
+        if (enabled && scene)
+            requestCheckpoint()
+    }
+
+    /* Functions
+     * ****************************************************************************************/
+    //! Start autosave with a checkpoint of the current scene
+    function start() {
+        enabled = true
+        requestCheckpoint()
+    }
+
+    //! Stop autosave, the buffered records are committed
+    function stop() {
+        journal.commit()
+        enabled = false
+    }
+
+    //! Remove the autosave files, a running autosave continues from a new checkpoint
+    function discard() {
+        journal.discard()
+        _checkpointSequence = -1
+        if (enabled)
+            requestCheckpoint()
+    }
+
+    //! Load the latest checkpoint plus the journal tail, autosave starts afterwards
+    function recover() : bool {
+        return journal.recover()
+    }
+
+    //! Write a checkpoint now, returns false if it has to wait
+    function checkpoint() : bool {
+        if (!enabled || !scene || journal.busy || _loadingCommand)
+            return false
+
+        return journal.writeCheckpoint(scene.sceneActiveRepo.dumpRepo())
+    }
+
+    //! Checkpoint on the next event loop iteration, retried when the journal is idle
+    function requestCheckpoint() {
+        _checkpointRequested = true
+        Qt.callLater(_checkpointIfRequested)
+    }
+
+    //! Append the record of a macro to the journal
+    function record(macro) {
+        if (!enabled || !scene || !macro)
+            return
+
+        var members = {}    // uuid -> {collection, object}
+        var targets = {}    // uuid -> object
+        var needsCheckpoint = false
+
+        var commands = Array.isArray(macro.subCommands) ? macro.subCommands : [macro]
+        commands.forEach(cmd => {
+            if (!cmd)
+                return
+
+            var isKnown = false
+            function addMember(collection, obj) {
+                if (!obj?._qsUuid)
+                    return
+
+                members[obj._qsUuid] = { collection: collection, object: obj }
+                isKnown = true
+            }
+            function addTarget(obj) {
+                if (!obj?._qsUuid)
+                    return
+
+                targets[obj._qsUuid] = obj
+                isKnown = true
+            }
+
+            addMember("nodes", cmd.node);
+            (cmd.nodes ?? []).forEach(node => addMember("nodes", node));
+            (cmd.links ?? []).forEach(link => addMember("links", link));
+            addMember("links", cmd.createdLink)
+            addMember("links", cmd.removedLink)
+            addMember("containers", cmd.container)
+            addTarget(cmd.target);
+            (cmd.targets ?? []).forEach(target => addTarget(target));
+
+            if (isKnown)
+                return
+
+            needsCheckpoint = true
+            // A progressive load adds its objects after the push
+            if (cmd.isLoading && cmd.loadFinished) {
+                _loadingCommand = cmd
+                cmd.loadFinished.connect(_onLoadFinished)
+            }
+        })
+
+        // Links change the children/parents of the linked nodes
+        Object.values(members).forEach(member => {
+            if (member.collection !== "links")
+                return
+
+            [member.object.inputPort, member.object.outputPort].forEach(port => {
+                var node = port ? scene.findNode(port._qsUuid) : null
+                if (node)
+                    targets[node._qsUuid] = node
+            })
+        })
+
+        var ops = []
+        var written = {}
+        Object.values(members).forEach(member => {
+            var uuid = member.object._qsUuid
+            var isInScene = scene[member.collection][uuid] !== undefined
+            ops.push({ op: isInScene ? "insert" : "erase", collection: member.collection, uuid: uuid })
+
+            _ownedObjects(member.object).forEach(obj => {
+                written[obj._qsUuid] = true
+                ops.push(isInScene ? _putOp(obj) : { op: "drop", uuid: obj._qsUuid })
+            })
+        })
+
+        Object.values(targets).forEach(obj => {
+            if (written[obj._qsUuid])
+                return
+
+            written[obj._qsUuid] = true
+            ops.push(_putOp(obj))
+        })
+
+        if (ops.length > 0)
+            journal.append({ ops: ops })
+
+        if (needsCheckpoint || journal.journalBytes > maxJournalBytes)
+            requestCheckpoint()
+    }
+
+    //! The object with the QSObjects it owns
+    function _ownedObjects(obj) {
+        return [obj, obj.guiConfig, obj.nodeData, obj.imagesModel,
+                ...Object.values(obj.ports ?? {})].filter(owned => owned?._qsUuid)
+    }
+
+    function _putOp(obj) {
+        return {
+            op:     "put",
+            uuid:   obj._qsUuid,
+            props:  QSSerializer.getQSProps(obj, QSSerializer.SerialType.STORAGE)
+        }
+    }
+
+    function _checkpointIfRequested() {
+        if (_checkpointRequested && checkpoint())
+            _checkpointRequested = false
+    }
+
+    function _onLoadFinished(success) {
+        _loadingCommand.loadFinished.disconnect(_onLoadFinished)
+        _loadingCommand = null
+        requestCheckpoint()
+    }
+
+    //! Load the recovered objects like UndoStack.setSceneObject()
+    function _loadRecovered(objects, replayedRecords) {
+        var repo = scene?.sceneActiveRepo ?? NLCore.defaultRepo
+
+        var nodeLinkImport = "NodeLink"
+        if (!repo._allImports.includes(nodeLinkImport)) {
+            repo._localImports.push(nodeLinkImport)
+            repo._localImportsChanged()
+        }
+
+        NLSpec.undo.blockObservers = true
+        repo.loadRepo(objects)
+        NLSpec.undo.blockObservers = false
+
+        recovered(replayedRecords)
+        start()
+    }
+}
@@ -3,6 +3,8 @@ import NodeLink
 
 /*! ***********************************************************************************************
  * AddContainerCommand
+ * \deprecated The scene pushes add container records (CommandStack.pushAddContainer()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -20,15 +22,7 @@ I_Command {
     }
 
     function undo() {
-        if (isValidScene() && isValidContainer(container)) {
-            // Simply remove the container from scene (don't delete from memory)
-            // This allows redo to restore it
-            if (scene.containers[container._qsUuid]) {
-                scene.selectionModel.remove(container._qsUuid)
-                scene.containerRemoved(container)
-                delete scene.containers[container._qsUuid]
-                scene.containersChanged()
-            }
-        }
+        if (isValidScene() && isValidContainer(container))
+            scene._detachContainer(container)
     }
 }
@@ -3,6 +3,8 @@ import NodeLink
 
 /*! ***********************************************************************************************
  * AddNodeCommand
+ * \deprecated The scene pushes add node records (CommandStack.pushAddNode()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -20,15 +22,7 @@ I_Command {
     }
 
     function undo() {
-        if (isValidScene() && isValidNode(node)) {
-            // Simply remove the node from scene (don't delete from memory)
-            // Links will be handled by their own CreateLinkCommand
-            if (scene.nodes[node._qsUuid]) {
-                scene.selectionModel.remove(node._qsUuid)
-                scene.nodeRemoved(node)
-                delete scene.nodes[node._qsUuid]
-                scene.nodesChanged()
-            }
-        }
+        if (isValidScene() && isValidNode(node))
+            scene._detachNodes([node])
     }
 }
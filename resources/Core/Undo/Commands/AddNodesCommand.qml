@@ -2,7 +2,9 @@ import QtQuick
 import NodeLink
 
 /*! ***********************************************************************************************
- * AddNodesCommand - Handles undo/redo for batch node additions
+ * AddNodesCommand
+ * \deprecated The scene pushes add nodes records (CommandStack.pushAddNodes()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -15,30 +17,14 @@ I_Command {
     /* Functions
      * ****************************************************************************************/
     function redo() {
-        if (isValidScene() && nodes && nodes.length > 0) {
-            scene.addNodes(nodes, false)
-        }
+        var validNodes = (nodes ?? []).filter(node => isValidNode(node))
+        if (isValidScene() && validNodes.length > 0)
+            scene.addNodes(validNodes, false)
     }
 
     function undo() {
-        if (isValidScene() && nodes && nodes.length > 0) {
-            // Simply remove nodes from scene (don't delete from memory)
-            // This allows redo to restore them
-            // Links will be handled by their own CreateLinkCommand
-            for (var i = 0; i < nodes.length; i++) {
-                var node = nodes[i]
-                // Skip null or invalid nodes
-                if (!isValidNode(node)) {
-                    continue;
-                }
-                if (scene.nodes[node._qsUuid]) {
-                    scene.selectionModel.remove(node._qsUuid)
-                    scene.nodeRemoved(node)
-                    delete scene.nodes[node._qsUuid]
-                }
-            }
-            scene.nodesChanged()
-        }
+        var validNodes = (nodes ?? []).filter(node => isValidNode(node))
+        if (isValidScene() && validNodes.length > 0)
+            scene._detachNodes(validNodes)
     }
 }
-
@@ -6,6 +6,12 @@ import QtQuickStream
  * LoadFileCommand
  * Handles file loading with undo/redo support
  * Loads only nodes, links, and containers without changing the scene
+ *
+ * In progressive mode the file is read and parsed on a worker thread, then the objects are
+ * loaded in bounded chunks (containers first, then nodes nearest to the viewport with the links
+ * between loaded nodes), so the GUI stays responsive and shows progress. Each chunk is loaded by
+ * QtQuickStream into a staging repository and its objects are moved into the scene repository.
+ * The current objects are only removed once the file is parsed and has a scene.
  * ************************************************************************************************/
 
 I_Command {
@@ -32,6 +38,76 @@ I_Command {
     // FileIO instance for reading files (avoids QSFileIO singleton crash in Qt 6.5.3)
     property FileIO fileIO: FileIO { }
 
+    //! Progressive (non-blocking) loading
+    property bool progressive: false
+
+    //! Time budget of one progressive chunk (ms) and maximum nodes per chunk. A chunk is loaded
+    //! at once, the number of nodes per chunk follows the time the previous chunks took.
+    property int chunkBudgetMs: 8
+    property int chunkSize: 200
+
+    //! Progressive loading state, progress is 0..1
+    property bool isLoading: false
+    property real progress: 0.0
+
+    //! Reads and parses the file on a worker thread. The objects get new UUIDs, like cloned
+    //! objects, so a file can be loaded again while its objects are kept by the undo stack.
+    property SceneFileReader fileReader: SceneFileReader {
+        renewUuids: true
+
+        onFinished: (objects) => root._startProgressiveLoad(objects)
+        onFailed: (error) => root.cancel()
+    }
+
+    //! Runs one chunk per event loop iteration
+    property Timer _chunkTimer: Timer {
+        interval: 0
+        repeat: true
+        running: false
+
+        onTriggered: root._processChunk()
+    }
+
+    //! The previous objects were removed from the scene by this command
+    property bool _sceneCleared: false
+
+    //! Progressive loading state: the parsed file objects (map <UUID, properties>) and the
+    //! queues of UUIDs
+    property var _fileObjects: ({})
+    property var _nodeQueue: []
+    property int _nodeIndex: 0
+    property var _containerQueue: []
+    property int _containerIndex: 0
+
+    //! map <UUID, true> of the nodes, links and containers of the file scene. They are loaded
+    //! by their own chunk, references to them are restored by this command.
+    property var _sceneObjectUuids: ({})
+
+    //! map <UUID, object> of the objects moved into the scene repository
+    property var _loadedObjects: ({})
+
+    //! map <port UUID, node UUID> of the file, map <port UUID, loaded node>
+    property var _portNodeUuids: ({})
+    property var _portNodes: ({})
+
+    //! map <node UUID, [link UUID]>, map <link UUID, true>
+    property var _linksByNode: ({})
+    property var _addedLinks: ({})
+
+    //! map <node UUID, container>
+    property var _containerOfNode: ({})
+
+    property int _totalWork: 0
+    property int _doneWork: 0
+
+    //! Nodes or containers of the next chunk, 1..chunkSize
+    property int _batchSize: 1
+
+    /* Signals
+     * ****************************************************************************************/
+    //! Progressive loading finished, cancelled or failed
+    signal loadFinished(bool success)
+
     /* Functions
      * ****************************************************************************************/
 
@@ -48,6 +124,8 @@ I_Command {
     function clearAllSceneObjects() {
         if (!isValidScene()) return
 
+        _sceneCleared = true
+
         // Get all current objects
         var currentNodes = Object.values(scene.nodes)
         var currentLinks = Object.values(scene.links)
@@ -73,14 +151,8 @@ I_Command {
         }
     }
 
-    // Load objects from file into scene
-    function loadObjectsFromFile() {
-        if (!isValidScene() || !repo || !filePath) return false
-
-        // First, clear all current objects from scene
-        clearAllSceneObjects()
-
-        // Convert filePath to string for FileIO
+    // Convert filePath to a local path string
+    function localFilePath() : string {
         var filePathString = filePath
         if (filePath && typeof filePath === "object") {
             if (typeof filePath.toLocalFile === "function") {
@@ -94,22 +166,11 @@ I_Command {
             filePathString = String(filePath)
         }
 
-        // Read file using FileIO instance (avoids QSFileIO singleton crash in Qt 6.5.3)
-        var jsonString = fileIO.read(filePathString)
-        if (!jsonString || jsonString.length === 0) {
-            console.error("Failed to read file:", filePathString)
-            return false
-        }
-
-        // Parse JSON
-        var fileObjects
-        try {
-            fileObjects = JSON.parse(jsonString)
-        } catch (e) {
-            console.error("Failed to parse file JSON:", e)
-            return false
-        }
+        return filePathString
+    }
 
+    // Load file objects (map <UUID, properties>) into a temporary repo and return its scene
+    function loadTempScene(fileObjects) {
         // Create temporary repo to load the file
         tempRepo = QSSerializer.createQSObject("QSRepository", ["QtQuickStream"], repo)
         tempRepo.imports = repo.imports
@@ -118,22 +179,87 @@ I_Command {
         // Load into temp repo
         if (!tempRepo.loadRepo(fileObjects)) {
             console.error("Failed to load file into temp repo")
-            return false
+            return null
         }
 
         // Wait for loading to complete
         if (tempRepo._isLoading) {
             console.warn("Temp repo is still loading, this should not happen")
-            return false
+            return null
         }
 
         // Extract scene from temp repo
         var tempScene = tempRepo.qsRootObject
         if (!tempScene) {
             console.error("Failed to get scene from temp repo")
+            return null
+        }
+
+        return tempScene
+    }
+
+    // Clone a node of the temp scene and map its ports, the node is not added to the scene
+    function cloneNode(tempNode, portMap) {
+        var newNode = QSSerializer.createQSObject(
+            scene.nodeRegistry.nodeTypes[tempNode.type],
+            scene.nodeRegistry.imports,
+            scene.sceneActiveRepo
+        )
+        newNode._qsRepo = scene.sceneActiveRepo
+        newNode.cloneFrom(tempNode)
+
+        // Map ports
+        var oldPortKeys = Object.keys(tempNode.ports)
+        var newPortKeys = Object.keys(newNode.ports)
+        for (var j = 0; j < oldPortKeys.length && j < newPortKeys.length; j++) {
+            portMap[tempNode.ports[oldPortKeys[j]]._qsUuid] = newNode.ports[newPortKeys[j]]
+        }
+
+        return newNode
+    }
+
+    // Clone a container of the temp scene, the container is not added to the scene
+    function cloneContainer(tempContainer) {
+        var newContainer = QSSerializer.createQSObject(
+            "Container",
+            scene.nodeRegistry.imports,
+            scene.sceneActiveRepo
+        )
+        newContainer._qsRepo = scene.sceneActiveRepo
+        newContainer.cloneFrom(tempContainer)
+
+        return newContainer
+    }
+
+    // Load objects from file into scene
+    function loadObjectsFromFile() {
+        if (!isValidScene() || !repo || !filePath) return false
+
+        var filePathString = localFilePath()
+
+        // Read file using FileIO instance (avoids QSFileIO singleton crash in Qt 6.5.3)
+        var jsonString = fileIO.read(filePathString)
+        if (!jsonString || jsonString.length === 0) {
+            console.error("Failed to read file:", filePathString)
+            return false
+        }
+
+        // Parse JSON
+        var fileObjects
+        try {
+            fileObjects = JSON.parse(jsonString)
+        } catch (e) {
+            console.error("Failed to parse file JSON:", e)
             return false
         }
 
+        var tempScene = loadTempScene(fileObjects)
+        if (!tempScene)
+            return false
+
+        // The file is valid, clear all current objects from scene
+        clearAllSceneObjects()
+
         // Extract nodes, links, and containers
         var tempNodes = tempScene.nodes ? Object.values(tempScene.nodes) : []
         var tempLinks = tempScene.links ? Object.values(tempScene.links) : []
@@ -142,21 +268,7 @@ I_Command {
         // Clone and add nodes to current scene
         var portMap = {} // Map old ports to new ports for link creation
         for (var i = 0; i < tempNodes.length; i++) {
-            var tempNode = tempNodes[i]
-            var newNode = QSSerializer.createQSObject(
-                scene.nodeRegistry.nodeTypes[tempNode.type],
-                scene.nodeRegistry.imports,
-                scene.sceneActiveRepo
-            )
-            newNode._qsRepo = scene.sceneActiveRepo
-            newNode.cloneFrom(tempNode)
-
-            // Map ports
-            var oldPortKeys = Object.keys(tempNode.ports)
-            var newPortKeys = Object.keys(newNode.ports)
-            for (var j = 0; j < oldPortKeys.length && j < newPortKeys.length; j++) {
-                portMap[tempNode.ports[oldPortKeys[j]]._qsUuid] = newNode.ports[newPortKeys[j]]
-            }
+            var newNode = cloneNode(tempNodes[i], portMap)
 
             loadedNodes.push(newNode)
             scene.addNode(newNode, false)
@@ -164,14 +276,7 @@ I_Command {
 
         // Clone and add containers
         for (var k = 0; k < tempContainers.length; k++) {
-            var tempContainer = tempContainers[k]
-            var newContainer = QSSerializer.createQSObject(
-                "Container",
-                scene.nodeRegistry.imports,
-                scene.sceneActiveRepo
-            )
-            newContainer._qsRepo = scene.sceneActiveRepo
-            newContainer.cloneFrom(tempContainer)
+            var newContainer = cloneContainer(tempContainers[k])
 
             loadedContainers.push(newContainer)
             scene.addContainer(newContainer)
@@ -198,6 +303,419 @@ I_Command {
         return true
     }
 
+    // Start a progressive load: the file is read on a worker thread, see _startProgressiveLoad().
+    // The current objects stay in the scene until the file is parsed.
+    function loadObjectsFromFileProgressive() {
+        if (!isValidScene() || !repo || !filePath) return false
+
+        isLoading = true
+        progress = 0.0
+
+        if (!fileReader.read(localFilePath())) {
+            _finishProgressiveLoad(false)
+            return false
+        }
+
+        return true
+    }
+
+    // Abort a progressive load and return to the previous scene objects
+    function cancel() {
+        if (!isLoading)
+            return
+
+        fileReader.cancel()
+        _chunkTimer.stop()
+
+        // Not an undoable change, the command already restores the previous objects on undo
+        var undoStack = scene?._undoCore?.undoStack
+        var wasReplaying = undoStack?.isReplaying ?? false
+        if (undoStack)
+            undoStack.isReplaying = true
+        NLSpec.undo.blockObservers = true
+        try {
+            removeObjects(loadedNodes, loadedLinks, loadedContainers)
+            loadedNodes = []
+            loadedLinks = []
+            loadedContainers = []
+            if (_sceneCleared)
+                restoreObjects(previousNodes, previousLinks, previousContainers)
+            _sceneCleared = false
+        } finally {
+            NLSpec.undo.blockObservers = false
+            if (undoStack)
+                undoStack.isReplaying = wasReplaying
+        }
+
+        _finishProgressiveLoad(false)
+    }
+
+    // File parsed: check it, clear the scene and queue the UUIDs, nodes nearest to the
+    // viewport first. The objects are loaded in _processChunk().
+    function _startProgressiveLoad(fileObjects) {
+        if (!isLoading)
+            return
+
+        var rootUuid = _refUuid(fileObjects?.root)
+        var sceneEntry = rootUuid ? fileObjects[rootUuid] : undefined
+        if (!_isPlainObject(sceneEntry)) {
+            console.error("Failed to find the scene in file:", localFilePath())
+            _finishProgressiveLoad(false)
+            return
+        }
+
+        // Scene objects of the file: map of references -> UUIDs with an entry
+        function entryUuids(references) {
+            return Object.values(references ?? {}).map(reference => _refUuid(reference))
+                         .filter(uuid => uuid && _isPlainObject(fileObjects[uuid]))
+        }
+
+        var nodeUuids      = entryUuids(sceneEntry.nodes)
+        var linkUuids      = entryUuids(sceneEntry.links)
+        var containerUuids = entryUuids(sceneEntry.containers)
+
+        var sceneObjectUuids = {}
+        sceneObjectUuids[rootUuid] = true
+        nodeUuids.forEach(uuid => sceneObjectUuids[uuid] = true)
+        linkUuids.forEach(uuid => sceneObjectUuids[uuid] = true)
+        containerUuids.forEach(uuid => sceneObjectUuids[uuid] = true)
+
+        var portNodeUuids = {}
+        nodeUuids.forEach(nodeUuid => {
+            Object.values(fileObjects[nodeUuid].ports ?? {}).forEach(reference => {
+                var portUuid = _refUuid(reference)
+                if (portUuid)
+                    portNodeUuids[portUuid] = nodeUuid
+            })
+        })
+
+        // Links are added as soon as both of their nodes are loaded
+        var linksByNode = {}
+        linkUuids.forEach(linkUuid => {
+            var linkEntry = fileObjects[linkUuid]
+            for (var reference of [linkEntry.inputPort, linkEntry.outputPort]) {
+                var nodeUuid = portNodeUuids[_refUuid(reference) ?? ""]
+                if (!nodeUuid)
+                    continue
+
+                if (!linksByNode[nodeUuid])
+                    linksByNode[nodeUuid] = []
+                linksByNode[nodeUuid].push(linkUuid)
+            }
+        })
+
+        // Viewport center in scene coordinates
+        var cfg = scene.sceneGuiConfig
+        var zoom = cfg.zoomFactor > 0 ? cfg.zoomFactor : 1.0
+        var centerX = (cfg.contentX + cfg.sceneViewWidth / 2) / zoom
+        var centerY = (cfg.contentY + cfg.sceneViewHeight / 2) / zoom
+        function distance(nodeUuid) {
+            var guiConfig = fileObjects[_refUuid(fileObjects[nodeUuid].guiConfig) ?? ""] ?? {}
+            var position  = guiConfig.position ?? { x: 0, y: 0 }
+            var dx = position.x + (guiConfig.width  ?? 0) / 2 - centerX
+            var dy = position.y + (guiConfig.height ?? 0) / 2 - centerY
+            return dx * dx + dy * dy
+        }
+
+        // Chunks are loaded by QtQuickStream into a staging repository
+        tempRepo = QSSerializer.createQSObject("QSRepository", ["QtQuickStream"], repo)
+        tempRepo.imports = repo.imports
+        tempRepo._localImports = repo._localImports
+
+        // The file is valid, replace the current objects
+        clearAllSceneObjects()
+
+        _fileObjects = fileObjects
+        _sceneObjectUuids = sceneObjectUuids
+        _nodeQueue = nodeUuids.map(uuid => ({ uuid: uuid, distance: distance(uuid) }))
+                              .sort((a, b) => a.distance - b.distance)
+                              .map(entry => entry.uuid)
+        _nodeIndex = 0
+        _containerQueue = containerUuids
+        _containerIndex = 0
+
+        _loadedObjects = {}
+        _portNodeUuids = portNodeUuids
+        _portNodes = {}
+        _linksByNode = linksByNode
+        _addedLinks = {}
+        _containerOfNode = {}
+        _totalWork = nodeUuids.length + linkUuids.length + containerUuids.length
+        _doneWork = 0
+        _batchSize = Math.min(chunkSize, 16)
+
+        _chunkTimer.start()
+    }
+
+    // Load and add one bounded chunk of objects with batched nodesAdded/linksAdded
+    function _processChunk() {
+        var undoStack = scene?._undoCore?.undoStack
+        if (!isValidScene() || !undoStack) {
+            _finishProgressiveLoad(false)
+            return
+        }
+
+        var startTime = Date.now()
+        var built = 0
+        function hasBudget() {
+            return built < _batchSize
+        }
+
+        // Objects added by the load are recorded by this command only
+        var wasReplaying = undoStack.isReplaying
+        undoStack.isReplaying = true
+        NLSpec.undo.blockObservers = true
+        try {
+            // Containers first, they are few and outline the scene
+            var containerBatch = []
+            while (_containerIndex < _containerQueue.length && hasBudget()) {
+                containerBatch.push(_containerQueue[_containerIndex++])
+                built++
+            }
+            _loadChunk(containerBatch).forEach(container => {
+                loadedContainers.push(container)
+                scene.addContainer(container)
+            })
+            if (_containerIndex === _containerQueue.length && _containerQueue.length > 0) {
+                _nestContainers()
+                _containerQueue = []
+                _containerIndex = 0
+            }
+
+            var nodeUuids = []
+            var readyLinks = []
+            var readyNodes = {}
+            while (_containerQueue.length === 0 && _nodeIndex < _nodeQueue.length && hasBudget()) {
+                var nodeUuid = _nodeQueue[_nodeIndex++]
+                nodeUuids.push(nodeUuid)
+                readyNodes[nodeUuid] = true
+                built++
+
+                // Links whose both nodes are loaded with this chunk or before
+                var nodeLinks = _linksByNode[nodeUuid] ?? []
+                nodeLinks.forEach(linkUuid => {
+                    if (_addedLinks[linkUuid])
+                        return
+
+                    var linkEntry = _fileObjects[linkUuid]
+                    var isReady = [linkEntry.inputPort, linkEntry.outputPort].every(reference => {
+                        var nodeUuid = _portNodeUuids[_refUuid(reference) ?? ""]
+                        return nodeUuid && (_loadedObjects[nodeUuid] || readyNodes[nodeUuid])
+                    })
+                    if (isReady) {
+                        _addedLinks[linkUuid] = true
+                        readyLinks.push(linkUuid)
+                    }
+                })
+            }
+
+            var nodeBatch = _loadChunk(nodeUuids)
+            nodeBatch.forEach(node => _addPorts(node))
+            if (nodeBatch.length > 0) {
+                loadedNodes.push(...nodeBatch)
+                scene.addNodes(nodeBatch, false)
+            }
+
+            var linkBatch = _loadChunk(readyLinks).filter(link => _connectLink(link))
+            if (linkBatch.length > 0) {
+                loadedLinks.push(...linkBatch)
+                scene.addLinks(linkBatch)
+            }
+
+            _doneWork += built + readyLinks.length
+        } finally {
+            NLSpec.undo.blockObservers = false
+            undoStack.isReplaying = wasReplaying
+        }
+
+        // Keep the next chunk within the time budget
+        var elapsed = Date.now() - startTime
+        if (elapsed > chunkBudgetMs)
+            _batchSize = Math.max(1, Math.floor(_batchSize / 2))
+        else if (elapsed < chunkBudgetMs / 2)
+            _batchSize = Math.min(chunkSize, _batchSize * 2)
+
+        var isDone = _containerQueue.length === 0 && _nodeIndex >= _nodeQueue.length
+        progress = isDone ? 1.0 : (_totalWork > 0 ? _doneWork / _totalWork : 1.0)
+
+        if (isDone)
+            _finishProgressiveLoad(true)
+    }
+
+    // Load the scene objects of uuids with their sub-objects (gui configs, node data, ports,
+    // ...) into the staging repository and move them into the scene repository. Returns the
+    // scene objects, they are not added to the scene.
+    function _loadChunk(uuids) {
+        if (uuids.length === 0)
+            return []
+
+        var chunkObjects = {}
+        var references = []
+        uuids.forEach(uuid => _collectEntries(uuid, chunkObjects, references))
+
+        tempRepo.loadQSObjects(chunkObjects)
+
+        // Setting _qsRepo moves an object into the scene repository, so the staging repository
+        // only holds the objects of one chunk
+        var stagedObjects = tempRepo._qsObjects
+        Object.keys(chunkObjects).forEach(uuid => {
+            var object = stagedObjects[uuid]
+            if (!object)
+                return
+
+            if (object._qsRepo !== scene.sceneActiveRepo)
+                object._qsRepo = scene.sceneActiveRepo
+            _loadedObjects[uuid] = object
+        })
+
+        // References to objects of earlier chunks
+        references.forEach(reference => {
+            var object = _loadedObjects[reference.uuid]
+            var target = _loadedObjects[reference.target]
+            if (object && target)
+                object[reference.key] = target
+        })
+
+        var objects = []
+        uuids.forEach(uuid => {
+            var object = _loadedObjects[uuid]
+            if (object)
+                objects.push(object)
+            else
+                console.warn("LoadFileCommand: Cannot load object", uuid)
+        })
+
+        return objects
+    }
+
+    // Add the entry of uuid and the entries it references to chunkObjects. References between
+    // scene objects (node children / parents, container members, link ports) are left out and
+    // restored by this command; other references to moved objects are added to references.
+    function _collectEntries(uuid, chunkObjects, references) {
+        if (chunkObjects[uuid] !== undefined || _loadedObjects[uuid])
+            return
+
+        var entry = _fileObjects[uuid]
+        if (!_isPlainObject(entry))
+            return
+
+        var chunkEntry = Object.assign({}, entry)
+        if (_sceneObjectUuids[uuid]) {
+            ["children", "parents", "nodes", "containersInside", "inputPort", "outputPort"]
+                .forEach(key => delete chunkEntry[key])
+        }
+        chunkObjects[uuid] = chunkEntry
+
+        Object.keys(chunkEntry).forEach(key => {
+            var referenceUuid = _refUuid(chunkEntry[key])
+            var subEntry = referenceUuid ? _fileObjects[referenceUuid] : undefined
+
+            // Shared default configs and models stay shared, the new object has its own default
+            if (subEntry?.isSharedDefault) {
+                delete chunkEntry[key]
+            } else if (referenceUuid && (_loadedObjects[referenceUuid] ||
+                                         _sceneObjectUuids[referenceUuid])) {
+                delete chunkEntry[key]
+                references.push({ uuid: uuid, key: key, target: referenceUuid })
+            }
+        })
+
+        _referencedUuids(chunkEntry).forEach(referenceUuid => {
+            if (!_sceneObjectUuids[referenceUuid])
+                _collectEntries(referenceUuid, chunkObjects, references)
+        })
+    }
+
+    // UUIDs of the references in a value of an entry (maps and lists included)
+    function _referencedUuids(value) {
+        var referenceUuid = _refUuid(value)
+        if (referenceUuid)
+            return [referenceUuid]
+
+        if (Array.isArray(value) || _isPlainObject(value))
+            return Object.values(value).flatMap(item => _referencedUuids(item))
+
+        return []
+    }
+
+    // Register the ports of a loaded node and add it to its container
+    function _addPorts(node) {
+        Object.values(node.ports).forEach(port => _portNodes[port._qsUuid] = node)
+        _containerOfNode[node._qsUuid]?.addNode(node)
+    }
+
+    // Set the ports of a loaded link and the children / parents of its nodes, false if one of
+    // its ports is missing
+    function _connectLink(link) {
+        var entry = _fileObjects[link._qsUuid]
+        var upstreamPort   = _loadedObjects[_refUuid(entry.inputPort) ?? ""]
+        var downstreamPort = _loadedObjects[_refUuid(entry.outputPort) ?? ""]
+        if (!upstreamPort || !downstreamPort)
+            return false
+
+        link.inputPort  = upstreamPort
+        link.outputPort = downstreamPort
+
+        var upstreamNode   = _portNodes[upstreamPort._qsUuid]
+        var downstreamNode = _portNodes[downstreamPort._qsUuid]
+        if (upstreamNode && downstreamNode) {
+            upstreamNode.children[downstreamNode._qsUuid] = downstreamNode
+            upstreamNode.childrenChanged()
+
+            downstreamNode.parents[upstreamNode._qsUuid] = upstreamNode
+            downstreamNode.parentsChanged()
+        }
+
+        return true
+    }
+
+    // Restore the members of the containers once all containers are loaded, the nodes join
+    // their container when they are loaded
+    function _nestContainers() {
+        loadedContainers.forEach(container => {
+            var entry = _fileObjects[container._qsUuid]
+            Object.values(entry.nodes ?? {}).forEach(reference => {
+                var nodeUuid = _refUuid(reference)
+                if (nodeUuid)
+                    _containerOfNode[nodeUuid] = container
+            })
+            Object.values(entry.containersInside ?? {}).forEach(reference => {
+                var inner = _loadedObjects[_refUuid(reference) ?? ""]
+                if (inner)
+                    container.addContainerInside(inner)
+            })
+        })
+    }
+
+    // UUID of a saved reference (qqs:/<UUID>), null for other values
+    function _refUuid(value) {
+        return typeof value === "string" && value.startsWith("qqs:/") ? value.substring(5) : null
+    }
+
+    function _isPlainObject(value) : bool {
+        return value !== null && typeof value === "object" && !Array.isArray(value)
+    }
+
+    function _finishProgressiveLoad(success : bool) {
+        _chunkTimer.stop()
+
+        _fileObjects = {}
+        _nodeQueue = []
+        _nodeIndex = 0
+        _containerQueue = []
+        _containerIndex = 0
+        _sceneObjectUuids = {}
+        _loadedObjects = {}
+        _portNodeUuids = {}
+        _portNodes = {}
+        _linksByNode = {}
+        _addedLinks = {}
+        _containerOfNode = {}
+
+        isLoading = false
+        loadFinished(success)
+    }
+
     // Remove objects from scene
     function removeObjects(nodesToRemove, linksToRemove, containersToRemove) {
         if (!isValidScene()) return
@@ -250,18 +768,29 @@ I_Command {
         } else {
             // First time: save current state and load from file
             saveCurrentState()
-            loadObjectsFromFile()
+            if (progressive)
+                loadObjectsFromFileProgressive()
+            else
+                loadObjectsFromFile()
         }
     }
 
     function undo() {
         if (!isValidScene()) return
 
+        // Undo while loading progressively aborts the load
+        if (isLoading) {
+            cancel()
+            return
+        }
+
         // Remove loaded objects
         removeObjects(loadedNodes, loadedLinks, loadedContainers)
 
-        // Restore previous objects
-        restoreObjects(previousNodes, previousLinks, previousContainers)
+        // Restore previous objects, a failed load did not remove them
+        if (_sceneCleared)
+            restoreObjects(previousNodes, previousLinks, previousContainers)
+        _sceneCleared = false
     }
 }
 
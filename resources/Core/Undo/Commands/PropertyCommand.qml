@@ -2,6 +2,8 @@ import QtQuick
 
 /*! ***********************************************************************************************
  * PropertyCommand
+ * \deprecated The observers push property records (CommandStack.pushProperty()) themselves. This
+ * wrapper sets the same values as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 QtObject {
@@ -24,16 +26,16 @@ QtObject {
         if (!target)
             return
 
-        if (apply) {
+        if (apply)
             apply(target, value)
-        } else {
+        else
             target[key] = value
-        }
     }
 
     function undo() {
         setProp(oldValue)
     }
+
     function redo() {
         setProp(newValue)
     }
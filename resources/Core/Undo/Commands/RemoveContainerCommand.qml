@@ -3,6 +3,9 @@ import NodeLink
 
 /*! ***********************************************************************************************
  * RemoveContainerCommand
+ * \deprecated The scene pushes remove container records (CommandStack.pushRemoveContainer())
+ * itself. This wrapper replays the same scene functions as that record, for code that still pushes
+ * the command.
  * ************************************************************************************************/
 
 I_Command {
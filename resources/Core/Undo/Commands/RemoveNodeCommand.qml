@@ -3,6 +3,8 @@ import NodeLink
 
 /*! ***********************************************************************************************
  * RemoveNodeCommand
+ * \deprecated The scene pushes remove node records (CommandStack.pushRemoveNode()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -22,12 +24,12 @@ I_Command {
     }
 
     function undo() {
-        if (isValidScene() && isValidNode(node)) {
-            scene.addNode(node)
-            // Restore link objects (preserves all properties like color, etc.)
-            if (links && links.length) {
-                scene.restoreLinks(links)
-            }
-        }
+        if (!isValidScene() || !isValidNode(node))
+            return
+
+        scene.addNode(node)
+        // Restore link objects (preserves all properties like color, etc.)
+        if (links && links.length > 0)
+            scene.restoreLinks(links)
     }
 }
@@ -2,7 +2,9 @@ import QtQuick
 import NodeLink
 
 /*! ***********************************************************************************************
- * RemoveNodesCommand - Handles undo/redo for batch node deletions
+ * RemoveNodesCommand
+ * \deprecated The scene pushes remove nodes records (CommandStack.pushRemoveNodes()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -11,49 +13,27 @@ I_Command {
     /* Property Declarations
      * ****************************************************************************************/
     property var nodes: [] // Array of Node objects
-    // List of link data: [{ inputPortUuid, outputPortUuid }, ...]
+    // List of Link objects (not just port UUIDs, to preserve all properties)
     property var links: []
 
     /* Functions
      * ****************************************************************************************/
     function redo() {
-        if (isValidScene() && nodes && nodes.length > 0) {
-            var nodeUUIDs = []
-            for (var i = 0; i < nodes.length; i++) {
-                var node = nodes[i]
-                // Skip null or invalid nodes
-                if (!isValidNode(node)) {
-                    continue;
-                }
-                nodeUUIDs.push(node._qsUuid)
-            }
-            if (nodeUUIDs.length > 0) {
-                scene.deleteNodes(nodeUUIDs)
-            }
-        }
+        var nodeUuids = (nodes ?? []).filter(node => isValidNode(node)).map(node => node._qsUuid)
+        if (isValidScene() && nodeUuids.length > 0)
+            scene.deleteNodes(nodeUuids)
     }
 
     function undo() {
-        if (isValidScene() && nodes && nodes.length > 0) {
-            // Filter out null or invalid nodes before restoring
-            var validNodes = []
-            for (var i = 0; i < nodes.length; i++) {
-                var node = nodes[i]
-                if (isValidNode(node)) {
-                    validNodes.push(node)
-                }
-            }
-            
-            // Restore all valid nodes
-            if (validNodes.length > 0) {
-                scene.addNodes(validNodes, false)
-            }
+        if (!isValidScene())
+            return
 
-            // Restore all link objects (preserves all properties like color, etc.)
-            if (links && links.length > 0) {
-                scene.restoreLinks(links)
-            }
-        }
+        var validNodes = (nodes ?? []).filter(node => isValidNode(node))
+        if (validNodes.length > 0)
+            scene.addNodes(validNodes, false)
+
+        // Restore link objects (preserves all properties like color, etc.)
+        if (links && links.length > 0)
+            scene.restoreLinks(links)
     }
 }
-
@@ -3,6 +3,8 @@ import NodeLink
 
 /*! ***********************************************************************************************
  * UnlinkCommand
+ * \deprecated The scene pushes unlink records (CommandStack.pushUnlink()) itself. This
+ * wrapper replays the same scene functions as that record, for code that still pushes the command.
  * ************************************************************************************************/
 
 I_Command {
@@ -17,18 +19,12 @@ I_Command {
     /* Functions
      * ****************************************************************************************/
     function redo() {
-        if (!isValidScene() || !isValidUuid(inputPortUuid) || !isValidUuid(outputPortUuid))
-            return
-
-        // Use unlinkNodes to properly handle parent/children relationships
-        // removedLink should already be set, but use the UUIDs from command
-        scene.unlinkNodes(inputPortUuid, outputPortUuid)
+        if (isValidScene() && isValidUuid(inputPortUuid) && isValidUuid(outputPortUuid))
+            scene.unlinkNodes(inputPortUuid, outputPortUuid)
     }
 
     function undo() {
-        if (!isValidScene() || !isValidLink(removedLink))
-            return
-
-        scene.restoreLinks([removedLink])
+        if (isValidScene() && isValidLink(removedLink))
+            scene.restoreLinks([removedLink])
     }
 }
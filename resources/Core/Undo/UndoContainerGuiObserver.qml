@@ -25,6 +25,7 @@ Item {
             _cache.width = guiConfig.width
             _cache.height = guiConfig.height
             _cache.color = guiConfig.color
+            _cache.collapsed = guiConfig.collapsed
             _cache._init = true
         }
     }
@@ -42,6 +43,7 @@ Item {
         _cache.width = guiConfig.width
         _cache.height = guiConfig.height
         _cache.color = guiConfig.color
+        _cache.collapsed = guiConfig.collapsed
         _cache._init = true
     }
 
@@ -78,6 +80,7 @@ Item {
                 targetObj.position = Qt.vector2d(val.x, val.y)
             }
             var cmdPos = {
+                target: targetObj,
                 undo: function() {
                     setPos(oldCopy)
                 },
@@ -104,6 +107,7 @@ Item {
         }
 
         var cmd = {
+            target: targetObj,
             undo: function() {
                 setProp(oldV)
             },
@@ -150,5 +154,13 @@ Item {
             pushProp("color", oldV, newV)
             _cache.color = newV
         }
+
+        function onCollapsedChanged() {
+            _ensureCache()
+            let oldV = _cache.collapsed
+            let newV = guiConfig.collapsed
+            pushProp("collapsed", oldV, newV)
+            _cache.collapsed = newV
+        }
     }
 }
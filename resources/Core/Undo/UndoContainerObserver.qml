@@ -49,12 +49,7 @@ Item {
         if (JSON.stringify(oldV) === JSON.stringify(newV))
             return
 
-        var cmd = Qt.createQmlObject('import QtQuick; import NodeLink; import "Commands"; PropertyCommand {}', undoStack)
-        cmd.target = targetObj
-        cmd.key = key
-        cmd.oldValue = oldV
-        cmd.newValue = newV
-        undoStack.push(cmd)
+        undoStack.pushProperty(targetObj, key, oldV, newV)
     }
 
     Connections {
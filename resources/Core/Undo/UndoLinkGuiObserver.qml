@@ -82,6 +82,7 @@ Item {
         }
 
         var cmd = {
+            target: targetObj,
             undo: function() {
                 setProp(oldV)
             },
@@ -83,6 +83,7 @@ Item {
                 targetObj.position = Qt.vector2d(val.x, val.y)
             }
             var cmdPos = {
+                target: targetObj,
                 undo: function() {
                     setPos(oldCopy)
                 },
@@ -110,6 +111,7 @@ Item {
         }
 
         var cmd = {
+            target: targetObj,
             undo: function() {
                 setProp(oldV)
             },
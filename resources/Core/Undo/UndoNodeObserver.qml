@@ -51,21 +51,7 @@ Item {
         if (JSON.stringify(oldV) === JSON.stringify(newV))
             return
 
-        function setProp(obj, value) {
-            if (obj)
-                obj[key] = value
-        }
-
-        var cmd = {
-            undo: function() {
-                setProp(targetObj, oldV)
-            },
-            redo: function() {
-                setProp(targetObj, newV)
-            }
-        }
-
-        undoStack.push(cmd)
+        undoStack.pushProperty(targetObj, key, oldV, newV)
     }
 
     Connections {
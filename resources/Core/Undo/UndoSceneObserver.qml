@@ -20,9 +20,12 @@ Item {
     // Scene-level updates are handled via specific commands in I_Scene and observers.
     // No snapshot updates here.
 
+    //! Objects inside collapsed containers can not be edited, their observers are created
+    //! when the container is expanded.
+
     //! Node Loggers
     Repeater {
-        model: Object.values(root.scene.nodes)
+        model: Object.values(root.scene.nodes).filter(node => !root.scene.isNodeHidden(node._qsUuid))
 
         delegate: UndoNodeObserver {
             node: modelData
@@ -33,7 +36,8 @@ Item {
 
     //! Link Loggers
     Repeater {
-        model: Object.values(root.scene.links).filter(link => link !== null && link !== undefined)
+        model: Object.values(root.scene.links).filter(link => link !== null && link !== undefined &&
+                                                              !root.scene.isLinkHidden(link))
 
         delegate: UndoLinkObserver {
             link: modelData
@@ -44,7 +48,7 @@ Item {
 
     //! Containers Loggers
     Repeater {
-        model: Object.values(root.scene.containers)
+        model: Object.values(root.scene.containers).filter(container => !root.scene.isContainerHidden(container._qsUuid))
 
         delegate: UndoContainerObserver {
             container: modelData
@@ -0,0 +1,40 @@
+import QtQuick
+
+import NodeLink
+
+/*! ***********************************************************************************************
+ * ContainerProxyPort stands in for a boundary port of a collapsed container. The links crossing
+ * the container are attached to it until the container is expanded and the PortView is created.
+ * ************************************************************************************************/
+Rectangle {
+    id: root
+
+    /* Property Declarations
+    * ****************************************************************************************/
+    //! Port Model
+    property Port       port
+
+    //! Position of the proxy center in scene coordinates
+    property vector2d   scenePos: Qt.vector2d(-1, -1)
+
+    /* Object Properties
+     * ****************************************************************************************/
+    width: NLStyle.portView.size
+    height: NLStyle.portView.size
+
+    radius: width / 2
+    color: "#8b6cef"
+
+    border.color: "#363636"
+    border.width: NLStyle.portView.borderSize
+
+    onScenePosChanged: {
+        if (port)
+            port._position = scenePos;
+    }
+
+    onPortChanged: {
+        if (port)
+            port._position = scenePos;
+    }
+}
@@ -17,6 +17,13 @@ InteractiveNodeView {
 
     property bool      isNodeMinimal:  sceneSession?.zoomManager?.zoomFactor < sceneSession?.zoomManager?.minimalZoomNode
 
+    //! Collapsed containers show their cached summary instead of the inner views
+    property bool      isCollapsed:    container?.guiConfig?.collapsed ?? false
+
+    //! The inner views are paged out (I_NodesRect.pageOffscreenContainers), links crossing
+    //! the container are attached to its boundary ports like for a collapsed container
+    property bool      isPagedOut:     false
+
     /* Object properties
     * ****************************************************************************************/
     width: container.guiConfig.width
@@ -60,6 +67,81 @@ InteractiveNodeView {
         sourceComponent: containerTitleComponent
     }
 
+    //! Collapse/expand button
+    Rectangle {
+        anchors.right: parent.right
+        anchors.bottom: parent.top
+        anchors.bottomMargin: 5
+
+        visible: !containerView.isNodeMinimal
+        width: 30
+        height: container.guiConfig.containerTextHeight
+        radius: 5
+        color: Qt.darker(container?.guiConfig?.color ?? "transparent", 10)
+        border.color: NLStyle.primaryBorderColor
+        border.width: 2
+
+        Text {
+            anchors.centerIn: parent
+            text: containerView.isCollapsed ? "\uf078" : "\uf077"
+            color: NLStyle.primaryTextColor
+            font.family: NLStyle.fontType.font6Pro
+            font.pixelSize: 13
+        }
+
+        MouseArea {
+            anchors.fill: parent
+            cursorShape: Qt.PointingHandCursor
+            enabled: !container.guiConfig.locked
+            onClicked: scene.setContainerCollapsed(container, !containerView.isCollapsed)
+        }
+    }
+
+    //! Summary of a collapsed container, boundary ports of a paged out container
+    Loader {
+        anchors.fill: parent
+        active: containerView.isCollapsed || containerView.isPagedOut
+
+        sourceComponent: Item {
+            Text {
+                anchors.centerIn: parent
+                visible: containerView.isCollapsed && !containerView.isNodeMinimal
+                horizontalAlignment: Text.AlignHCenter
+                text: container._summary.nodeCount + " nodes" +
+                      (container._summary.containerCount > 0
+                           ? "\n" + container._summary.containerCount + " containers" : "")
+                color: NLStyle.primaryTextColor
+                font.family: NLStyle.fontType.roboto
+                font.pixelSize: 15
+            }
+
+            //! Boundary ports: links crossing the container are attached to these proxies
+            Repeater {
+                model: container._summary.inputPorts
+
+                delegate: ContainerProxyPort {
+                    port: modelData
+                    x: -width / 2
+                    y: (index + 1) * containerView.height / (container._summary.inputPorts.length + 1) - height / 2
+                    scenePos: Qt.vector2d(container.guiConfig.position.x,
+                                          container.guiConfig.position.y + y + height / 2)
+                }
+            }
+
+            Repeater {
+                model: container._summary.outputPorts
+
+                delegate: ContainerProxyPort {
+                    port: modelData
+                    x: containerView.width - width / 2
+                    y: (index + 1) * containerView.height / (container._summary.outputPorts.length + 1) - height / 2
+                    scenePos: Qt.vector2d(container.guiConfig.position.x + containerView.width,
+                                          container.guiConfig.position.y + y + height / 2)
+                }
+            }
+        }
+    }
+
     Component {
         id: containerTitleComponent
 
@@ -103,6 +185,9 @@ InteractiveNodeView {
         property real    prevY:      container.guiConfig.position.y
         property bool    isDraging:  false
 
+        //! Container position when the drag started
+        property vector2d pressPosition: Qt.vector2d(0, 0)
+
         anchors.fill: parent
         anchors.margins: 10
         hoverEnabled: true
@@ -128,8 +213,11 @@ InteractiveNodeView {
                      : Qt.ArrowCursor
 
         onPressed: (mouse) => {
-            updateInnerItems()
+            // The content of a collapsed container is fixed until it is expanded
+            if (!containerView.isCollapsed)
+                updateInnerItems()
             if (!container.guiConfig.locked) {
+                pressPosition = Qt.vector2d(container.guiConfig.position.x, container.guiConfig.position.y);
                 isDraging = true;
                 prevX = mouse.x; // should be fixed during movement as this is relative to parent
                 prevY = mouse.y;
@@ -138,8 +226,11 @@ InteractiveNodeView {
         }
 
         onReleased: (mouse) => {
-            if (!container.guiConfig.locked)
+            if (!container.guiConfig.locked) {
                 isDraging = false;
+                if (containerView.isCollapsed)
+                    collapsedMoveFinished(pressPosition);
+            }
         }
 
         onPositionChanged: (mouse) => {
@@ -208,6 +299,40 @@ InteractiveNodeView {
 
     /* Functions
     * ****************************************************************************************/
+    //! Inner objects of a collapsed container have no undo observers, so their move is
+    //! pushed as a single command. The container move itself is recorded by its observer.
+    function collapsedMoveFinished(startPosition) {
+        var deltaX = container.guiConfig.position.x - startPosition.x;
+        var deltaY = container.guiConfig.position.y - startPosition.y;
+        container.updateSummary(scene.links);
+
+        var undoStack = scene?._undoCore?.undoStack;
+        if (!undoStack || undoStack.isReplaying || (deltaX === 0 && deltaY === 0))
+            return;
+
+        var innerObjects = [...Object.values(container.nodes), ...Object.values(container.containersInside)];
+        function shift(dx, dy) {
+            innerObjects.forEach(obj => {
+                if (!obj?.guiConfig)
+                    return;
+
+                obj.guiConfig.position = Qt.vector2d(obj.guiConfig.position.x + dx,
+                                                     obj.guiConfig.position.y + dy);
+            });
+            container.updateSummary(scene.links);
+        }
+
+        undoStack.push({
+            targets: innerObjects.map(obj => obj.guiConfig).filter(guiConfig => guiConfig),
+            undo: function() {
+                shift(-deltaX, -deltaY)
+            },
+            redo: function() {
+                shift(deltaX, deltaY)
+            }
+        });
+    }
+
     //! Updating inner added or removed items
     function updateInnerItems() {
         //! removing nodes that are no longer in bounds
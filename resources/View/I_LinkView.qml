@@ -289,6 +289,15 @@ Canvas {
                 preparePainter();
             }
         }
+
+        //! The router finished a route that was postponed to a later frame
+        function onRouteChanged() {
+            if (canvas && canvas.available && inputPos && outputPos &&
+                inputPos.x >= -1000 && inputPos.y >= -1000 &&
+                outputPos.x >= -1000 && outputPos.y >= -1000) {
+                preparePainter();
+            }
+        }
     }
     
     // Force update when port._position changes
@@ -376,11 +385,18 @@ Canvas {
         // Update controlPoints when inputPort is known (inputPort !== null).
         if(inputPort && inputPos && outputPos && inputPos.x >= 0 && outputPos.x >= 0) {
             try {
-                // Calculate the control points with BasicLinkCalculator
+                // Calculate the control points with the link router of the scene (cached, routed
+                // around the nodes) or with BasicLinkCalculator
                 if (link && link.guiConfig && link.inputPort) {
-                    link.controlPoints = BasicLinkCalculator.calculateControlPoints(inputPos, outputPos, link.direction,
-                                                                                    link.guiConfig.type, link.inputPort.portSide,
-                                                                                    outputPortSide);
+                    if (scene?._linkRouter?.enabled) {
+                        link.controlPoints = scene._linkRouter.route(link, inputPos, outputPos, link.guiConfig.type,
+                                                                     link.inputPort.portSide, outputPortSide,
+                                                                     link.direction);
+                    } else {
+                        link.controlPoints = BasicLinkCalculator.calculateControlPoints(inputPos, outputPos, link.direction,
+                                                                                        link.guiConfig.type, link.inputPort.portSide,
+                                                                                        outputPortSide);
+                    }
                 }
 
                 // The function controlPointsChanged is invoked once following current change.
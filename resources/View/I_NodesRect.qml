@@ -34,14 +34,43 @@ Item {
     property var _containerViewMap: ({})
 
     //! Node view component
-    property Component nodeViewComponent: Qt.createComponent(nodeViewUrl);
+    //! The views are created by url with ObjectCreator, so they compile in the background
+    property Component nodeViewComponent: Qt.createComponent(nodeViewUrl, Component.Asynchronous);
 
     //! Link view component
-    property Component linkViewComponent: Qt.createComponent(linkViewUrl);
+    property Component linkViewComponent: Qt.createComponent(linkViewUrl, Component.Asynchronous);
 
     //! Container view component
     property Component containerViewComponent: Qt.createComponent(containerViewUrl);
 
+    //! Also release the inner views of expanded containers that are outside the viewport.
+    //! Inner views of collapsed containers are never instantiated.
+    property bool pageOffscreenContainers: false
+
+    //! Margin around the viewport (scene coordinates) before a container is paged out
+    property real pageMargin: 400
+
+    //! Compile the views and the node types of the registry in the background when the scene
+    //! is set, so the first view or node of each type is not compiled on demand
+    property bool warmUpComponents: true
+
+    //! Objects without views in this view, collapsed or paged out
+    //! map <node UUID, container UUID>
+    property var _hiddenNodes: ({})
+
+    //! map <port UUID, container UUID>
+    property var _hiddenPorts: ({})
+
+    //! map <container UUID, container UUID>
+    property var _hiddenContainers: ({})
+
+    //! Expanded containers paged out of the viewport, map <container UUID, true>
+    property var _pagedContainers: ({})
+
+    //! Links were added or removed while containers are paged out, their boundary ports
+    //! (Container._summary) are updated on the next page update
+    property bool _pagedLinksDirty: false
+
     /*  Object Properties
     * ****************************************************************************************/
     anchors.fill: parent
@@ -59,21 +88,10 @@ Item {
 
         //! containerRepeater updated when a container added
         function onContainerAdded(containerObj: Container) {
-            // Check if view already exists and is valid
-            var existingView = _containerViewMap[containerObj._qsUuid];
-            if (existingView) {
+            if (_hiddenContainers[containerObj._qsUuid] !== undefined)
                 return;
-            }
 
-            //! NodeViews should be child of NodesRect so they also get the zoom factor through
-            //! scaling
-            const objView = containerViewComponent.createObject(root, {
-                                                           scene: root.scene,
-                                                           sceneSession: root.sceneSession,
-                                                           container: containerObj,
-                                                           viewProperties: root.viewProperties
-                                                       });
-            _containerViewMap[containerObj._qsUuid] = objView;
+            _createContainerView(containerObj);
         }
 
         //! nodeRepeater updated when containers Removed
@@ -105,8 +123,13 @@ Item {
         function onNodesAdded(nodeArray: list<Node>) {
             var jsArray = [];
             for (var i = 0; i < nodeArray.length; i++) {
-                jsArray.push(nodeArray[i]);
+                // Views of nodes inside collapsed/paged containers are created on expand
+                if (_hiddenNodes[nodeArray[i]._qsUuid] === undefined)
+                    jsArray.push(nodeArray[i]);
             }
+            if (jsArray.length === 0)
+                return;
+
             var result = ObjectCreator.createItems(
                         "node",
                         jsArray,
@@ -123,12 +146,12 @@ Item {
                 for (var i = 0; i < result.items.length; i++) {
                     result.items[i].scene = root.scene;
                     result.items[i].sceneSession = root.sceneSession;
-                    result.items[i].node = nodeArray[i];
+                    result.items[i].node = jsArray[i];
                     result.items[i].viewProperties = root.viewProperties;
                 }
             } else {
                 for (var i = 0; i < result.items.length; i++) {
-                    _nodeViewMap[nodeArray[i]._qsUuid] = result.items[i];
+                    _nodeViewMap[jsArray[i]._qsUuid] = result.items[i];
                 }
             }
         }
@@ -136,34 +159,10 @@ Item {
 
         //! nodeRepeater updated when a node added
         function onNodeAdded(nodeObj: Node) {
-            // Check if view already exists and is valid
-            var existingView = _nodeViewMap[nodeObj._qsUuid];
-            if (existingView) {
+            if (_hiddenNodes[nodeObj._qsUuid] !== undefined)
                 return;
-            }
 
-            //! NodeViews should be child of NodesRect so they also get the zoom factor through
-            //! scaling
-
-            var result = ObjectCreator.createItem(
-                    root,
-                    nodeViewComponent.url,
-                    {
-                        "scene": root.scene,
-                        "sceneSession": root.sceneSession,
-                        "node": nodeObj,
-                        "viewProperties": root.viewProperties
-                    }
-                    );
-
-            if (result.needsPropertySet) {
-                result.item.scene = root.scene;
-                result.item.sceneSession = root.sceneSession;
-                result.item.node = nodeObj;
-                result.item.viewProperties = root.viewProperties;
-            }
-
-            _nodeViewMap[nodeObj._qsUuid] = result.item;
+            _createNodeView(nodeObj);
         }
 
         // ! nodeRepeater updated when several nodes Removed
@@ -197,37 +196,24 @@ Item {
 
         //! linkRepeater updated when a link added
         function onLinkAdded(linkObj: Link) {
-            // Check if view already exists and is valid
-            var existingView = _linkViewMap[linkObj._qsUuid];
-            if (existingView) {
+            root._pagedLinksChanged();
+            if (_isLinkHidden(linkObj))
                 return;
-            }
-            var result = ObjectCreator.createItem(
-                              root,
-                              linkViewComponent.url,
-                              {
-                                  "link": linkObj,
-                                  "scene": root.scene,
-                                  "sceneSession": root.sceneSession,
-                                  "viewProperties": root.viewProperties
-                              }
-                              );
 
-            if (result.needsPropertySet) {
-                result.item.scene = root.scene;
-                result.item.sceneSession = root.sceneSession;
-                result.item.link = linkObj;
-                result.item.viewProperties = root.viewProperties;
-            }
-            _linkViewMap[linkObj._qsUuid] = result.item;
+            _createLinkView(linkObj);
         }
 
         //! linkRepeater updated when a link added
         function onLinksAdded(linkArray: list<Link>) {
+            root._pagedLinksChanged();
             var jsArray = [];
             for (var i = 0; i < linkArray.length; i++) {
-                jsArray.push(linkArray[i]);
+                if (!_isLinkHidden(linkArray[i]))
+                    jsArray.push(linkArray[i]);
             }
+            if (jsArray.length === 0)
+                return;
+
             var result = ObjectCreator.createItems(
                         "link",
                         jsArray,
@@ -243,19 +229,20 @@ Item {
                 for (var i = 0; i < result.items.length; i++) {
                     result.items[i].scene = root.scene;
                     result.items[i].sceneSession = root.sceneSession;
-                    result.items[i].link = linkArray[i];
+                    result.items[i].link = jsArray[i];
                     result.items[i].viewProperties = root.viewProperties;
-                    _linkViewMap[linkArray[i]._qsUuid] = result.items[i];
+                    _linkViewMap[jsArray[i]._qsUuid] = result.items[i];
                 }
             } else {
                 for (var i = 0; i < result.items.length; i++) {
-                    _linkViewMap[linkArray[i]._qsUuid] = result.items[i];
+                    _linkViewMap[jsArray[i]._qsUuid] = result.items[i];
                 }
             }
         }
 
         //! linkRepeater updated when a link Removed
         function onLinkRemoved(linkObj: Link) {
+            root._pagedLinksChanged();
             let linkObjId = linkObj._qsUuid;
             let linkViewObj = _linkViewMap[linkObjId];
             
@@ -265,5 +252,282 @@ Item {
                 delete _linkViewMap[linkObjId];
             }
         }
+
+        //! Containers collapsed or expanded, release or create inner views
+        function onCollapsedContainersUpdated() {
+            root._updateHiddenObjects();
+        }
+
+        function onContainersChanged() {
+            if (root.pageOffscreenContainers)
+                _pageTimer.restart();
+        }
+    }
+
+    //! Page containers in and out when the viewport moves
+    Connections {
+        target: root.pageOffscreenContainers ? (scene?.sceneGuiConfig ?? null) : null
+
+        function onContentXChanged() {
+            _pageTimer.restart();
+        }
+
+        function onContentYChanged() {
+            _pageTimer.restart();
+        }
+
+        function onSceneViewWidthChanged() {
+            _pageTimer.restart();
+        }
+
+        function onSceneViewHeightChanged() {
+            _pageTimer.restart();
+        }
+    }
+
+    Connections {
+        target: root.pageOffscreenContainers ? (sceneSession?.zoomManager ?? null) : null
+
+        function onZoomFactorChanged() {
+            _pageTimer.restart();
+        }
+    }
+
+    //! Links are not routed around nodes without views in this view
+    Binding {
+        target: root.scene?._linkRouter ?? null
+        property: "hiddenNodes"
+        value: root._hiddenNodes
+        when: root.pageOffscreenContainers
+    }
+
+    //! Coalesce viewport changes while panning and zooming
+    Timer {
+        id: _pageTimer
+
+        interval: 150
+        repeat: false
+        running: false
+
+        onTriggered: root._updateHiddenObjects();
+    }
+
+    onPageOffscreenContainersChanged: _updateHiddenObjects();
+
+    Component.onCompleted: _warmUp();
+
+    onSceneChanged: _warmUp();
+
+    /*  Functions
+    * ****************************************************************************************/
+
+    //! Preload the views (shared with the ObjectCreator component cache) and the node types,
+    //! components that are already cached are skipped
+    function _warmUp() {
+        if (!warmUpComponents || !scene?.nodeRegistry)
+            return;
+
+        ObjectCreator.preload(root,
+                              [String(nodeViewComponent?.url ?? ""), String(linkViewComponent?.url ?? "")],
+                              Object.values(scene.nodeRegistry.nodeTypes),
+                              scene.nodeRegistry.imports);
+    }
+
+    //! Create a node view
+    function _createNodeView(nodeObj: Node) {
+        // Check if view already exists and is valid
+        var existingView = _nodeViewMap[nodeObj._qsUuid];
+        if (existingView) {
+            return;
+        }
+
+        //! NodeViews should be child of NodesRect so they also get the zoom factor through
+        //! scaling
+
+        var result = ObjectCreator.createItem(
+                root,
+                nodeViewComponent.url,
+                {
+                    "scene": root.scene,
+                    "sceneSession": root.sceneSession,
+                    "node": nodeObj,
+                    "viewProperties": root.viewProperties
+                }
+                );
+
+        if (result.needsPropertySet) {
+            result.item.scene = root.scene;
+            result.item.sceneSession = root.sceneSession;
+            result.item.node = nodeObj;
+            result.item.viewProperties = root.viewProperties;
+        }
+
+        _nodeViewMap[nodeObj._qsUuid] = result.item;
+    }
+
+    //! Create a link view
+    function _createLinkView(linkObj: Link) {
+        // Check if view already exists and is valid
+        var existingView = _linkViewMap[linkObj._qsUuid];
+        if (existingView) {
+            return;
+        }
+        var result = ObjectCreator.createItem(
+                          root,
+                          linkViewComponent.url,
+                          {
+                              "link": linkObj,
+                              "scene": root.scene,
+                              "sceneSession": root.sceneSession,
+                              "viewProperties": root.viewProperties
+                          }
+                          );
+
+        if (result.needsPropertySet) {
+            result.item.scene = root.scene;
+            result.item.sceneSession = root.sceneSession;
+            result.item.link = linkObj;
+            result.item.viewProperties = root.viewProperties;
+        }
+        _linkViewMap[linkObj._qsUuid] = result.item;
+    }
+
+    //! Create a container view
+    function _createContainerView(containerObj: Container) {
+        // Check if view already exists and is valid
+        var existingView = _containerViewMap[containerObj._qsUuid];
+        if (existingView) {
+            return;
+        }
+
+        //! NodeViews should be child of NodesRect so they also get the zoom factor through
+        //! scaling
+        const objView = containerViewComponent.createObject(root, {
+                                                       scene: root.scene,
+                                                       sceneSession: root.sceneSession,
+                                                       container: containerObj,
+                                                       viewProperties: root.viewProperties
+                                                   });
+        _containerViewMap[containerObj._qsUuid] = objView;
+    }
+
+    //! A link is hidden when both ends are hidden inside the same collapsed or paged out
+    //! container. Links crossing the boundary of such a container are attached to its
+    //! boundary ports (ContainerProxyPort), their port views do not exist.
+    function _isLinkHidden(linkObj: Link) : bool {
+        var upstreamId = _hiddenPorts[linkObj?.inputPort?._qsUuid ?? ""];
+        return upstreamId !== undefined &&
+               upstreamId === _hiddenPorts[linkObj?.outputPort?._qsUuid ?? ""];
+    }
+
+    //! Boundary ports of paged out containers follow the links on the next page update
+    function _pagedLinksChanged() {
+        if (Object.keys(_pagedContainers).length === 0)
+            return;
+
+        _pagedLinksDirty = true;
+        _pageTimer.restart();
+    }
+
+    //! Visible scene rect (scene coordinates) extended by pageMargin
+    function _viewportRect() : rect {
+        var cfg  = scene.sceneGuiConfig;
+        var zoom = sceneSession?.zoomManager?.zoomFactor ?? 1.0;
+        return Qt.rect(cfg.contentX / zoom - pageMargin,
+                       cfg.contentY / zoom - pageMargin,
+                       cfg.sceneViewWidth / zoom + 2 * pageMargin,
+                       cfg.sceneViewHeight / zoom + 2 * pageMargin);
+    }
+
+    //! Update the hidden maps from the collapsed containers (and the viewport when
+    //! pageOffscreenContainers is set), then release views of hidden objects and create views
+    //! of objects that became visible.
+    function _updateHiddenObjects() {
+        if (!scene || (scene._sceneActiveRepoObject?._isLoading ?? false))
+            return;
+
+        var hiddenNodes      = Object.assign({}, scene._collapsedNodes);
+        var hiddenPorts      = Object.assign({}, scene._collapsedPorts);
+        var hiddenContainers = Object.assign({}, scene._collapsedContainers);
+        var pagedContainers  = {};
+
+        if (pageOffscreenContainers) {
+            var viewport = _viewportRect();
+            Object.values(scene.containers).forEach(container => {
+                var containerId = container._qsUuid;
+                var cfg = container.guiConfig;
+                if (cfg.collapsed || hiddenContainers[containerId] !== undefined)
+                    return;
+
+                if (cfg.position.x + cfg.width  >= viewport.x &&
+                    cfg.position.x <= viewport.x + viewport.width &&
+                    cfg.position.y + cfg.height >= viewport.y &&
+                    cfg.position.y <= viewport.y + viewport.height)
+                    return;
+
+                pagedContainers[containerId] = true;
+
+                // The boundary ports of the container replace the port views of its nodes
+                if (_pagedLinksDirty || !(_pagedContainers[containerId] ?? false))
+                    container.updateSummary(scene.links);
+
+                Object.values(container.nodes).forEach(node => {
+                    if (scene.nodes[node._qsUuid] !== node || hiddenNodes[node._qsUuid] !== undefined)
+                        return;
+
+                    hiddenNodes[node._qsUuid] = containerId;
+                    Object.keys(node.ports).forEach(portId => hiddenPorts[portId] = containerId);
+                });
+                Object.keys(container.containersInside).forEach(innerId => {
+                    if (hiddenContainers[innerId] === undefined)
+                        hiddenContainers[innerId] = containerId;
+                });
+            });
+        }
+
+        _hiddenNodes      = hiddenNodes;
+        _hiddenPorts      = hiddenPorts;
+        _hiddenContainers = hiddenContainers;
+        _pagedContainers  = pagedContainers;
+        _pagedLinksDirty  = false;
+
+        Object.values(scene.containers).forEach(containerObj => {
+            var containerId = containerObj._qsUuid;
+            var isHidden = hiddenContainers[containerId] !== undefined;
+            if (isHidden && _containerViewMap[containerId]) {
+                _containerViewMap[containerId].destroy();
+                delete _containerViewMap[containerId];
+            } else if (!isHidden && !_containerViewMap[containerId]) {
+                _createContainerView(containerObj);
+            }
+
+            if (_containerViewMap[containerId])
+                _containerViewMap[containerId].isPagedOut = pagedContainers[containerId] ?? false;
+        });
+
+        Object.values(scene.nodes).forEach(nodeObj => {
+            var nodeId = nodeObj._qsUuid;
+            var isHidden = hiddenNodes[nodeId] !== undefined;
+            if (isHidden && _nodeViewMap[nodeId]) {
+                _nodeViewMap[nodeId].destroy();
+                delete _nodeViewMap[nodeId];
+            } else if (!isHidden && !_nodeViewMap[nodeId]) {
+                _createNodeView(nodeObj);
+            }
+        });
+
+        Object.values(scene.links).forEach(linkObj => {
+            if (!linkObj)
+                return;
+
+            var linkId = linkObj._qsUuid;
+            var isHidden = _isLinkHidden(linkObj);
+            if (isHidden && _linkViewMap[linkId]) {
+                _linkViewMap[linkId].destroy();
+                delete _linkViewMap[linkId];
+            } else if (!isHidden && !_linkViewMap[linkId]) {
+                _createLinkView(linkObj);
+            }
+        });
     }
 }
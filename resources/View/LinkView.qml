@@ -112,7 +112,7 @@ I_LinkView {
                 MouseArea {
                     anchors.fill: parent
                     onClicked: {
-                        link.guiConfig._isEditableDescription = true
+                        link.mutableGuiConfig()._isEditableDescription = true
                     }
                 }
             }
@@ -132,8 +132,8 @@ I_LinkView {
                 focus: link.guiConfig._isEditableDescription
 
                 onTextChanged: {
-                    if (link && link.description !== text)
-                        link.guiConfig.description = text;
+                    if (link && link.guiConfig.description !== text)
+                        link.mutableGuiConfig().description = text;
                 }
 
                 leftPadding: 10
@@ -158,9 +158,9 @@ I_LinkView {
                         scene.selectionModel.clear(link?._qsUuid);
                         scene.selectionModel.selectLink(link);
                         if (!sceneSession.isShiftModifierPressed)
-                            link.guiConfig._isEditableDescription = true;
+                            link.mutableGuiConfig()._isEditableDescription = true;
                     } else if (focus) {
-                       link.guiConfig._isEditableDescription = true;
+                       link.mutableGuiConfig()._isEditableDescription = true;
                     }
                 }
             }
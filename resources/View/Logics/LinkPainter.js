@@ -230,9 +230,12 @@ function arrows(context, controlPoints, color, headLength, startPos, type) {
 
             margin = 100;
 
+            //! The middle segment of routed curves (3n + 1 points)
+            var first = 3 * Math.floor((controlPoints.length - 1) / 6);
+
             //! Calculating middle point and angle properties
-            var targetPoint = calculateMiddlePointForBrezier(controlPoints[0], controlPoints[3], controlPoints[1], controlPoints[2])
-            var angleProperties = calculateMiddleAngleForBrezier(controlPoints[0], controlPoints[3], controlPoints[1], controlPoints[2])
+            var targetPoint = calculateMiddlePointForBrezier(controlPoints[first], controlPoints[first + 3], controlPoints[first + 1], controlPoints[first + 2])
+            var angleProperties = calculateMiddleAngleForBrezier(controlPoints[first], controlPoints[first + 3], controlPoints[first + 1], controlPoints[first + 2])
 
             if (targetPoint && angleProperties && (Math.abs(angleProperties.dx) > margin || Math.abs(angleProperties.dy) > margin))
               drawArrow(context, targetPoint, angleProperties.angle, color, headLength);
@@ -404,14 +407,10 @@ function paintBezierCurve(context, controlPoints) {
             return;
         }
         
-        var startPos = controlPoints.shift();
-        var endPos   = controlPoints.pop()
-
-        var cp1 = controlPoints[0];
-        var cp2 = controlPoints[1];
+        var startPos = controlPoints[0];
 
         // Validate positions
-        if (!startPos || !endPos || !cp1 || !cp2) {
+        if (!startPos) {
             return;
         }
 
@@ -422,12 +421,20 @@ function paintBezierCurve(context, controlPoints) {
         
         //start position
         context.moveTo(startPos.x, startPos.y);
-        
-        if (!isContextActive(context)) {
-            return;
+
+        // Routed curves (LinkRouter) have several cubic segments: 3n + 1 points
+        for (var i = 1; i + 2 < controlPoints.length; i += 3) {
+            var cp1    = controlPoints[i];
+            var cp2    = controlPoints[i + 1];
+            var endPos = controlPoints[i + 2];
+
+            // Validate positions
+            if (!cp1 || !cp2 || !endPos || !isContextActive(context)) {
+                return;
+            }
+
+            context.bezierCurveTo(cp1.x, cp1.y, cp2.x , cp2.y, endPos.x, endPos.y);
         }
-        
-        context.bezierCurveTo(cp1.x, cp1.y, cp2.x , cp2.y, endPos.x, endPos.y);
     } catch (e) {
         // Error during bezier curve painting, skip
         return;
@@ -12,6 +12,9 @@ I_NodesRect {
     //! Z factor to manage node view (maximum in NodeView is 3) and another layers order, maximum is 4
     z: 4
 
+    //! Only instantiate the inner views of containers near the viewport
+    pageOffscreenContainers: true
+
     /*  Children
     * ****************************************************************************************/
 
@@ -23,7 +26,7 @@ I_NodesRect {
     }
 
     Repeater {
-        model: Object.values(root.scene.nodes)
+        model: Object.values(root.scene.nodes).filter(node => root._hiddenNodes[node._qsUuid] === undefined)
         delegate: ImagesFlickable {
             id: imageFlickable
             width: modelData.guiConfig.width - 6
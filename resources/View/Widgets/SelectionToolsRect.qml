@@ -129,8 +129,9 @@ Rectangle {
                 onColorChanged: (colorName, index) => {
                                     if (selectionModel && selectionModel.selectedModel) {
                                         Object.values(selectionModel.selectedModel).forEach(obj => {
-                                                                 obj.guiConfig.color = colorName;
-                                                                 obj.guiConfig.colorIndex = index;
+                                                                 const config = obj.mutableGuiConfig?.() ?? obj.guiConfig;
+                                                                 config.color = colorName;
+                                                                 config.colorIndex = index;
                                                              });
                                     }
                                 }
@@ -175,7 +176,7 @@ Rectangle {
                         var imageUrl = file.toString();
                         imageUrl = imageUrl.replace('file:///', '');
                         var base64Image = nlUtils.imageURLToImageString(imageUrl)
-                        layout.selectedObject.imagesModel.addImage("data:image/jpeg;base64," + base64Image)
+                        layout.selectedObject.mutableImagesModel().addImage("data:image/jpeg;base64," + base64Image)
                     })
                 }
 
@@ -232,7 +233,7 @@ Rectangle {
 
             //Enabling read only
             onClicked:{
-                layout.selectedObject.guiConfig._isEditableDescription = editLabelButton.checked
+                layout.selectedObject.mutableGuiConfig()._isEditableDescription = editLabelButton.checked
             }
 
         }
@@ -327,7 +328,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.style === NLSpec.LinkStyle.Solid
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.style = NLSpec.LinkStyle.Solid
+                                                 link.mutableGuiConfig().style = NLSpec.LinkStyle.Solid
                                              });
                     }
                 }
@@ -339,7 +340,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.style === NLSpec.LinkStyle.Dash
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.style = NLSpec.LinkStyle.Dash
+                                                 link.mutableGuiConfig().style = NLSpec.LinkStyle.Dash
                                              });
                     }
                 }
@@ -351,7 +352,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.style === NLSpec.LinkStyle.Dot
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.style = NLSpec.LinkStyle.Dot
+                                                 link.mutableGuiConfig().style = NLSpec.LinkStyle.Dot
                                              });
                     }
                 }
@@ -392,7 +393,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.type === NLSpec.LinkType.Bezier
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.type = NLSpec.LinkType.Bezier
+                                                 link.mutableGuiConfig().type = NLSpec.LinkType.Bezier
                                              });
                     }
                 }
@@ -404,7 +405,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.type === NLSpec.LinkType.LLine
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.type = NLSpec.LinkType.LLine
+                                                 link.mutableGuiConfig().type = NLSpec.LinkType.LLine
                                              });
                     }
                 }
@@ -416,7 +417,7 @@ Rectangle {
                     checked: layout.selectedObject?.guiConfig?.type === NLSpec.LinkType.Straight
                     onTriggered: {
                         selectedLink.forEach(link => {
-                                                 link.guiConfig.type = NLSpec.LinkType.Straight
+                                                 link.mutableGuiConfig().type = NLSpec.LinkType.Straight
                                              });
                     }
                 }
@@ -0,0 +1,64 @@
+#ifndef TEST_COMMAND_STACK_H
+#define TEST_COMMAND_STACK_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+/*! ***********************************************************************************************
+ * Stand-in for I_Scene with the functions the typed records call. Nodes, links and containers
+ * are QObjects with a _qsUuid, links also with the UUIDs of their ports.
+ * ************************************************************************************************/
+class CommandSceneStub : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariantMap nodes      MEMBER nodes)
+    Q_PROPERTY(QVariantMap links      MEMBER links)
+    Q_PROPERTY(QVariantMap containers MEMBER containers)
+
+public:
+    QVariantMap nodes;
+    QVariantMap links;
+    QVariantMap containers;
+
+    Q_INVOKABLE void     addNode(QObject *node);
+    Q_INVOKABLE void     addNodes(const QVariantList &nodeArray, bool autoSelect);
+    Q_INVOKABLE void     _detachNodes(const QVariantList &nodeArray);
+    Q_INVOKABLE void     deleteNode(const QString &nodeUuid);
+    Q_INVOKABLE void     deleteNodes(const QStringList &nodeUuids);
+
+    Q_INVOKABLE QObject *createLink(const QString &portA, const QString &portB);
+    Q_INVOKABLE void     restoreLinks(const QVariantList &linkArray);
+    Q_INVOKABLE void     _detachLink(QObject *link);
+    Q_INVOKABLE void     unlinkNodes(const QString &portA, const QString &portB);
+
+    Q_INVOKABLE void     addContainer(QObject *container);
+    Q_INVOKABLE void     _detachContainer(QObject *container);
+    Q_INVOKABLE void     deleteContainer(const QString &containerUuid);
+};
+
+/*! ***********************************************************************************************
+ * CommandStackCPP: batching, the undo / redo ring buffer, custom commands and the typed records
+ * of the scene edits. The macros are finalized at once instead of after the batch interval.
+ * ************************************************************************************************/
+class TestCommandStack : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void propertyUndoRedo();
+    void batchIsOneMacro();
+    void fullRingDropsOldest();
+    void pushClearsRedo();
+    void resizeKeepsNewest();
+    void customCommand();
+    void nodeRecords();
+    void removedNodesRestoreLinks();
+    void linkRecords();
+    void containerRecords();
+    void discardReleasesRemovedObjects();
+};
+
+#endif // TEST_COMMAND_STACK_H
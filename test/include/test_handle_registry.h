@@ -0,0 +1,56 @@
+#ifndef TEST_HANDLE_REGISTRY_H
+#define TEST_HANDLE_REGISTRY_H
+
+#include <QObject>
+#include <QVariantMap>
+
+/*! ***********************************************************************************************
+ * Stand-in for the objects of a scene: the scene (nodes, links), a node (ports) and a link
+ * (inputPort, outputPort). The properties emit their change signals like the QML properties.
+ * ************************************************************************************************/
+class SceneObjectStub : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariantMap nodes      MEMBER nodes      NOTIFY nodesChanged)
+    Q_PROPERTY(QVariantMap links      MEMBER links      NOTIFY linksChanged)
+    Q_PROPERTY(QVariantMap ports      MEMBER ports      NOTIFY portsChanged)
+    Q_PROPERTY(QObject    *inputPort  MEMBER inputPort  NOTIFY inputPortChanged)
+    Q_PROPERTY(QObject    *outputPort MEMBER outputPort NOTIFY outputPortChanged)
+
+public:
+    explicit SceneObjectStub(const QString &uuid, QObject *parent = nullptr);
+
+    QVariantMap nodes;
+    QVariantMap links;
+    QVariantMap ports;
+    QObject    *inputPort  = nullptr;
+    QObject    *outputPort = nullptr;
+
+signals:
+    void nodesChanged();
+    void linksChanged();
+    void portsChanged();
+    void inputPortChanged();
+    void outputPortChanged();
+
+    void linkRemoved(QObject *link);
+};
+
+/*! ***********************************************************************************************
+ * HandleRegistryCPP: interning of UUIDs and the indices of a scene. The scene is changed the
+ * way I_Scene does it: the map is updated, the registry told, then the signals are emitted.
+ * ************************************************************************************************/
+class TestHandleRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void internIsStable();
+    void lookupDoesNotIntern();
+    void indicesFollowScene();
+    void objectChangesAreTracked();
+    void removedNodesAreNotFound();
+};
+
+#endif // TEST_HANDLE_REGISTRY_H
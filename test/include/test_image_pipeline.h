@@ -0,0 +1,22 @@
+#ifndef TEST_IMAGE_PIPELINE_H
+#define TEST_IMAGE_PIPELINE_H
+
+#include <QObject>
+
+/*! ***********************************************************************************************
+ * ImagePipeline (examples/visionLink): planning of the stages, and the tiled, fused pass against
+ * the operations applied one after the other to the whole image.
+ * ************************************************************************************************/
+class TestImagePipeline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void noOpStagesAreDropped();
+    void pixelStagesAreFused();
+    void stagesFromVariant();
+    void tiledPassMatchesOperations();
+    void otherFormatsAreConverted();
+};
+
+#endif // TEST_IMAGE_PIPELINE_H
@@ -0,0 +1,24 @@
+#ifndef TEST_LINK_ROUTER_H
+#define TEST_LINK_ROUTER_H
+
+#include <QObject>
+
+/*! ***********************************************************************************************
+ * LinkRouterCPP: routes of an empty scene, obstacle avoidance, and the invalidation of cached
+ * routes when nodes move, are hidden or leave the scene. The nodes are NodeGuiConfigCPP rows of
+ * the detached geometry store (no repository), the links plain QObjects.
+ * ************************************************************************************************/
+class TestLinkRouter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptySceneRoutes();
+    void lLineAvoidsNode();
+    void bezierBendsAroundNode();
+    void movedNodeInvalidatesRoute();
+    void hiddenNodeIsNoObstacle();
+    void removedNodeIsNoObstacle();
+};
+
+#endif // TEST_LINK_ROUTER_H
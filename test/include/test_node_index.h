@@ -0,0 +1,44 @@
+#ifndef TEST_NODE_INDEX_H
+#define TEST_NODE_INDEX_H
+
+#include <QObject>
+
+/*! ***********************************************************************************************
+ * Stand-in for a Node: title and type with their change signals, _qsUuid as dynamic property.
+ * ************************************************************************************************/
+class IndexedNodeStub : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString title MEMBER title NOTIFY titleChanged)
+    Q_PROPERTY(int     type  MEMBER type  NOTIFY typeChanged)
+
+public:
+    IndexedNodeStub(const QString &uuid, const QString &title, int type,
+                    QObject *parent = nullptr);
+
+    QString title;
+    int     type = 0;
+
+signals:
+    void titleChanged();
+    void typeChanged();
+};
+
+/*! ***********************************************************************************************
+ * NodeIndexCPP: type counts, swap-with-last removal, renames and type changes of indexed nodes,
+ * and the pages of the prefix / substring searches.
+ * ************************************************************************************************/
+class TestNodeIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void typeCounts();
+    void removalSwapsWithLast();
+    void renamesAndTypeChanges();
+    void prefixPages();
+    void substringPages();
+};
+
+#endif // TEST_NODE_INDEX_H
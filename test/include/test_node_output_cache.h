@@ -0,0 +1,21 @@
+#ifndef TEST_NODE_OUTPUT_CACHE_H
+#define TEST_NODE_OUTPUT_CACHE_H
+
+#include <QObject>
+
+/*! ***********************************************************************************************
+ * NodeOutputCache (examples/visionLink): least recently used eviction within byteBudget, the
+ * hit / miss counters, and the keys of the blur outputs of ImageProcessor.
+ * ************************************************************************************************/
+class TestNodeOutputCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void evictsLeastRecentlyUsed();
+    void shrinkingBudgetEvicts();
+    void countsHitsAndMisses();
+    void roundedRadiiShareOutput();
+};
+
+#endif // TEST_NODE_OUTPUT_CACHE_H
@@ -0,0 +1,520 @@
+#include "test_command_stack.h"
+
+#include <QCoreApplication>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QPointer>
+#include <QTest>
+
+#include "CommandStackCPP.h"
+
+namespace {
+//! The stack replays its records with the engine it is exposed to
+void expose(QJSEngine &engine, CommandStackCPP &stack)
+{
+    QJSEngine::setObjectOwnership(&stack, QJSEngine::CppOwnership);
+    engine.globalObject().setProperty("stack", engine.newQObject(&stack));
+}
+
+//! Renames target and pushes it as a record of the pending batch
+void rename(CommandStackCPP &stack, QObject &target, const QString &name)
+{
+    const QString oldName = target.objectName();
+    target.setObjectName(name);
+    stack.pushProperty(&target, "objectName", QJSValue(oldName), QJSValue(name));
+}
+
+void finalize(CommandStackCPP &stack)
+{
+    QVERIFY(QMetaObject::invokeMethod(&stack, "finalizePending"));
+}
+
+//! Renames target to prefix + 1 ... prefix + count, one macro each
+void pushRenames(CommandStackCPP &stack, QObject &target, const QString &prefix, int count)
+{
+    for (int index = 1; index <= count; ++index) {
+        rename(stack, target, prefix + QString::number(index));
+        finalize(stack);
+    }
+}
+
+QString uuidOf(const QObject *object)
+{
+    return object->property("_qsUuid").toString();
+}
+
+QVariantList objectList(const QList<QObject *> &objects)
+{
+    QVariantList list;
+    for (QObject *object : objects)
+        list.append(QVariant::fromValue(object));
+    return list;
+}
+
+QObject *createObject(QObject *parent, const QString &uuid)
+{
+    auto *object = new QObject(parent);
+    object->setProperty("_qsUuid", uuid);
+    return object;
+}
+
+QObject *createLink(QObject *parent, const QString &uuid, const QString &portA,
+                    const QString &portB)
+{
+    QObject *link = createObject(parent, uuid);
+    link->setProperty("inputPortUuid", portA);
+    link->setProperty("outputPortUuid", portB);
+    return link;
+}
+
+//! Deletes of the released objects (deleteLater())
+void processDeletes()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+}
+
+/* ************************************************************************************************
+ * CommandSceneStub
+ * ************************************************************************************************/
+
+void CommandSceneStub::addNode(QObject *node)
+{
+    nodes.insert(uuidOf(node), QVariant::fromValue(node));
+}
+
+void CommandSceneStub::addNodes(const QVariantList &nodeArray, bool)
+{
+    for (const QVariant &node : nodeArray)
+        addNode(node.value<QObject *>());
+}
+
+void CommandSceneStub::_detachNodes(const QVariantList &nodeArray)
+{
+    for (const QVariant &node : nodeArray)
+        nodes.remove(uuidOf(node.value<QObject *>()));
+}
+
+void CommandSceneStub::deleteNode(const QString &nodeUuid)
+{
+    nodes.remove(nodeUuid);
+}
+
+void CommandSceneStub::deleteNodes(const QStringList &nodeUuids)
+{
+    for (const QString &nodeUuid : nodeUuids)
+        nodes.remove(nodeUuid);
+}
+
+QObject *CommandSceneStub::createLink(const QString &portA, const QString &portB)
+{
+    QObject *link = ::createLink(this, portA + "->" + portB, portA, portB);
+    links.insert(uuidOf(link), QVariant::fromValue(link));
+    return link;
+}
+
+void CommandSceneStub::restoreLinks(const QVariantList &linkArray)
+{
+    for (const QVariant &value : linkArray) {
+        QObject *link = value.value<QObject *>();
+        links.insert(uuidOf(link), QVariant::fromValue(link));
+    }
+}
+
+void CommandSceneStub::_detachLink(QObject *link)
+{
+    links.remove(uuidOf(link));
+}
+
+void CommandSceneStub::unlinkNodes(const QString &portA, const QString &portB)
+{
+    for (auto it = links.begin(); it != links.end(); ++it) {
+        const QObject *link = it.value().value<QObject *>();
+        if (link->property("inputPortUuid") == portA && link->property("outputPortUuid") == portB) {
+            links.erase(it);
+            return;
+        }
+    }
+}
+
+void CommandSceneStub::addContainer(QObject *container)
+{
+    containers.insert(uuidOf(container), QVariant::fromValue(container));
+}
+
+void CommandSceneStub::_detachContainer(QObject *container)
+{
+    containers.remove(uuidOf(container));
+}
+
+void CommandSceneStub::deleteContainer(const QString &containerUuid)
+{
+    containers.remove(containerUuid);
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestCommandStack::propertyUndoRedo()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    QObject target;
+    target.setObjectName("a");
+    rename(stack, target, "b");
+    finalize(stack);
+    QCOMPARE(stack.undoCount(), 1);
+    QVERIFY(!stack.isValidRedo());
+
+    stack.undo();
+    QCOMPARE(target.objectName(), QString("a"));
+    QCOMPARE(stack.undoCount(), 0);
+    QCOMPARE(stack.redoCount(), 1);
+
+    stack.redo();
+    QCOMPARE(target.objectName(), QString("b"));
+    QCOMPARE(stack.undoCount(), 1);
+    QCOMPARE(stack.redoCount(), 0);
+}
+
+void TestCommandStack::batchIsOneMacro()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    QObject target;
+    target.setObjectName("a");
+    rename(stack, target, "b");
+    rename(stack, target, "c");
+
+    // The pending batch can be undone before it is finalized
+    QVERIFY(stack.isValidUndo());
+    QCOMPARE(stack.undoCount(), 0);
+
+    // Its records are undone in reverse order
+    stack.undo();
+    QCOMPARE(target.objectName(), QString("a"));
+    QCOMPARE(stack.undoCount(), 0);
+    QCOMPARE(stack.redoCount(), 1);
+
+    stack.redo();
+    QCOMPARE(target.objectName(), QString("c"));
+}
+
+void TestCommandStack::fullRingDropsOldest()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+    stack.setMaxStackSize(3);
+
+    QObject target;
+    target.setObjectName("n0");
+    pushRenames(stack, target, "n", 5);
+    QCOMPARE(stack.undoCount(), 3);
+
+    for (int index = 0; index < 3; ++index)
+        stack.undo();
+    QCOMPARE(target.objectName(), QString("n2"));
+    QVERIFY(!stack.isValidUndo());
+
+    stack.undo();
+    QCOMPARE(target.objectName(), QString("n2"));
+    QCOMPARE(stack.redoCount(), 3);
+}
+
+void TestCommandStack::pushClearsRedo()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    QObject target;
+    target.setObjectName("n0");
+    pushRenames(stack, target, "n", 3);
+
+    stack.undo();
+    stack.undo();
+    QCOMPARE(stack.redoCount(), 2);
+
+    rename(stack, target, "other");
+    finalize(stack);
+    QCOMPARE(stack.undoCount(), 2);
+    QCOMPARE(stack.redoCount(), 0);
+
+    stack.undo();
+    QCOMPARE(target.objectName(), QString("n1"));
+}
+
+/*!
+ * An unlimited stack grows past its initial capacity; a smaller maximum drops the oldest undo
+ * entries and keeps the redo entries.
+ */
+void TestCommandStack::resizeKeepsNewest()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+    stack.setMaxStackSize(0);
+
+    QObject target;
+    target.setObjectName("n0");
+    pushRenames(stack, target, "n", 40);
+    QCOMPARE(stack.undoCount(), 40);
+
+    for (int index = 0; index < 5; ++index)
+        stack.undo();
+    QCOMPARE(target.objectName(), QString("n35"));
+
+    stack.setMaxStackSize(10);
+    QCOMPARE(stack.undoCount(), 5);
+    QCOMPARE(stack.redoCount(), 5);
+
+    for (int index = 0; index < 5; ++index)
+        stack.redo();
+    QCOMPARE(target.objectName(), QString("n40"));
+
+    for (int index = 0; index < 10; ++index)
+        stack.undo();
+    QCOMPARE(target.objectName(), QString("n30"));
+    QVERIFY(!stack.isValidUndo());
+}
+
+void TestCommandStack::customCommand()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    QJSValue command = engine.evaluate(
+        "({ count: 0, replaying: false,"
+        "   undo: function() { this.count--; this.replaying = stack.isReplaying; },"
+        "   redo: function() { this.count++; } })");
+    QVERIFY(!command.isError());
+
+    // Not applied yet: push() runs redo() first
+    stack.push(command, false);
+    QCOMPARE(command.property("count").toInt(), 1);
+
+    stack.undo();
+    QCOMPARE(command.property("count").toInt(), 0);
+    QVERIFY(command.property("replaying").toBool());
+    QVERIFY(!stack.isReplaying());
+
+    stack.redo();
+    QCOMPARE(command.property("count").toInt(), 1);
+
+    // A command without undo() is not pushed
+    QTest::ignoreMessage(QtWarningMsg, "CommandStackCPP: A command needs undo() and redo() functions");
+    stack.push(engine.evaluate("({ redo: function() {} })"));
+    QVERIFY(!stack.isValidRedo());
+    QCOMPARE(stack.undoCount(), 1);
+}
+
+/*!
+ * Undo of an add detaches the nodes (I_Scene._detachNodes), redo adds the same objects again.
+ */
+void TestCommandStack::nodeRecords()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    CommandSceneStub scene;
+    QJSEngine::setObjectOwnership(&scene, QJSEngine::CppOwnership);
+    QObject *first  = createObject(&scene, "test-stack-node-1");
+    QObject *second = createObject(&scene, "test-stack-node-2");
+    QObject *third  = createObject(&scene, "test-stack-node-3");
+
+    scene.addNode(first);
+    stack.pushAddNode(&scene, first);
+    finalize(stack);
+
+    scene.addNodes(objectList({ second, third }), false);
+    stack.pushAddNodes(&scene, objectList({ second, third }));
+    finalize(stack);
+    QCOMPARE(scene.nodes.size(), 3);
+
+    stack.undo();
+    QCOMPARE(scene.nodes.keys(), QStringList{ "test-stack-node-1" });
+    stack.undo();
+    QVERIFY(scene.nodes.isEmpty());
+
+    stack.redo();
+    stack.redo();
+    QCOMPARE(scene.nodes.size(), 3);
+    QCOMPARE(scene.nodes.value("test-stack-node-2").value<QObject *>(), second);
+
+    // Deleted one by one (I_Scene.deleteNode)
+    scene.deleteNode(uuidOf(first));
+    stack.pushRemoveNode(&scene, first, {});
+    finalize(stack);
+
+    stack.undo();
+    QCOMPARE(scene.nodes.value("test-stack-node-1").value<QObject *>(), first);
+    stack.redo();
+    QVERIFY(!scene.nodes.contains("test-stack-node-1"));
+    QVERIFY(!stack.isReplaying());
+}
+
+/*!
+ * Undo of a deletion restores the nodes and the link objects removed with them.
+ */
+void TestCommandStack::removedNodesRestoreLinks()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    CommandSceneStub scene;
+    QJSEngine::setObjectOwnership(&scene, QJSEngine::CppOwnership);
+    QObject *source = createObject(&scene, "test-stack-source");
+    QObject *target = createObject(&scene, "test-stack-target");
+    QObject *link   = createLink(&scene, "test-stack-link", "test-stack-out", "test-stack-in");
+    link->setProperty("color", "red");
+
+    scene.addNodes(objectList({ source, target }), false);
+    scene.restoreLinks(objectList({ link }));
+
+    // I_Scene.deleteNodes
+    scene.deleteNodes({ uuidOf(source), uuidOf(target) });
+    scene._detachLink(link);
+    stack.pushRemoveNodes(&scene, objectList({ source, target }), objectList({ link }));
+    finalize(stack);
+
+    stack.undo();
+    QCOMPARE(scene.nodes.size(), 2);
+    QCOMPARE(scene.links.value("test-stack-link").value<QObject *>(), link);
+    QCOMPARE(link->property("color").toString(), QString("red"));
+
+    stack.redo();
+    QVERIFY(scene.nodes.isEmpty());
+}
+
+/*!
+ * A created link is detached on undo and restored as the same object on redo; an unlink
+ * restores the removed object.
+ */
+void TestCommandStack::linkRecords()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    CommandSceneStub scene;
+    QJSEngine::setObjectOwnership(&scene, QJSEngine::CppOwnership);
+    QObject *link = scene.createLink("test-stack-a", "test-stack-b");
+    stack.pushCreateLink(&scene, "test-stack-a", "test-stack-b", link);
+    finalize(stack);
+
+    stack.undo();
+    QVERIFY(scene.links.isEmpty());
+    stack.redo();
+    QCOMPARE(scene.links.value(uuidOf(link)).value<QObject *>(), link);
+
+    // Created by the record (no link object yet)
+    stack.pushCreateLink(&scene, "test-stack-c", "test-stack-d", nullptr);
+    finalize(stack);
+    stack.undo();
+    stack.redo();
+    QCOMPARE(scene.links.size(), 2);
+    QVERIFY(scene.links.contains("test-stack-c->test-stack-d"));
+
+    scene.unlinkNodes("test-stack-a", "test-stack-b");
+    stack.pushUnlink(&scene, "test-stack-a", "test-stack-b", link);
+    finalize(stack);
+    QVERIFY(!scene.links.contains(uuidOf(link)));
+
+    stack.undo();
+    QCOMPARE(scene.links.value(uuidOf(link)).value<QObject *>(), link);
+    stack.redo();
+    QVERIFY(!scene.links.contains(uuidOf(link)));
+}
+
+void TestCommandStack::containerRecords()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+
+    CommandSceneStub scene;
+    QJSEngine::setObjectOwnership(&scene, QJSEngine::CppOwnership);
+    QObject *container = createObject(&scene, "test-stack-container");
+
+    scene.addContainer(container);
+    stack.pushAddContainer(&scene, container);
+    finalize(stack);
+
+    stack.undo();
+    QVERIFY(scene.containers.isEmpty());
+    stack.redo();
+    QCOMPARE(scene.containers.value("test-stack-container").value<QObject *>(), container);
+
+    scene.deleteContainer(uuidOf(container));
+    stack.pushRemoveContainer(&scene, container);
+    finalize(stack);
+
+    stack.undo();
+    QVERIFY(scene.containers.contains("test-stack-container"));
+    stack.redo();
+    QVERIFY(scene.containers.isEmpty());
+}
+
+/*!
+ * A discarded entry deletes the objects it holds that are no longer in the scene, objects of the
+ * scene are kept.
+ */
+void TestCommandStack::discardReleasesRemovedObjects()
+{
+    QJSEngine engine;
+    CommandStackCPP stack;
+    expose(engine, stack);
+    stack.setMaxStackSize(1);
+
+    CommandSceneStub scene;
+    QJSEngine::setObjectOwnership(&scene, QJSEngine::CppOwnership);
+    QPointer<QObject> kept    = createObject(&scene, "test-stack-kept");
+    QPointer<QObject> removed = createObject(&scene, "test-stack-removed");
+    QPointer<QObject> link    = createLink(&scene, "test-stack-removed-link", "test-stack-x",
+                                           "test-stack-y");
+
+    // Added and still in the scene when the entry is dropped from the full ring
+    scene.addNode(kept);
+    stack.pushAddNode(&scene, kept);
+    finalize(stack);
+
+    // Deleted with its link, dropped when the next entry is pushed
+    scene.addNode(removed);
+    scene.restoreLinks(objectList({ link }));
+    scene.deleteNode(uuidOf(removed));
+    scene._detachLink(link);
+    stack.pushRemoveNode(&scene, removed, objectList({ link }));
+    finalize(stack);
+    processDeletes();
+    QVERIFY(kept);
+
+    QObject target;
+    rename(stack, target, "other");
+    finalize(stack);
+    processDeletes();
+    QVERIFY(!removed);
+    QVERIFY(!link);
+
+    // Undone adds are released when the redo entries are cleared
+    QPointer<QObject> undone = createObject(&scene, "test-stack-undone");
+    scene.addNode(undone);
+    stack.pushAddNode(&scene, undone);
+    finalize(stack);
+    stack.undo();
+    QVERIFY(!scene.nodes.contains("test-stack-undone"));
+
+    rename(stack, target, "again");
+    finalize(stack);
+    processDeletes();
+    QVERIFY(!undone);
+    QVERIFY(kept);
+}
@@ -0,0 +1,283 @@
+#include "test_handle_registry.h"
+
+#include <QTest>
+
+#include "HandleRegistryCPP.h"
+
+namespace {
+QVariantMap objectMap(const QList<QObject *> &objects)
+{
+    QVariantMap map;
+    for (QObject *object : objects)
+        map.insert(object->property("_qsUuid").toString(), QVariant::fromValue(object));
+    return map;
+}
+
+QVariantList objectList(const QList<QObject *> &objects)
+{
+    QVariantList list;
+    for (QObject *object : objects)
+        list.append(QVariant::fromValue(object));
+    return list;
+}
+
+QObject *createNode(QObject *parent, const QString &uuid, const QList<QObject *> &ports)
+{
+    auto *node = new SceneObjectStub(uuid, parent);
+    node->ports = objectMap(ports);
+    return node;
+}
+
+QObject *createLink(QObject *parent, const QString &uuid, QObject *inputPort, QObject *outputPort)
+{
+    auto *link = new SceneObjectStub(uuid, parent);
+    link->inputPort  = inputPort;
+    link->outputPort = outputPort;
+    return link;
+}
+
+//! I_Scene.addNodes()
+void addNodes(SceneObjectStub &scene, HandleRegistryCPP &registry, const QList<QObject *> &nodes)
+{
+    scene.nodes.insert(objectMap(nodes));
+    registry.addNodes(objectList(nodes));
+    emit scene.nodesChanged();
+}
+
+//! I_Scene.addLinks()
+void addLinks(SceneObjectStub &scene, HandleRegistryCPP &registry, const QList<QObject *> &links)
+{
+    scene.links.insert(objectMap(links));
+    registry.addLinks(objectList(links));
+    emit scene.linksChanged();
+}
+
+//! I_Scene.deleteNodes(): the nodes leave the scene first, then their links are removed one by
+//! one with linkRemoved, the change signals come last
+void deleteNodes(SceneObjectStub &scene, HandleRegistryCPP &registry, const QList<QObject *> &nodes)
+{
+    QList<QObject *> affectedLinks;
+    for (QObject *node : nodes) {
+        const QVariantMap ports = node->property("ports").toMap();
+        for (const QVariant &value : std::as_const(scene.links)) {
+            QObject *link = value.value<QObject *>();
+            const bool isConnected =
+                    ports.contains(link->property("inputPort").value<QObject *>()
+                                           ->property("_qsUuid").toString()) ||
+                    ports.contains(link->property("outputPort").value<QObject *>()
+                                           ->property("_qsUuid").toString());
+            if (isConnected && !affectedLinks.contains(link))
+                affectedLinks.append(link);
+        }
+
+        scene.nodes.remove(node->property("_qsUuid").toString());
+    }
+
+    registry.removeNodes(objectList(nodes));
+
+    for (QObject *link : std::as_const(affectedLinks)) {
+        registry.removeLink(link);
+        emit scene.linkRemoved(link);
+        scene.links.remove(link->property("_qsUuid").toString());
+    }
+
+    emit scene.linksChanged();
+    emit scene.nodesChanged();
+}
+}
+
+/* ************************************************************************************************
+ * SceneObjectStub
+ * ************************************************************************************************/
+
+SceneObjectStub::SceneObjectStub(const QString &uuid, QObject *parent)
+    : QObject{parent}
+{
+    setProperty("_qsUuid", uuid);
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestHandleRegistry::internIsStable()
+{
+    const int first = HandleRegistryCPP::intern("test-intern-a");
+    QVERIFY(first != 0);
+    QCOMPARE(HandleRegistryCPP::intern("test-intern-a"), first);
+    QVERIFY(HandleRegistryCPP::intern("test-intern-b") != first);
+    QCOMPARE(HandleRegistryCPP::uuidOf(first), QString("test-intern-a"));
+
+    QCOMPARE(HandleRegistryCPP::intern(QString()), 0);
+    QVERIFY(HandleRegistryCPP::uuidOf(0).isEmpty());
+}
+
+void TestHandleRegistry::lookupDoesNotIntern()
+{
+    const QString uuid = "test-lookup-unknown";
+    QCOMPARE(HandleRegistryCPP::lookup(uuid), 0);
+
+    HandleRegistryCPP registry;
+    QCOMPARE(registry.handle(uuid), 0);
+    QCOMPARE(HandleRegistryCPP::lookup(uuid), 0);
+
+    const int handle = HandleRegistryCPP::intern(uuid);
+    QVERIFY(handle != 0);
+    QCOMPARE(HandleRegistryCPP::lookup(uuid), handle);
+    QCOMPARE(registry.handle(uuid), handle);
+}
+
+/*!
+ * setTarget() indexes the existing objects, later changes go through the registry.
+ */
+void TestHandleRegistry::indicesFollowScene()
+{
+    SceneObjectStub scene("test-scene");
+
+    auto *upstreamPort   = new SceneObjectStub("test-port-up", &scene);
+    auto *downstreamPort = new SceneObjectStub("test-port-down", &scene);
+
+    QObject *source = createNode(&scene, "test-node-source", { upstreamPort });
+    QObject *target = createNode(&scene, "test-node-target", { downstreamPort });
+    QObject *link   = createLink(&scene, "test-link", upstreamPort, downstreamPort);
+
+    scene.nodes = objectMap({ source, target });
+    scene.links = objectMap({ link });
+
+    HandleRegistryCPP registry;
+    registry.setTarget(&scene);
+
+    const int up         = registry.handle("test-port-up");
+    const int down       = registry.handle("test-port-down");
+    const int sourceNode = registry.handle("test-node-source");
+    const int targetNode = registry.handle("test-node-target");
+    const int linkHandle = registry.handle("test-link");
+    QVERIFY(up != 0 && down != 0 && sourceNode != 0 && targetNode != 0 && linkHandle != 0);
+
+    QCOMPARE(registry.node(sourceNode), source);
+    QCOMPARE(registry.port(down), downstreamPort);
+    QCOMPARE(registry.link(linkHandle), link);
+    QCOMPARE(registry.nodeOfPort(up), sourceNode);
+    QCOMPARE(registry.nodeOfPort(down), targetNode);
+
+    QVERIFY(registry.hasLink(up, down));
+    QVERIFY(!registry.hasLink(down, up));
+    QCOMPARE(registry.linkBetween(up, down), link);
+    QCOMPARE(registry.linkCountFrom(up), 1);
+    QCOMPARE(registry.linkCountTo(down), 1);
+    QCOMPARE(registry.linkCountTo(up), 0);
+    QVERIFY(registry.hasNodeLink(sourceNode, targetNode));
+    QVERIFY(!registry.hasNodeLink(targetNode, sourceNode));
+
+    // Unlinked (I_Scene._detachLink): the handles stay valid
+    scene.links.clear();
+    registry.removeLink(link);
+    emit scene.linksChanged();
+
+    QVERIFY(!registry.hasLink(up, down));
+    QVERIFY(!registry.link(linkHandle));
+    QCOMPARE(registry.linkCountFrom(up), 0);
+    QVERIFY(!registry.hasNodeLink(sourceNode, targetNode));
+    QCOMPARE(registry.handle("test-link"), linkHandle);
+
+    // Replaced as a whole (a loaded repository)
+    scene.links = objectMap({ link });
+    registry.rebuild();
+    QVERIFY(registry.hasNodeLink(sourceNode, targetNode));
+}
+
+/*!
+ * Nodes and links added one by one, then ports added to a node and a link moved to another
+ * port, each announced only by the change signal of the object.
+ */
+void TestHandleRegistry::objectChangesAreTracked()
+{
+    SceneObjectStub scene("test-tracked-scene");
+    HandleRegistryCPP registry;
+    registry.setTarget(&scene);
+
+    auto *outPort = new SceneObjectStub("test-tracked-out", &scene);
+    auto *inPort  = new SceneObjectStub("test-tracked-in", &scene);
+    QObject *source = createNode(&scene, "test-tracked-source", { outPort });
+    QObject *target = createNode(&scene, "test-tracked-target", { inPort });
+    addNodes(scene, registry, { source, target });
+
+    QObject *link = createLink(&scene, "test-tracked-link", outPort, inPort);
+    addLinks(scene, registry, { link });
+
+    const int out = registry.handle("test-tracked-out");
+    const int in  = registry.handle("test-tracked-in");
+    QVERIFY(registry.hasLink(out, in));
+    QCOMPARE(registry.linkCountTo(in), 1);
+
+    // A port added to the target (Node.addPort)
+    auto *secondInPort = new SceneObjectStub("test-tracked-in-2", &scene);
+    target->setProperty("ports", objectMap({ inPort, secondInPort }));
+    const int secondIn = registry.handle("test-tracked-in-2");
+    QVERIFY(secondIn != 0);
+    QCOMPARE(registry.port(secondIn), secondInPort);
+    QCOMPARE(registry.nodeOfPort(secondIn), registry.handle("test-tracked-target"));
+
+    // The link moved to the new port
+    link->setProperty("outputPort", QVariant::fromValue<QObject *>(secondInPort));
+    QVERIFY(!registry.hasLink(out, in));
+    QVERIFY(registry.hasLink(out, secondIn));
+    QCOMPARE(registry.linkCountTo(in), 0);
+    QCOMPARE(registry.linkCountTo(secondIn), 1);
+    QVERIFY(registry.hasNodeLink(registry.handle("test-tracked-source"),
+                                 registry.handle("test-tracked-target")));
+}
+
+/*!
+ * Two gates feed a third one, the first is deleted. Handlers of linkRemoved (e.g. the logic
+ * evaluation of LogicCircuitScene) must not find the deleted gate any more.
+ */
+void TestHandleRegistry::removedNodesAreNotFound()
+{
+    SceneObjectStub scene("test-removed-scene");
+    HandleRegistryCPP registry;
+    registry.setTarget(&scene);
+
+    auto *firstOut  = new SceneObjectStub("test-removed-first-out", &scene);
+    auto *secondOut = new SceneObjectStub("test-removed-second-out", &scene);
+    auto *firstIn   = new SceneObjectStub("test-removed-first-in", &scene);
+    auto *secondIn  = new SceneObjectStub("test-removed-second-in", &scene);
+
+    QObject *first  = createNode(&scene, "test-removed-first", { firstOut });
+    QObject *second = createNode(&scene, "test-removed-second", { secondOut });
+    QObject *gate   = createNode(&scene, "test-removed-gate", { firstIn, secondIn });
+    addNodes(scene, registry, { first, second, gate });
+
+    QObject *firstLink  = createLink(&scene, "test-removed-first-link", firstOut, firstIn);
+    QObject *secondLink = createLink(&scene, "test-removed-second-link", secondOut, secondIn);
+    addLinks(scene, registry, { firstLink, secondLink });
+
+    const int firstOutHandle = registry.handle("test-removed-first-out");
+    QObject *foundOnRemoval = first;
+    int linksToGateOnRemoval = -1;
+    connect(&scene, &SceneObjectStub::linkRemoved, this, [&](QObject *) {
+        // I_Scene.findNode()
+        foundOnRemoval = registry.node(registry.nodeOfPort(firstOutHandle));
+        linksToGateOnRemoval = registry.linkCountTo(registry.handle("test-removed-first-in"));
+    });
+
+    deleteNodes(scene, registry, { first });
+    disconnect(&scene, &SceneObjectStub::linkRemoved, this, nullptr);
+
+    QCOMPARE(foundOnRemoval, nullptr);
+    QCOMPARE(linksToGateOnRemoval, 0);
+    QVERIFY(!registry.node(registry.handle("test-removed-first")));
+    QVERIFY(!registry.port(firstOutHandle));
+    QVERIFY(!registry.link(registry.handle("test-removed-first-link")));
+
+    QVERIFY(registry.hasNodeLink(registry.handle("test-removed-second"),
+                                 registry.handle("test-removed-gate")));
+    QCOMPARE(registry.node(registry.nodeOfPort(registry.handle("test-removed-second-out"))),
+             second);
+
+    // Undo of the deletion (restoreLinks after addNodes)
+    addNodes(scene, registry, { first });
+    addLinks(scene, registry, { firstLink });
+    QCOMPARE(registry.node(registry.nodeOfPort(firstOutHandle)), first);
+    QCOMPARE(registry.linkCountTo(registry.handle("test-removed-first-in")), 1);
+}
@@ -0,0 +1,166 @@
+#include "test_image_pipeline.h"
+
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVariantMap>
+
+#include <functional>
+
+#include "ImagePipeline.h"
+
+namespace {
+using Stage     = ImagePipeline::Stage;
+using Operation = ImagePipeline::Operation;
+
+QImage randomImage(int width, int height, QImage::Format format = QImage::Format_ARGB32)
+{
+    QRandomGenerator generator(42);
+    QImage image(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x)
+            row[x] = generator.generate();
+    }
+
+    return image.convertToFormat(format);
+}
+
+//! The color channels of every pixel through function, alpha is kept
+QImage mapChannels(const QImage &image, const std::function<int(int)> &function)
+{
+    QImage result(image.size(), QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            const QRgb pixel = image.pixel(x, y);
+            result.setPixel(x, y, qRgba(function(qRed(pixel)), function(qGreen(pixel)),
+                                        function(qBlue(pixel)), qAlpha(pixel)));
+        }
+    }
+
+    return result;
+}
+
+QImage brightness(const QImage &image, qreal level)
+{
+    const int adjustment = qRound(level * 255.0);
+    return mapChannels(image, [=](int value) { return qBound(0, value + adjustment, 255); });
+}
+
+QImage contrast(const QImage &image, qreal level)
+{
+    const qreal factor = level + 1.0;
+    return mapChannels(image, [=](int value) {
+        return qBound(0, qRound(factor * (value - 128) + 128), 255);
+    });
+}
+
+//! Box blur of the whole image, horizontal then vertical, positions clamped to the image
+QImage blur(const QImage &image, int radius)
+{
+    const int width  = image.width();
+    const int height = image.height();
+    const int count  = 2 * radius + 1;
+
+    auto average = [count](const std::function<QRgb(int)> &pixelAt) {
+        int r = 0, g = 0, b = 0, a = 0;
+        for (int offset = -(count / 2); offset <= count / 2; ++offset) {
+            const QRgb pixel = pixelAt(offset);
+            r += qRed(pixel);
+            g += qGreen(pixel);
+            b += qBlue(pixel);
+            a += qAlpha(pixel);
+        }
+        return qRgba(r / count, g / count, b / count, a / count);
+    };
+
+    QImage horizontal(image.size(), QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            horizontal.setPixel(x, y, average([&](int dx) {
+                return image.pixel(qBound(0, x + dx, width - 1), y);
+            }));
+
+    QImage result(image.size(), QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            result.setPixel(x, y, average([&](int dy) {
+                return horizontal.pixel(x, qBound(0, y + dy, height - 1));
+            }));
+
+    return result;
+}
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestImagePipeline::noOpStagesAreDropped()
+{
+    const ImagePipeline pipeline({ { Operation::Blur, 0.05 },
+                                   { Operation::Brightness, 0.005 },
+                                   { Operation::Contrast, 0.0 } });
+    QVERIFY(pipeline.isIdentity());
+    QCOMPARE(pipeline.halo(), 0);
+    QVERIFY(pipeline.description().isEmpty());
+
+    const QImage image = randomImage(16, 16);
+    QCOMPARE(pipeline.process(image), image);
+}
+
+void TestImagePipeline::pixelStagesAreFused()
+{
+    const ImagePipeline pipeline({ { Operation::Brightness, 0.5 },
+                                   { Operation::Contrast, 0.25 },
+                                   { Operation::Blur, 2 },
+                                   { Operation::Blur, 1 },
+                                   { Operation::Contrast, -0.5 } });
+    QVERIFY(!pipeline.isIdentity());
+    QCOMPARE(pipeline.halo(), 3);
+    QCOMPARE(pipeline.description(),
+             QString("lut:brightness:0.5,contrast:0.25;blur:2;blur:1;lut:contrast:-0.5"));
+}
+
+void TestImagePipeline::stagesFromVariant()
+{
+    QTest::ignoreMessage(QtWarningMsg, "ImagePipeline: Unknown stage \"sharpen\"");
+
+    const QVariantList stages = {
+        QVariantMap{ { "kernel", "blur" },       { "value", 3 } },
+        QVariantMap{ { "kernel", "sharpen" },    { "value", 1 } },
+        QVariantMap{ { "kernel", "brightness" }, { "value", 0.5 } }
+    };
+
+    QCOMPARE(ImagePipeline::fromVariant(stages).description(),
+             QString("blur:3;lut:brightness:0.5"));
+}
+
+/*!
+ * 2500 rows of 64 pixels are processed in three tiles, the blurs need the halo rows.
+ */
+void TestImagePipeline::tiledPassMatchesOperations()
+{
+    const QImage image = randomImage(64, 2500);
+
+    const ImagePipeline pipeline({ { Operation::Brightness, 0.2 },
+                                   { Operation::Blur, 3 },
+                                   { Operation::Contrast, 0.3 },
+                                   { Operation::Blur, 2 } });
+
+    const QImage expected = blur(contrast(blur(brightness(image, 0.2), 3), 0.3), 2);
+    QCOMPARE(pipeline.process(image), expected);
+}
+
+void TestImagePipeline::otherFormatsAreConverted()
+{
+    const ImagePipeline pipeline({ { Operation::Blur, 2 }, { Operation::Contrast, 0.4 } });
+
+    const QImage rgb888 = randomImage(50, 40, QImage::Format_RGB888);
+    QCOMPARE(pipeline.process(rgb888),
+             pipeline.process(rgb888.convertToFormat(QImage::Format_ARGB32)));
+
+    const QImage rgb32 = randomImage(50, 40, QImage::Format_RGB32);
+    QCOMPARE(pipeline.process(rgb32),
+             contrast(blur(rgb32.convertToFormat(QImage::Format_ARGB32), 2), 0.4));
+}
@@ -0,0 +1,237 @@
+#include "test_link_router.h"
+
+#include <QPointF>
+#include <QRectF>
+#include <QTest>
+#include <QVariantMap>
+#include <QVector>
+#include <QVector2D>
+
+#include "LinkRouterCPP.h"
+#include "NodeGuiConfigCPP.h"
+#include "test_handle_registry.h"
+
+namespace {
+//! NLSpec.LinkType
+enum LinkType {
+    Bezier   = 0,
+    LLine    = 1,
+    Straight = 2
+};
+
+//! NLSpec.PortPositionSide
+enum Side {
+    Left  = 2,
+    Right = 3
+};
+
+//! The link goes from the right side of (0, 0) to the left side of (300, 0)
+const QVector2D Start(0, 0);
+const QVector2D End(300, 0);
+
+//! A node between the ends of the link
+const QRectF NodeRect(100, -50, 100, 100);
+
+QVector<QPointF> toPoints(const QVariantList &route)
+{
+    QVector<QPointF> points;
+    for (const QVariant &point : route)
+        points.append(point.value<QVector2D>().toPointF());
+    return points;
+}
+
+//! A segment of the polyline runs through the inside of rect
+bool crosses(const QVector<QPointF> &points, const QRectF &rect)
+{
+    for (int index = 1; index < points.size(); ++index) {
+        const QRectF segment = QRectF(points.at(index - 1), points.at(index)).normalized();
+        if (segment.left() < rect.right() && segment.right() > rect.left() &&
+            segment.top() < rect.bottom() && segment.bottom() > rect.top())
+            return true;
+    }
+
+    return false;
+}
+
+bool isStraight(const QVector<QPointF> &points)
+{
+    for (const QPointF &point : points) {
+        if (!qFuzzyIsNull(point.y()))
+            return false;
+    }
+
+    return true;
+}
+
+void placeNode(NodeGuiConfigCPP &node, QObject *owner = nullptr)
+{
+    node.setOwner(owner);
+    node.setPosition(QVector2D(NodeRect.topLeft()));
+    node.setWidth(int(NodeRect.width()));
+    node.setHeight(int(NodeRect.height()));
+}
+
+QVector<QPointF> route(LinkRouterCPP &router, QObject *link, int type)
+{
+    return toPoints(router.route(link, Start, End, type, Right, Left, 0));
+}
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestLinkRouter::emptySceneRoutes()
+{
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    QObject link;
+
+    const QVector<QPointF> straight = route(router, &link, Straight);
+    QCOMPARE(straight.size(), 4);
+    QCOMPARE(straight.first(), Start.toPointF());
+    QCOMPARE(straight.last(), End.toPointF());
+
+    // The default curve: handles of 100 along the port sides
+    const QVector<QPointF> bezier = route(router, &link, Bezier);
+    const QVector<QPointF> curve = { QPointF(0, 0), QPointF(100, 0), QPointF(200, 0),
+                                     QPointF(300, 0) };
+    QCOMPARE(bezier, curve);
+
+    const QVector<QPointF> lLine = route(router, &link, LLine);
+    QCOMPARE(lLine.first(), Start.toPointF());
+    QCOMPARE(lLine.last(), End.toPointF());
+    QVERIFY(isStraight(lLine));
+    QCOMPARE(router.pendingCount(), 0);
+}
+
+void TestLinkRouter::lLineAvoidsNode()
+{
+    NodeGuiConfigCPP node;
+    placeNode(node);
+
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    QObject link;
+
+    const QVector<QPointF> points = route(router, &link, LLine);
+    QCOMPARE(points.first(), Start.toPointF());
+    QCOMPARE(points.last(), End.toPointF());
+    QVERIFY(!crosses(points, NodeRect));
+
+    // Orthogonal segments only
+    for (int index = 1; index < points.size(); ++index) {
+        const QPointF delta = points.at(index) - points.at(index - 1);
+        QVERIFY(qFuzzyIsNull(delta.x()) || qFuzzyIsNull(delta.y()));
+    }
+}
+
+void TestLinkRouter::bezierBendsAroundNode()
+{
+    NodeGuiConfigCPP node;
+    placeNode(node);
+
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    QObject link;
+
+    // Cubic segments along the orthogonal route instead of the default curve
+    const QVector<QPointF> points = route(router, &link, Bezier);
+    QVERIFY(points.size() > 4);
+    QCOMPARE((points.size() - 1) % 3, 0);
+    QCOMPARE(points.first(), Start.toPointF());
+    QCOMPARE(points.last(), End.toPointF());
+    QVERIFY(!isStraight(points));
+}
+
+void TestLinkRouter::movedNodeInvalidatesRoute()
+{
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    QObject link;
+
+    QVERIFY(isStraight(route(router, &link, LLine)));
+
+    // The node moves onto the straight route
+    NodeGuiConfigCPP node;
+    placeNode(node);
+    QCOMPARE(router.pendingCount(), 1);
+
+    const QVector<QPointF> points = route(router, &link, LLine);
+    QVERIFY(!crosses(points, NodeRect));
+
+    // And away from it
+    node.setPosition(QVector2D(1000, 1000));
+    QVERIFY(isStraight(route(router, &link, LLine)));
+}
+
+void TestLinkRouter::hiddenNodeIsNoObstacle()
+{
+    QObject owner;
+    owner.setProperty("_qsUuid", QString("test-router-node"));
+
+    NodeGuiConfigCPP node;
+    placeNode(node, &owner);
+
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    QObject link;
+
+    QVERIFY(!crosses(route(router, &link, LLine), NodeRect));
+
+    router.setHiddenNodes(QVariantMap{ { QString("test-router-node"), true } });
+    QVERIFY(isStraight(route(router, &link, LLine)));
+
+    router.setHiddenNodes(QVariantMap());
+    QVERIFY(!crosses(route(router, &link, LLine), NodeRect));
+}
+
+/*!
+ * A deleted node keeps its row while the undo stack holds it, only the nodes of the scene are
+ * obstacles.
+ */
+void TestLinkRouter::removedNodeIsNoObstacle()
+{
+    SceneObjectStub scene("test-router-scene");
+    SceneObjectStub owner("test-router-scene-node");
+
+    NodeGuiConfigCPP node;
+    owner.setProperty("guiConfig", QVariant::fromValue<QObject *>(&node));
+    placeNode(node, &owner);
+    scene.nodes.insert("test-router-scene-node", QVariant::fromValue<QObject *>(&owner));
+
+    // A node of the repository outside of the scene (e.g. an earlier deletion)
+    QObject strayOwner;
+    NodeGuiConfigCPP strayNode;
+    placeNode(strayNode, &strayOwner);
+    strayNode.setPosition(QVector2D(1000, 1000));
+
+    LinkRouterCPP router;
+    router.setFrameBudget(1000);
+    router.setScene(&scene);
+    QObject link;
+
+    QVERIFY(!crosses(route(router, &link, LLine), NodeRect));
+
+    // Deleted (I_Scene.deleteNodes)
+    scene.nodes.clear();
+    router.removeNodes({ QVariant::fromValue<QObject *>(&owner) });
+    QCOMPARE(router.pendingCount(), 1);
+    QVERIFY(isStraight(route(router, &link, LLine)));
+
+    // Moved onto the route while deleted, or the stray node moved there
+    strayNode.setPosition(QVector2D(NodeRect.topLeft()));
+    QVERIFY(isStraight(route(router, &link, LLine)));
+    strayNode.setPosition(QVector2D(1000, 1000));
+
+    // Undone (I_Scene.addNodes)
+    scene.nodes.insert("test-router-scene-node", QVariant::fromValue<QObject *>(&owner));
+    router.addNodes({ QVariant::fromValue<QObject *>(&owner) });
+    QVERIFY(!crosses(route(router, &link, LLine), NodeRect));
+
+    // Without a scene every node of the repository is an obstacle
+    router.setScene(nullptr);
+    node.setPosition(QVector2D(1000, 1000));
+    strayNode.setPosition(QVector2D(NodeRect.topLeft()));
+    QVERIFY(!crosses(route(router, &link, LLine), NodeRect));
+}
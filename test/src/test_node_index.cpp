@@ -0,0 +1,211 @@
+#include "test_node_index.h"
+
+#include <QTest>
+
+#include "HandleRegistryCPP.h"
+#include "NodeIndexCPP.h"
+
+namespace {
+int handleOf(const QString &uuid)
+{
+    return HandleRegistryCPP::lookup(uuid);
+}
+
+//! Handles of a search result
+QList<int> handlesOf(const QVariantMap &page)
+{
+    QList<int> handles;
+    for (const QVariant &handle : page.value("handles").toList())
+        handles.append(handle.toInt());
+    return handles;
+}
+}
+
+/* ************************************************************************************************
+ * IndexedNodeStub
+ * ************************************************************************************************/
+
+IndexedNodeStub::IndexedNodeStub(const QString &uuid, const QString &title, int type,
+                                 QObject *parent)
+    : QObject{parent}
+    , title{title}
+    , type{type}
+{
+    setProperty("_qsUuid", uuid);
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestNodeIndex::typeCounts()
+{
+    IndexedNodeStub first("test-index-count-1", "Add_1", 1);
+    IndexedNodeStub second("test-index-count-2", "Add_2", 1);
+    IndexedNodeStub third("test-index-count-3", "Multiply_1", 2);
+
+    NodeIndexCPP index;
+    index.insertAll({ QVariant::fromValue<QObject *>(&first),
+                      QVariant::fromValue<QObject *>(&second),
+                      QVariant::fromValue<QObject *>(&third) });
+
+    // Inserted twice (nodeAdded after nodesAdded)
+    index.insert(&first);
+
+    QCOMPARE(index.count(), 3);
+    QCOMPARE(index.typeCount(1), 2);
+    QCOMPARE(index.typeCount(2), 1);
+    QCOMPARE(index.typeCount(3), 0);
+
+    index.remove(&first);
+    index.remove(&first);
+    QCOMPARE(index.typeCount(1), 1);
+    QCOMPARE(index.count(), 2);
+
+    index.clear();
+    QCOMPARE(index.count(), 0);
+    QCOMPARE(index.typeCount(2), 0);
+
+    // Cleared nodes are not followed any more
+    third.type = 1;
+    emit third.typeChanged();
+    QCOMPARE(index.typeCount(1), 0);
+}
+
+/*!
+ * The last row takes the place of a removed one: the scans then return it at the removed
+ * position, and a later change of the moved node updates its new row.
+ */
+void TestNodeIndex::removalSwapsWithLast()
+{
+    IndexedNodeStub first("test-index-swap-1", "node a", 1);
+    IndexedNodeStub second("test-index-swap-2", "node b", 1);
+    IndexedNodeStub third("test-index-swap-3", "node c", 1);
+    IndexedNodeStub fourth("test-index-swap-4", "node d", 1);
+
+    NodeIndexCPP index;
+    for (QObject *node : { &first, &second, &third, &fourth })
+        index.insert(node);
+
+    index.remove(&second);
+    QCOMPARE(handlesOf(index.findBySubstring("node", 0, -1)),
+             (QList<int>{ handleOf("test-index-swap-1"), handleOf("test-index-swap-4"),
+                          handleOf("test-index-swap-3") }));
+
+    // The moved node keeps being tracked in its new row
+    fourth.title = "moved";
+    emit fourth.titleChanged();
+    fourth.type = 2;
+    emit fourth.typeChanged();
+    QCOMPARE(handlesOf(index.findBySubstring("node", 0, -1)),
+             (QList<int>{ handleOf("test-index-swap-1"), handleOf("test-index-swap-3") }));
+    QCOMPARE(handlesOf(index.findByType(2, 0, -1)), QList<int>{ handleOf("test-index-swap-4") });
+
+    // The last row itself
+    index.remove(&third);
+    QCOMPARE(handlesOf(index.findBySubstring("", 0, -1)),
+             (QList<int>{ handleOf("test-index-swap-1"), handleOf("test-index-swap-4") }));
+
+    // A destroyed node leaves the index
+    {
+        IndexedNodeStub temporary("test-index-swap-5", "node e", 1);
+        index.insert(&temporary);
+        QCOMPARE(index.count(), 3);
+    }
+    QCOMPARE(index.count(), 2);
+    QCOMPARE(index.typeCount(1), 1);
+    QCOMPARE(index.findByPrefix("node", 0, -1).value("total").toInt(), 1);
+}
+
+void TestNodeIndex::renamesAndTypeChanges()
+{
+    IndexedNodeStub node("test-index-rename", "Blur_1", 3);
+
+    NodeIndexCPP index;
+    index.insert(&node);
+    const int handle = handleOf("test-index-rename");
+    QVERIFY(handle != 0);
+
+    node.title = "Sharpen";
+    emit node.titleChanged();
+    QCOMPARE(index.findByPrefix("blur").value("total").toInt(), 0);
+    QCOMPARE(handlesOf(index.findByPrefix("sharp")), QList<int>{ handle });
+    QCOMPARE(handlesOf(index.findBySubstring("ARPE")), QList<int>{ handle });
+
+    node.type = 4;
+    emit node.typeChanged();
+    QCOMPARE(index.typeCount(3), 0);
+    QCOMPARE(index.typeCount(4), 1);
+    QCOMPARE(handlesOf(index.findByType(4)), QList<int>{ handle });
+    QCOMPARE(index.findByType(3).value("total").toInt(), 0);
+
+    // Removed nodes are not followed any more
+    index.remove(&node);
+    node.type = 3;
+    emit node.typeChanged();
+    QCOMPARE(index.typeCount(3), 0);
+    QCOMPARE(index.count(), 0);
+}
+
+/*!
+ * Prefix results are sorted by title, total counts all matches of the page.
+ */
+void TestNodeIndex::prefixPages()
+{
+    IndexedNodeStub alpha("test-index-prefix-1", "Result_c", 1);
+    IndexedNodeStub beta("test-index-prefix-2", "result_a", 1);
+    IndexedNodeStub gamma("test-index-prefix-3", "RESULT_B", 1);
+    IndexedNodeStub other("test-index-prefix-4", "Sum of result", 1);
+
+    NodeIndexCPP index;
+    for (QObject *node : { &alpha, &beta, &gamma, &other })
+        index.insert(node);
+
+    const QVariantMap all = index.findByPrefix("result", 0, -1);
+    QCOMPARE(all.value("total").toInt(), 3);
+    QCOMPARE(handlesOf(all),
+             (QList<int>{ handleOf("test-index-prefix-2"), handleOf("test-index-prefix-3"),
+                          handleOf("test-index-prefix-1") }));
+
+    const QVariantMap page = index.findByPrefix("Result", 1, 1);
+    QCOMPARE(page.value("total").toInt(), 3);
+    QCOMPARE(page.value("offset").toInt(), 1);
+    QCOMPARE(handlesOf(page), QList<int>{ handleOf("test-index-prefix-3") });
+
+    const QVariantMap pastEnd = index.findByPrefix("result", 5, 10);
+    QCOMPARE(pastEnd.value("total").toInt(), 3);
+    QVERIFY(handlesOf(pastEnd).isEmpty());
+
+    QCOMPARE(index.findByPrefix("results").value("total").toInt(), 0);
+}
+
+/*!
+ * Substring results are in insertion order.
+ */
+void TestNodeIndex::substringPages()
+{
+    IndexedNodeStub first("test-index-substring-1", "Result_c", 1);
+    IndexedNodeStub second("test-index-substring-2", "Sum of result", 1);
+    IndexedNodeStub third("test-index-substring-3", "Blur", 1);
+    IndexedNodeStub fourth("test-index-substring-4", "result_a", 1);
+
+    NodeIndexCPP index;
+    for (QObject *node : { &first, &second, &third, &fourth })
+        index.insert(node);
+
+    const QVariantMap all = index.findBySubstring("RESULT", 0, -1);
+    QCOMPARE(all.value("total").toInt(), 3);
+    QCOMPARE(handlesOf(all),
+             (QList<int>{ handleOf("test-index-substring-1"), handleOf("test-index-substring-2"),
+                          handleOf("test-index-substring-4") }));
+
+    const QVariantMap page = index.findBySubstring("result", 1, 2);
+    QCOMPARE(page.value("total").toInt(), 3);
+    QCOMPARE(page.value("offset").toInt(), 1);
+    QCOMPARE(handlesOf(page),
+             (QList<int>{ handleOf("test-index-substring-2"), handleOf("test-index-substring-4") }));
+
+    const QVariantMap limited = index.findBySubstring("result", 0, 0);
+    QCOMPARE(limited.value("total").toInt(), 3);
+    QVERIFY(handlesOf(limited).isEmpty());
+}
@@ -0,0 +1,169 @@
+#include "test_node_output_cache.h"
+
+#include <QImage>
+#include <QTest>
+
+#include "ImageProcessor.h"
+#include "NodeOutputCache.h"
+
+namespace {
+//! 16 x 16 ARGB32: 1 KB
+constexpr qint64 ImageBytes = 16 * 16 * 4;
+
+QImage filledImage(QRgb color, int size = 16)
+{
+    QImage image(size, size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+QString keyOf(const QString &operation, const QImage &input)
+{
+    return NodeOutputCache::fingerprint(operation, 1.0, QVariant::fromValue(input));
+}
+
+bool contains(NodeOutputCache &cache, const QString &key)
+{
+    QImage output;
+    return cache.find(key, output);
+}
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+
+void TestNodeOutputCache::evictsLeastRecentlyUsed()
+{
+    NodeOutputCache cache;
+    cache.setByteBudget(2 * ImageBytes + ImageBytes / 2);
+
+    const QImage input = filledImage(qRgb(10, 20, 30));
+    const QString first  = keyOf("first", input);
+    const QString second = keyOf("second", input);
+    const QString third  = keyOf("third", input);
+
+    cache.insert(first, filledImage(qRgb(1, 1, 1)));
+    cache.insert(second, filledImage(qRgb(2, 2, 2)));
+    QCOMPARE(cache.entryCount(), 2);
+    QCOMPARE(cache.usedBytes(), 2 * ImageBytes);
+
+    // first is used again, second is the least recently used one
+    QVERIFY(contains(cache, first));
+    cache.insert(third, filledImage(qRgb(3, 3, 3)));
+
+    QCOMPARE(cache.entryCount(), 2);
+    QVERIFY(cache.usedBytes() <= cache.byteBudget());
+    QVERIFY(!contains(cache, second));
+    QVERIFY(contains(cache, first));
+    QVERIFY(contains(cache, third));
+
+    // An output larger than the whole budget is not stored and evicts nothing
+    cache.insert(keyOf("large", input), filledImage(qRgb(4, 4, 4), 64));
+    QVERIFY(!contains(cache, keyOf("large", input)));
+    QCOMPARE(cache.entryCount(), 2);
+
+    // The stored output is returned, not a new image
+    QImage output;
+    QVERIFY(cache.find(first, output));
+    QCOMPARE(output.pixel(0, 0), qRgb(1, 1, 1));
+
+    cache.clear();
+    QCOMPARE(cache.entryCount(), 0);
+    QCOMPARE(cache.usedBytes(), 0);
+}
+
+void TestNodeOutputCache::shrinkingBudgetEvicts()
+{
+    NodeOutputCache cache;
+    cache.setByteBudget(4 * ImageBytes);
+
+    const QImage input = filledImage(qRgb(10, 20, 30));
+    const QStringList keys = { keyOf("a", input), keyOf("b", input), keyOf("c", input),
+                               keyOf("d", input) };
+    for (const QString &key : keys)
+        cache.insert(key, filledImage(qRgb(5, 5, 5)));
+    QCOMPARE(cache.entryCount(), 4);
+
+    // a and b are used last, c and d go first
+    QVERIFY(contains(cache, keys.at(0)));
+    QVERIFY(contains(cache, keys.at(1)));
+
+    cache.setByteBudget(2 * ImageBytes);
+    QCOMPARE(cache.byteBudget(), 2 * ImageBytes);
+    QCOMPARE(cache.entryCount(), 2);
+    QCOMPARE(cache.usedBytes(), 2 * ImageBytes);
+    QVERIFY(contains(cache, keys.at(0)));
+    QVERIFY(contains(cache, keys.at(1)));
+    QVERIFY(!contains(cache, keys.at(2)));
+    QVERIFY(!contains(cache, keys.at(3)));
+
+    cache.setByteBudget(ImageBytes / 2);
+    QCOMPARE(cache.entryCount(), 0);
+}
+
+void TestNodeOutputCache::countsHitsAndMisses()
+{
+    NodeOutputCache cache;
+    const QImage input = filledImage(qRgb(10, 20, 30));
+    const QString key = keyOf("blur", input);
+
+    QVERIFY(!contains(cache, key));
+    cache.insert(key, filledImage(qRgb(6, 6, 6)));
+    QVERIFY(contains(cache, key));
+    QVERIFY(contains(cache, key));
+    QCOMPARE(cache.hits(), 2);
+    QCOMPARE(cache.misses(), 1);
+
+    // No key (the input is not an image, or the operation is a no-op): neither
+    QVERIFY(NodeOutputCache::fingerprint("blur", 1.0, QVariant()).isEmpty());
+    QVERIFY(!contains(cache, QString()));
+    QCOMPARE(cache.hits(), 2);
+    QCOMPARE(cache.misses(), 1);
+
+    // A modified input has another key
+    QImage modified = input;
+    modified.setPixel(0, 0, qRgb(0, 0, 0));
+    QVERIFY(!contains(cache, keyOf("blur", modified)));
+    QCOMPARE(cache.misses(), 2);
+
+    cache.resetCounters();
+    QCOMPARE(cache.hits(), 0);
+    QCOMPARE(cache.misses(), 0);
+    QCOMPARE(cache.entryCount(), 1);
+}
+
+/*!
+ * The blur box is the rounded radius, so radii rounding to the same value share one output.
+ */
+void TestNodeOutputCache::roundedRadiiShareOutput()
+{
+    NodeOutputCache *cache = NodeOutputCache::instance();
+    cache->clear();
+    cache->resetCounters();
+
+    ImageProcessor processor;
+    const QVariant input = QVariant::fromValue(filledImage(qRgb(200, 100, 50), 32));
+
+    const QImage first = processor.applyBlur(input, 2.2).value<QImage>();
+    QVERIFY(!first.isNull());
+    QCOMPARE(cache->misses(), 1);
+    QCOMPARE(cache->entryCount(), 1);
+
+    const QImage second = processor.applyBlur(input, 1.8).value<QImage>();
+    QCOMPARE(cache->hits(), 1);
+    QCOMPARE(second.cacheKey(), first.cacheKey());
+
+    processor.applyBlur(input, 2.6);
+    QCOMPARE(cache->misses(), 2);
+    QCOMPARE(cache->entryCount(), 2);
+
+    // No-op radii are neither looked up nor stored
+    const QImage unchanged = processor.applyBlur(input, 0.05).value<QImage>();
+    QCOMPARE(unchanged.cacheKey(), input.value<QImage>().cacheKey());
+    QCOMPARE(cache->hits() + cache->misses(), 3);
+    QCOMPARE(cache->entryCount(), 2);
+
+    cache->clear();
+    cache->resetCounters();
+}
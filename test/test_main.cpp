@@ -1 +1,31 @@
-#define CATCH_CONFIG_MAIN
+#include <QCoreApplication>
+#include <QList>
+#include <QTest>
+
+#include "test_command_stack.h"
+#include "test_handle_registry.h"
+#include "test_image_pipeline.h"
+#include "test_link_router.h"
+#include "test_node_index.h"
+#include "test_node_output_cache.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    TestHandleRegistry  handleRegistry;
+    TestLinkRouter      linkRouter;
+    TestImagePipeline   imagePipeline;
+    TestCommandStack    commandStack;
+    TestNodeIndex       nodeIndex;
+    TestNodeOutputCache nodeOutputCache;
+
+    const QList<QObject *> tests = { &handleRegistry, &linkRouter, &imagePipeline,
+                                     &commandStack, &nodeIndex, &nodeOutputCache };
+
+    int status = 0;
+    for (QObject *test : tests)
+        status |= QTest::qExec(test, argc, argv);
+
+    return status;
+}
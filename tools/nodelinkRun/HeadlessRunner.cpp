@@ -0,0 +1,321 @@
+#include "HeadlessRunner.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QImage>
+#include <QJSValue>
+#include <QJsonDocument>
+#include <QProcess>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+
+/*! Default constructor
+ * ************************************************************************************************/
+HeadlessRunner::HeadlessRunner(const Options &options)
+    : mOptions(options)
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+
+/*!
+ * Result: {scene, loadMs, runs: [{name, elapsedMs, completed, outputs: [{uuid, title, type,
+ * value}]}], error}
+ */
+QJsonObject HeadlessRunner::runScene(const QString &sceneFile) const
+{
+    QJsonObject result;
+    result["scene"] = sceneFile;
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    QFile file(sceneFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result["error"] = QString("Cannot open %1: %2").arg(sceneFile, file.errorString());
+        return result;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!document.isObject()) {
+        result["error"] = QString("Cannot parse %1: %2").arg(sceneFile, parseError.errorString());
+        return result;
+    }
+
+    QQmlEngine engine;
+    engine.addImportPath(":/");
+    for (const QString &importPath : mOptions.importPaths)
+        engine.addImportPath(importPath);
+
+    QQmlComponent component(&engine);
+    component.setData("import NodeLink\nSceneRunner {}\n", QUrl());
+    std::unique_ptr<QObject> runner(component.create());
+    if (!runner) {
+        result["error"] = component.errorString();
+        return result;
+    }
+
+    if (!mOptions.imports.isEmpty())
+        runner->setProperty("imports", mOptions.imports);
+
+    if (!call(runner.get(), "load", document.object().toVariantMap()).toBool()) {
+        result["error"] = QString("Cannot load the scene of %1").arg(sceneFile);
+        return result;
+    }
+
+    result["loadMs"] = loadTimer.nsecsElapsed() / 1.0e6;
+
+    // Without runs the scene is evaluated once as saved
+    const QVariantList runs = mOptions.runs.isEmpty() ? QVariantList{ QVariantMap() }
+                                                      : mOptions.runs;
+
+    QJsonArray runResults;
+    for (int i = 0; i < runs.size(); ++i) {
+        const QVariantMap run = runs.at(i).toMap();
+
+        QElapsedTimer runTimer;
+        runTimer.start();
+
+        call(runner.get(), "apply", run.value("inputs"));
+        const bool evaluated = call(runner.get(), "evaluate", mOptions.evaluateFunction).toBool();
+        const bool completed = evaluated && waitWhileBusy(runner.get());
+
+        QJsonObject runResult;
+        runResult["name"]      = run.value("name", QString::number(i)).toString();
+        runResult["elapsedMs"] = runTimer.nsecsElapsed() / 1.0e6;
+        runResult["completed"] = completed;
+        runResult["outputs"]   = toJson(call(runner.get(), "collect", mOptions.outputs));
+        runResults.append(runResult);
+    }
+
+    result["runs"] = runResults;
+    return result;
+}
+
+/*!
+ * Every scene runs in its own QQmlEngine, so scenes share no QML state. With one job the
+ * scenes are evaluated in the calling thread, otherwise every scene is evaluated by a child
+ * process: the QML engine and the scene objects are bound to the thread that created them.
+ */
+QJsonArray HeadlessRunner::runScenes(const QStringList &sceneFiles, int jobs) const
+{
+    QVector<QJsonObject> results(sceneFiles.size());
+
+    if (jobs <= 1 || sceneFiles.size() <= 1) {
+        for (int i = 0; i < sceneFiles.size(); ++i)
+            results[i] = runScene(sceneFiles.at(i));
+    } else {
+        runInProcesses(sceneFiles, jobs, results);
+    }
+
+    QJsonArray array;
+    for (const QJsonObject &sceneResult : results)
+        array.append(sceneResult);
+
+    return array;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+
+/*!
+ * The children are this program with the same options (as an inputs file) and one scene, they
+ * write their result to a file in a temporary directory. The first scene of a child result is
+ * the scene result, a child that wrote no result is reported as an error of its scene.
+ */
+void HeadlessRunner::runInProcesses(const QStringList &sceneFiles, int jobs,
+                                    QVector<QJsonObject> &results) const
+{
+    QTemporaryDir directory;
+    QFile inputsFile(directory.filePath("inputs.json"));
+    if (!directory.isValid() || !inputsFile.open(QIODevice::WriteOnly)) {
+        for (int i = 0; i < sceneFiles.size(); ++i) {
+            results[i]["scene"] = sceneFiles.at(i);
+            results[i]["error"] = QString("Cannot create the inputs file of the child processes");
+        }
+        return;
+    }
+    inputsFile.write(QJsonDocument(inputsJson()).toJson());
+    inputsFile.close();
+
+    QStringList arguments{ "--inputs", inputsFile.fileName(),
+                           "--timeout", QString::number(mOptions.timeoutMs) };
+    for (const QString &importPath : mOptions.importPaths)
+        arguments << "--import-path" << importPath;
+    if (mOptions.coreOnly)
+        arguments << "--core";
+
+    std::vector<std::unique_ptr<QProcess>> processes(sceneFiles.size());
+    QEventLoop loop;
+    int next    = 0;
+    int running = 0;
+
+    std::function<void()> startNext;
+
+    // Collect the result of scene index and start the next scene
+    auto onDone = [&](int index, const QString &processError) {
+        const QString sceneFile = sceneFiles.at(index);
+        QFile outputFile(directory.filePath(QString("%1.json").arg(index)));
+        const QJsonArray childScenes = outputFile.open(QIODevice::ReadOnly)
+                                       ? QJsonDocument::fromJson(outputFile.readAll())
+                                             .object().value("scenes").toArray()
+                                       : QJsonArray();
+
+        if (!childScenes.isEmpty()) {
+            results[index] = childScenes.first().toObject();
+        } else {
+            results[index]["scene"] = sceneFile;
+            results[index]["error"] = QString("The process of %1 failed: %2")
+                                          .arg(sceneFile, processError);
+        }
+
+        --running;
+        startNext();
+        if (running == 0)
+            loop.quit();
+    };
+
+    startNext = [&]() {
+        while (running < jobs && next < sceneFiles.size()) {
+            const int index = next++;
+            processes[index] = std::make_unique<QProcess>();
+            QProcess *process = processes[index].get();
+            process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            process->setStandardOutputFile(QProcess::nullDevice());
+
+            QObject::connect(process, &QProcess::finished, &loop,
+                             [&, index, process](int exitCode, QProcess::ExitStatus exitStatus) {
+                onDone(index, exitStatus == QProcess::CrashExit
+                              ? process->errorString()
+                              : QString("exit code %1").arg(exitCode));
+            });
+            QObject::connect(process, &QProcess::errorOccurred, &loop,
+                             [&, index, process](QProcess::ProcessError error) {
+                // finished() is not emitted for a process that did not start
+                if (error == QProcess::FailedToStart)
+                    onDone(index, process->errorString());
+            });
+
+            ++running;
+            process->start(QCoreApplication::applicationFilePath(),
+                           arguments + QStringList{ "--output",
+                                                    directory.filePath(QString("%1.json").arg(index)),
+                                                    sceneFiles.at(index) });
+        }
+    };
+
+    startNext();
+    if (running > 0)
+        loop.exec();
+}
+
+QJsonObject HeadlessRunner::inputsJson() const
+{
+    QJsonObject inputs;
+    inputs["imports"]  = QJsonArray::fromStringList(mOptions.imports);
+    inputs["evaluate"] = mOptions.evaluateFunction;
+    inputs["outputs"]  = QJsonArray::fromStringList(mOptions.outputs);
+    inputs["runs"]     = QJsonArray::fromVariantList(mOptions.runs);
+    return inputs;
+}
+
+QVariant HeadlessRunner::call(QObject *runner, const char *function, const QVariant &argument)
+{
+    QVariant returnValue;
+    QMetaObject::invokeMethod(runner, function,
+                              Q_RETURN_ARG(QVariant, returnValue),
+                              Q_ARG(QVariant, argument));
+
+    if (returnValue.metaType() == QMetaType::fromType<QJSValue>())
+        returnValue = returnValue.value<QJSValue>().toVariant();
+
+    return returnValue;
+}
+
+/*!
+ * Runs an event loop in the calling thread, queued results of the scene are delivered here.
+ */
+bool HeadlessRunner::waitWhileBusy(QObject *runner) const
+{
+    if (!runner->property("busy").toBool())
+        return true;
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+
+    QObject::connect(runner, SIGNAL(busyChanged()), &loop, SLOT(quit()));
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    timeout.start(mOptions.timeoutMs);
+    while (runner->property("busy").toBool() && timeout.isActive())
+        loop.exec();
+
+    return !runner->property("busy").toBool();
+}
+
+QJsonValue HeadlessRunner::toJson(const QVariant &value)
+{
+    if (!value.isValid() || value.isNull())
+        return QJsonValue::Null;
+
+    switch (value.typeId()) {
+    case QMetaType::QImage: {
+        const QImage image = value.value<QImage>().convertToFormat(QImage::Format_ARGB32);
+        const QByteArray pixels(reinterpret_cast<const char *>(image.constBits()),
+                                image.sizeInBytes());
+
+        QJsonObject summary;
+        summary["width"]  = image.width();
+        summary["height"] = image.height();
+        summary["md5"]    = QString(QCryptographicHash::hash(pixels, QCryptographicHash::Md5).toHex());
+        return summary;
+    }
+
+    case QMetaType::QVariantMap: {
+        QJsonObject object;
+        const QVariantMap map = value.toMap();
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            object.insert(it.key(), toJson(it.value()));
+        return object;
+    }
+
+    case QMetaType::QVariantList: {
+        QJsonArray array;
+        for (const QVariant &item : value.toList())
+            array.append(toJson(item));
+        return array;
+    }
+
+    case QMetaType::QObjectStar: {
+        // Objects are referenced like in the scene files
+        QObject *object = value.value<QObject *>();
+        return object ? QJsonValue(object->property("_qsUuid").toString()) : QJsonValue::Null;
+    }
+
+    default:
+        break;
+    }
+
+    if (value.metaType() == QMetaType::fromType<QJSValue>())
+        return toJson(value.value<QJSValue>().toVariant());
+
+    return QJsonValue::fromVariant(value);
+}
@@ -0,0 +1,84 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+/*! ***********************************************************************************************
+ * HeadlessRunner evaluates saved scenes without views: every scene gets its own QQmlEngine with
+ * a SceneRunner (NodeLink), the scene is loaded once and evaluated for every run.
+ *
+ * Scenes are independent, runScenes() evaluates them in parallel in child processes (the tool
+ * itself with one scene each): a QQmlEngine, its QML singletons and the scene objects belong to
+ * the thread that created them, so engines are never run on worker threads.
+ * ************************************************************************************************/
+class HeadlessRunner
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    struct Options {
+        //! Additional QML import paths
+        QStringList importPaths;
+
+        //! Imports to create the scene objects, e.g. ["QtQuickStream", "Calculator"]
+        QStringList imports;
+
+        //! Scene function that evaluates the graph
+        QString     evaluateFunction = "evaluate";
+
+        //! Runs [{name, inputs}], see SceneRunner.apply()
+        QVariantList runs;
+
+        //! Output nodes (UUIDs or titles), empty: all nodes
+        QStringList outputs;
+
+        //! Maximum time of an asynchronous evaluation (ms)
+        int         timeoutMs = 60000;
+
+        //! The application is a QCoreApplication (--core), passed on to child processes
+        bool        coreOnly = false;
+    };
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit HeadlessRunner(const Options &options);
+
+    /* Public Functions
+     * ****************************************************************************************/
+    //! Load and evaluate one scene in the calling thread
+    QJsonObject runScene(const QString &sceneFile) const;
+
+    //! Evaluate the scenes, up to jobs of them at once in child processes
+    QJsonArray  runScenes(const QStringList &sceneFiles, int jobs) const;
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    //! Run every scene in a child process of this program, up to jobs at once
+    void runInProcesses(const QStringList &sceneFiles, int jobs,
+                        QVector<QJsonObject> &results) const;
+
+    //! Inputs file of the child processes, see main.cpp
+    QJsonObject inputsJson() const;
+
+    //! Call a function of the SceneRunner
+    static QVariant call(QObject *runner, const char *function, const QVariant &argument);
+
+    //! Wait until the SceneRunner is not busy, false on timeout
+    bool waitWhileBusy(QObject *runner) const;
+
+    //! JSON of node data, images are summarized as {width, height, md5}
+    static QJsonValue toJson(const QVariant &value);
+
+    /* Attributes
+     * ****************************************************************************************/
+    Options mOptions;
+};
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,147 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QtGui/QGuiApplication>
+
+#include <memory>
+
+#include "HeadlessRunner.h"
+
+/*! ***********************************************************************************************
+ * nodelink-run evaluates saved scenes without a window and prints the node outputs as JSON:
+ *
+ *      nodelink-run -m Calculator -i inputs.json -o result.json -j 4 a.json b.json
+ *
+ * The inputs file is {imports, evaluate, outputs, runs: [{name, inputs}]}, see SceneRunner.
+ * Exit codes: 0 success, 1 a scene failed, 2 usage error.
+ * ************************************************************************************************/
+int main(int argc, char* argv[])
+{
+    // Image scenes need QGuiApplication, the offscreen platform needs no display
+    bool coreOnly = false;
+    for (int i = 1; i < argc; ++i)
+        coreOnly |= (qstrcmp(argv[i], "--core") == 0);
+
+    std::unique_ptr<QCoreApplication> app;
+    if (coreOnly) {
+        app = std::make_unique<QCoreApplication>(argc, argv);
+    } else {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        app = std::make_unique<QGuiApplication>(argc, argv);
+    }
+    QCoreApplication::setApplicationName("nodelink-run");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Evaluates NodeLink scenes without views.");
+    parser.addHelpOption();
+
+    const QCommandLineOption inputsOption({ "i", "inputs" },
+        "Runs and inputs: {imports, evaluate, outputs, runs: [{name, inputs}]}.", "file");
+    const QCommandLineOption outputOption({ "o", "output" },
+        "Write the results to file instead of stdout.", "file");
+    const QCommandLineOption moduleOption({ "m", "module" },
+        "QML module of the scene types, e.g. Calculator.", "module");
+    const QCommandLineOption importPathOption({ "I", "import-path" },
+        "Additional QML import path.", "path");
+    const QCommandLineOption jobsOption({ "j", "jobs" },
+        "Number of scenes evaluated in parallel (child processes).", "count", "1");
+    const QCommandLineOption evaluateOption("evaluate",
+        "Scene function that evaluates the graph.", "function");
+    const QCommandLineOption timeoutOption("timeout",
+        "Maximum time of an asynchronous evaluation in ms.", "ms", "60000");
+    const QCommandLineOption coreOption("core",
+        "Use QCoreApplication, for scenes without images.");
+
+    parser.addOptions({ inputsOption, outputOption, moduleOption, importPathOption,
+                        jobsOption, evaluateOption, timeoutOption, coreOption });
+    parser.addPositionalArgument("scenes", "Scene files (.json).", "scene...");
+    parser.process(*app);
+
+    QTextStream err(stderr);
+
+    const QStringList sceneFiles = parser.positionalArguments();
+    if (sceneFiles.isEmpty()) {
+        err << "nodelink-run: No scene file\n";
+        return 2;
+    }
+
+    bool ok = true;
+    const int jobs = parser.value(jobsOption).toInt(&ok);
+    if (!ok || jobs < 1) {
+        err << "nodelink-run: Invalid --jobs " << parser.value(jobsOption) << "\n";
+        return 2;
+    }
+
+    HeadlessRunner::Options options;
+    options.importPaths = parser.values(importPathOption);
+    options.timeoutMs   = parser.value(timeoutOption).toInt();
+    options.coreOnly    = coreOnly;
+
+    if (parser.isSet(inputsOption)) {
+        QFile inputsFile(parser.value(inputsOption));
+        const QJsonDocument inputs = inputsFile.open(QIODevice::ReadOnly)
+                                     ? QJsonDocument::fromJson(inputsFile.readAll())
+                                     : QJsonDocument();
+        if (!inputs.isObject()) {
+            err << "nodelink-run: Invalid inputs file " << inputsFile.fileName() << "\n";
+            return 2;
+        }
+
+        const QVariantMap inputsMap = inputs.object().toVariantMap();
+        options.imports          = inputsMap.value("imports").toStringList();
+        options.evaluateFunction = inputsMap.value("evaluate", options.evaluateFunction).toString();
+        options.outputs          = inputsMap.value("outputs").toStringList();
+        options.runs             = inputsMap.value("runs").toList();
+    }
+
+    if (parser.isSet(moduleOption)) {
+        if (options.imports.isEmpty())
+            options.imports = QStringList{ "QtQuickStream", "NodeLink" };
+        options.imports.append(parser.values(moduleOption));
+    }
+
+    if (parser.isSet(evaluateOption))
+        options.evaluateFunction = parser.value(evaluateOption);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QJsonArray scenes = HeadlessRunner(options).runScenes(sceneFiles, jobs);
+
+    QJsonObject result;
+    result["scenes"]  = scenes;
+    result["jobs"]    = jobs;
+    result["totalMs"] = timer.nsecsElapsed() / 1.0e6;
+
+    const QByteArray json = QJsonDocument(result).toJson();
+    if (parser.isSet(outputOption)) {
+        QFile outputFile(parser.value(outputOption));
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "nodelink-run: Cannot write " << outputFile.fileName() << "\n";
+            return 1;
+        }
+        outputFile.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    int exitCode = 0;
+    for (const QJsonValue &scene : scenes) {
+        const QJsonObject sceneResult = scene.toObject();
+        if (sceneResult.contains("error")) {
+            err << "nodelink-run: " << sceneResult.value("error").toString() << "\n";
+            exitCode = 1;
+        }
+
+        for (const QJsonValue &run : sceneResult.value("runs").toArray()) {
+            if (!run.toObject().value("completed").toBool())
+                exitCode = 1;
+        }
+    }
+
+    return exitCode;
+}